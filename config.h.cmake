@@ -9,6 +9,7 @@
 #cmakedefine HAVE_NETDB_H 1
 #cmakedefine HAVE_SYS_TIME_H 1
 #cmakedefine HAVE_PWD_H 1
+#cmakedefine HAVE_SYS_MMAN_H 1
 #cmakedefine HAVE_SYS_PARAM_H 1
 #cmakedefine HAVE_UNISTD_H 1
 #cmakedefine HAVE_SYS_TYPES_H 1
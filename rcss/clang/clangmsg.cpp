@@ -25,6 +25,8 @@
 
 #include "clangmsg.h"
 
+#include <sstream>
+
 namespace rcss {
 namespace clang {
 
@@ -34,7 +36,8 @@ Msg::Msg()
       M_min_ver( (unsigned int)-1 ),
       M_max_ver( 0 ),
       M_time_send( -1 ),
-      M_side( 0 )
+      M_side( 0 ),
+      M_text_printed( false )
 {
 
 }
@@ -44,7 +47,19 @@ Msg::Msg( const int& time_recv )
       M_min_ver( (unsigned int)-1 ),
       M_max_ver( 0 ),
       M_time_send( -1 ),
-      M_side( 0 )
+      M_side( 0 ),
+      M_text_printed( false )
+{
+
+}
+
+Msg::Msg( const Msg & msg )
+    : M_time_recv( msg.M_time_recv ),
+      M_min_ver( msg.M_min_ver ),
+      M_max_ver( msg.M_max_ver ),
+      M_time_send( msg.M_time_send ),
+      M_side( msg.M_side ),
+      M_text_printed( false )
 {
 
 }
@@ -54,6 +69,19 @@ Msg::~Msg()
 
 }
 
+const std::string &
+Msg::text() const
+{
+    if ( ! M_text_printed )
+    {
+        std::ostringstream os;
+        print( os );
+        M_text = os.str();
+        M_text_printed = true;
+    }
+    return M_text;
+}
+
 
 void
 Msg::setVer( const unsigned int min,
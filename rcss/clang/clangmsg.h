@@ -24,6 +24,7 @@
 
 #include <memory>
 #include <iostream>
+#include <string>
 
 namespace rcss {
 namespace clang {
@@ -47,6 +48,8 @@ public:
 protected:
     Msg();
     Msg( const int & time_recv );
+    //! the printed form is not copied, so that a copy may be modified
+    Msg( const Msg & msg );
 
 public:
     virtual
@@ -65,6 +68,12 @@ public:
     std::ostream & printPretty( std::ostream & out,
                                 const std::string & line_header ) const = 0;
 
+    /*!
+      \brief get the printed form of the message. The message is printed
+      on the first call only, so it must not be modified afterwards.
+    */
+    const std::string & text() const;
+
     void setVer( const unsigned int min,
                  const unsigned int max );
 
@@ -86,6 +95,9 @@ private:
 
     int M_time_send;
     int M_side;
+
+    mutable std::string M_text;
+    mutable bool M_text_printed;
 };
 
 }
@@ -93,6 +93,13 @@ public:
           setAddr( htons( port ), htonl( host ) );
       }
 
+    void assign( const Addr::AddrType & addr )
+      {
+          m_addr = addr;
+          m_host_name.clear();
+          m_port_name.clear();
+      }
+
 
     bool setPort( Addr::PortType port )
       {
@@ -252,6 +259,19 @@ Addr::setHost( const std::string & host )
     return M_impl->setHost( host );
 }
 
+void
+Addr::setAddr( const AddrType & addr )
+{
+    if ( M_impl.use_count() == 1 )
+    {
+        M_impl->assign( addr );
+    }
+    else
+    {
+        M_impl.reset( new Impl( addr ) );
+    }
+}
+
 const
 Addr::AddrType &
 Addr::getAddr() const
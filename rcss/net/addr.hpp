@@ -62,6 +62,13 @@ public:
 
     bool setHost( const std::string & host );
 
+    /*!
+      \brief replaces the address.  The address is overwritten in place
+      unless it is shared with a copy, so a receiver that keeps its
+      source address does not allocate for each datagram.
+    */
+    void setAddr( const AddrType & addr );
+
     const
     AddrType & getAddr() const;
 
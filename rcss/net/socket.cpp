@@ -350,7 +350,23 @@ Socket::isOpen() const
 bool
 Socket::isConnected() const
 {
-    return getPeer() != Addr();
+    // the same as getPeer() != Addr(), without the temporary addresses
+    if ( ! isOpen() )
+    {
+        return false;
+    }
+
+    Addr::AddrType name;
+    socklen_t name_len = sizeof( name );
+    if ( ::getpeername( getFD(),
+                        (struct sockaddr *)&name,
+                        &name_len ) < 0 )
+    {
+        return false;
+    }
+
+    return ( name.sin_port != 0
+             || name.sin_addr.s_addr != htonl( Addr::ANY ) );
 }
 
 Addr
@@ -467,7 +483,7 @@ Socket::recv( char * msg,
 #endif
                                flags,
                                (struct sockaddr *)&addr, &from_len );
-        from = Addr( addr );
+        from.setAddr( addr );
         return rval;
     }
     else
@@ -485,7 +501,7 @@ Socket::recv( char * msg,
                                        flags,
                                        (struct sockaddr *)&addr,
                                        &from_len );
-            from = Addr( addr );
+            from.setAddr( addr );
             if ( received != -1
                  || errno != EINTR )
             {
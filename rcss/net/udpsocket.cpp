@@ -44,7 +44,7 @@ namespace net {
 
 UDPSocket::UDPSocket()
 {
-    open();
+
 }
 
 UDPSocket::UDPSocket( SocketDesc & s )
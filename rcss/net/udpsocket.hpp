@@ -31,6 +31,7 @@ class UDPSocket
     : public Socket {
 public:
 
+    //! creates a closed socket, see open()
     UDPSocket();
 
     UDPSocket( SocketDesc & s );
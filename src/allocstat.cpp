@@ -0,0 +1,159 @@
+// -*-c++-*-
+
+/***************************************************************************
+                                allocstat.cpp
+                      Counter of the heap allocations
+                             -------------------
+    begin                : 2026-10-18
+    copyright            : (C) 2026 by The RoboCup Soccer Server
+                           Maintenance Group.
+    email                : sserver-admin@lists.sourceforge.net
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU LGPL as published by the Free Software  *
+ *   Foundation; either version 3 of the License, or (at your option) any  *
+ *   later version.                                                        *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "allocstat.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic< unsigned long > g_allocation_count( 0 );
+
+void *
+counted_alloc( std::size_t size )
+{
+    g_allocation_count.fetch_add( 1, std::memory_order_relaxed );
+
+    if ( size == 0 )
+    {
+        size = 1;
+    }
+
+    // like the standard operator new, give the new handler a chance to
+    // free some memory before giving up
+    while ( true )
+    {
+        void * p = std::malloc( size );
+        if ( p )
+        {
+            return p;
+        }
+
+        std::new_handler handler = std::get_new_handler();
+        if ( ! handler )
+        {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+void *
+counted_alloc_nothrow( std::size_t size ) noexcept
+{
+    try
+    {
+        return counted_alloc( size );
+    }
+    catch ( ... )
+    {
+        return nullptr;
+    }
+}
+
+}
+
+namespace rcss {
+
+unsigned long
+allocation_count()
+{
+    return g_allocation_count.load( std::memory_order_relaxed );
+}
+
+}
+
+//
+// replacements of the global allocation functions.
+// the aligned variants are left to the standard library.
+//
+
+void *
+operator new( std::size_t size )
+{
+    return counted_alloc( size );
+}
+
+void *
+operator new[]( std::size_t size )
+{
+    return counted_alloc( size );
+}
+
+void *
+operator new( std::size_t size,
+              const std::nothrow_t & ) noexcept
+{
+    return counted_alloc_nothrow( size );
+}
+
+void *
+operator new[]( std::size_t size,
+                const std::nothrow_t & ) noexcept
+{
+    return counted_alloc_nothrow( size );
+}
+
+void
+operator delete( void * p ) noexcept
+{
+    std::free( p );
+}
+
+void
+operator delete[]( void * p ) noexcept
+{
+    std::free( p );
+}
+
+void
+operator delete( void * p,
+                 std::size_t ) noexcept
+{
+    std::free( p );
+}
+
+void
+operator delete[]( void * p,
+                   std::size_t ) noexcept
+{
+    std::free( p );
+}
+
+void
+operator delete( void * p,
+                 const std::nothrow_t & ) noexcept
+{
+    std::free( p );
+}
+
+void
+operator delete[]( void * p,
+                   const std::nothrow_t & ) noexcept
+{
+    std::free( p );
+}
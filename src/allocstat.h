@@ -0,0 +1,40 @@
+// -*-c++-*-
+
+/***************************************************************************
+                                 allocstat.h
+                      Counter of the heap allocations
+                             -------------------
+    begin                : 2026-10-18
+    copyright            : (C) 2026 by The RoboCup Soccer Server
+                           Maintenance Group.
+    email                : sserver-admin@lists.sourceforge.net
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU LGPL as published by the Free Software  *
+ *   Foundation; either version 3 of the License, or (at your option) any  *
+ *   later version.                                                        *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef RCSS_ALLOCSTAT_H
+#define RCSS_ALLOCSTAT_H
+
+namespace rcss {
+
+/*!
+  \brief get the number of calls to the global operator new since the
+  server started. The difference between two simulator steps is
+  written to the text log when profiling is enabled.
+
+  Only rcssserver replaces the global allocation functions.  A library
+  must leave them to its host program, so librcssbatch always
+  returns 0.
+*/
+unsigned long allocation_count();
+
+}
+
+#endif
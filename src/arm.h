@@ -140,6 +140,21 @@ public:
           return M_count;
       }
 
+    unsigned int timer() const
+      {
+          return M_timer;
+      }
+
+    //! sets the state saved in a checkpoint
+    void restore( const rcss::geom::Vector2D & dest,
+                  const unsigned int timer,
+                  const unsigned int count )
+      {
+          M_dest = dest;
+          M_timer = timer;
+          M_count = count;
+      }
+
     class State {
     protected:
         unsigned int M_cycles_till_movable;
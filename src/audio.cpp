@@ -61,7 +61,7 @@ Listener::sendCoachStdAudio( const rcss::clang::Msg & msg )
 
 void
 Listener::sendPlayerAudio( const Player & player,
-                           const char * msg )
+                           const AudioSender::Message & msg )
 {
     sender().sendPlayerAudio( player, msg );
 }
@@ -106,6 +106,24 @@ Listener::sendErrorNoTeamName( const std::string & team_name )
 }
 
 
+AudioSender::Message
+MessagePool::get( const char * msg )
+{
+    for ( std::shared_ptr< std::string > & m : M_messages )
+    {
+        if ( m.use_count() == 1 )
+        {
+            // only the pool refers to it, the string keeps its capacity
+            m->assign( msg );
+            return m;
+        }
+    }
+
+    M_messages.push_back( std::make_shared< std::string >( msg ) );
+    return M_messages.back();
+}
+
+
 AudioSenderPlayer::FactoryHolder &
 AudioSenderPlayer::factory()
 {
@@ -131,7 +149,7 @@ AudioSenderPlayer::~AudioSenderPlayer()
 
 void
 AudioSenderPlayer::sendPlayerAudio( const Player & player,
-                                    const char * msg )
+                                    const Message & msg )
 {
     if ( &player == &M_listener )
     {
@@ -164,9 +182,10 @@ AudioSenderPlayer::nonSelfPlayerPredicate( const Player & player ) const
     // a nightmare to understand
     if( generalPredicate() )
     {
+        const double cut_dist = ServerParam::instance().audioCutDist();
         if ( listener().canHearFullFrom( player )
              && player.pos().distance2( listener().pos() )
-             <= std::pow( ServerParam::instance().audioCutDist(), 2 ) )
+             <= cut_dist * cut_dist )
         {
             return true;
         }
@@ -287,18 +306,18 @@ AudioSenderPlayerv1::sendCoachStdAudio( const rcss::clang::Msg & msg )
 }
 
 void
-AudioSenderPlayerv1::sendSelfAudio( const char * msg )
+AudioSenderPlayerv1::sendSelfAudio( const Message & msg )
 {
     if ( generalPredicate() )
     {
-        serializer().serializeSelfAudio( transport(), M_stadium.time(), msg );
+        serializer().serializeSelfAudio( transport(), M_stadium.time(), msg->c_str() );
         transport() << std::ends << std::flush;
     }
 }
 
 void
 AudioSenderPlayerv1::sendNonSelfPlayerAudio( const Player & player,
-                                             const char * msg )
+                                             const Message & msg )
 {
     if ( nonSelfPlayerPredicate( player ) )
     {
@@ -306,7 +325,7 @@ AudioSenderPlayerv1::sendNonSelfPlayerAudio( const Player & player,
         serializer().serializePlayerAudio( transport(),
                                            M_stadium.time(),
                                            dir,
-                                           msg );
+                                           msg->c_str() );
         transport() << std::ends << std::flush;
         postNonSelfPlayer( player );
     }
@@ -363,7 +382,7 @@ AudioSenderPlayerv7::sendCoachAudio( const Coach & coach,
 
 void
 AudioSenderPlayerv7::sendNonSelfPlayerAudio( const Player & player,
-                                             const char * msg )
+                                             const Message & msg )
 {
     if ( nonSelfPlayerPredicate( player ) )
     {
@@ -371,49 +390,39 @@ AudioSenderPlayerv7::sendNonSelfPlayerAudio( const Player & player,
         serializer().serializePlayerAudio( transport(),
                                            M_stadium.time(),
                                            dir,
-                                           msg );
+                                           msg->c_str() );
         transport() << std::ends << std::flush;
         postNonSelfPlayer( player );
     }
 }
 
 
-AudioSenderPlayerv8::~AudioSenderPlayerv8()
+AudioSenderPlayerv8::AudioSenderPlayerv8( const Params & params )
+    : AudioSenderPlayerv7( params ),
+      M_state_p( &M_unfocused ),
+      M_focus_count ( 0 ),
+      M_player_msgs( std::less< player_key_t >(),
+                     player_msg_cont_t::allocator_type( params.M_stadium.nodePool() ) ),
+      M_left_partial( false ),
+      M_left_complete( true ),
+      M_right_partial( false ),
+      M_right_complete( true )
 {
-    for ( player_msg_cont_t::iterator i = M_player_msgs.begin();
-          i != M_player_msgs.end();
-          ++i )
-    {
-        free( i->second );
-        i->second = nullptr;
-    }
-    M_player_msgs.clear();
 
-    for ( self_msg_cont_t::iterator i = M_self_msgs.begin();
-          i != M_self_msgs.end();
-         ++i )
-    {
-        free( *i );
-        *i = nullptr;
-    }
-    M_self_msgs.clear();
+}
+
+AudioSenderPlayerv8::~AudioSenderPlayerv8()
+{
 
-    for ( coach_msg_cont_t::iterator i = M_coach_msgs.begin();
-          i != M_coach_msgs.end();
-          ++i )
-    {
-        free( i->second );
-        i->second = nullptr;
-    }
-    M_coach_msgs.clear();
 }
 
 bool
 AudioSenderPlayerv8::nonSelfPlayerPredicate( const Player & player ) const
 {
+    const double cut_dist = ServerParam::instance().audioCutDist();
     return ( generalPredicate()
              && ( player.pos().distance2( listener().pos() )
-                  <= std::pow( ServerParam::instance().audioCutDist(), 2 ) ) );
+                  <= cut_dist * cut_dist ) );
 }
 
 bool
@@ -437,37 +446,21 @@ void
 AudioSenderPlayerv8::sendCoachAudio( const Coach & coach,
                                      const char * msg )
 {
-    char * msg_copy = strdup( msg );
-    if ( ! msg_copy )
-    {
-        std::cerr << "Error:  could not alocate memory to cache coach audio message\n";
-    }
-    else
-    {
-        M_coach_msgs.push_back( coach_key_value_t( &coach,
-                                                   msg_copy ) );
-    }
+    M_coach_msgs.push_back( coach_key_value_t( &coach,
+                                               std::make_shared< const std::string >( msg ) ) );
 }
 
 
 void
-AudioSenderPlayerv8::sendSelfAudio( const char * msg )
+AudioSenderPlayerv8::sendSelfAudio( const Message & msg )
 {
-    char * msg_copy = strdup( msg );
-    if ( ! msg_copy )
-    {
-        std::cerr << "Error:  could not alocate memory to cache player's own audio message\n";
-    }
-    else
-    {
-        M_self_msgs.push_back( msg_copy );
-    }
+    M_self_msgs.push_back( msg );
 }
 
 
 void
 AudioSenderPlayerv8::sendNonSelfPlayerAudio( const Player & player,
-                                             const char * msg )
+                                             const Message & msg )
 {
     if ( ! nonSelfPlayerPredicate( player ) )
     {
@@ -490,45 +483,29 @@ AudioSenderPlayerv8::sendNonSelfPlayerAudio( const Player & player,
         return;
     }
 
-    char * msg_copy = strdup( msg );
-    if ( ! msg_copy )
-    {
-        std::cerr << "Error:  could not alocate memory to cache player audio message\n";
-    }
-    else
-    {
-        M_player_msgs.insert( player_key_value_t( &player,
-                                                  msg_copy ) );
-    }
+    M_player_msgs.insert( player_key_value_t( &player, msg ) );
 }
 
 
 void
 AudioSenderPlayerv8::newCycle()
 {
-    for ( coach_msg_cont_t::iterator i = M_coach_msgs.begin();
-          i != M_coach_msgs.end();
-          ++i )
+    for ( coach_msg_cont_t::const_reference m : M_coach_msgs )
     {
-        sendCachedCoachAudio( *(i->first), i->second );
-        free( i->second );
+        sendCachedCoachAudio( *(m.first), m.second->c_str() );
     }
     M_coach_msgs.clear();
 
-    for ( self_msg_cont_t::iterator i = M_self_msgs.begin();
-          i != M_self_msgs.end();
-          ++i )
+    for ( self_msg_cont_t::const_reference m : M_self_msgs )
     {
-        sendCachedSelfAudio( *i );
-        free( *i );
+        sendCachedSelfAudio( m );
     }
     M_self_msgs.clear();
 
     while ( ! M_player_msgs.empty() )
     {
-        State::key_value_t data = M_state_p->getMsg( M_player_msgs );
+        const State::key_value_t data = M_state_p->getMsg( M_player_msgs );
         sendCachedNonSelfPlayerAudio( *(data.first), data.second );
-        free( data.second );
     }
 }
 
@@ -556,14 +533,14 @@ AudioSenderPlayerv8::sendCachedCoachAudio( const Coach & coach,
 }
 
 void
-AudioSenderPlayerv8::sendCachedSelfAudio( const char * msg )
+AudioSenderPlayerv8::sendCachedSelfAudio( const Message & msg )
 {
     AudioSenderPlayerv7::sendSelfAudio( msg );
 }
 
 void
 AudioSenderPlayerv8::sendCachedNonSelfPlayerAudio( const Player & player,
-                                                   const char * msg )
+                                                   const Message & msg )
 {
     //if ( nonSelfPlayerPredicate( player ) )
     {
@@ -579,14 +556,14 @@ AudioSenderPlayerv8::sendCachedNonSelfPlayerAudio( const Player & player,
                                                          M_stadium.time(),
                                                          dir,
                                                          player.unum(),
-                                                         msg );
+                                                         msg->c_str() );
                 }
                 else
                 {
                     serializer().serializeOppAudioFull( transport(),
                                                         M_stadium.time(),
                                                         dir,
-                                                        msg );
+                                                        msg->c_str() );
                 }
                 transport() << std::ends << std::flush;
                 postNonSelfPlayer( player );
@@ -696,8 +673,9 @@ AudioSenderPlayerv8::Focused::getMsg( msg_cont_t & msgs )
     for( int i = 0; i < idx; i++ )
         iter++;
 
+    key_value_t rval = *iter;
     msgs.erase( iter );
-    return *iter;
+    return rval;
 }
 
 
@@ -839,28 +817,28 @@ AudioSenderCoachv1::sendCoachStdAudio( const rcss::clang::Msg & msg )
 
 void
 AudioSenderCoachv1::sendPlayerAudio( const Player & player,
-                                     const char * msg )
+                                     const Message & msg )
 {
     if ( generalPredicate() )
     {
         serializer().serializePlayerAudio( transport(),
                                            M_stadium.time(),
                                            player.name(),
-                                           msg );
+                                           msg->c_str() );
         transport() << std::ends << std::flush;
     }
 }
 
 void
 AudioSenderCoachv7::sendPlayerAudio( const Player & player,
-                                     const char * msg )
+                                     const Message & msg )
 {
     if ( generalPredicate() )
     {
         serializer().serializePlayerAudio( transport(),
                                            M_stadium.time(),
                                            player.shortName(),
-                                           msg );
+                                           msg->c_str() );
         transport() << std::ends << std::flush;
     }
 }
@@ -932,28 +910,28 @@ AudioSenderOnlineCoachv1::sendCoachAudio( const Coach & coach,
 
 void
 AudioSenderOnlineCoachv1::sendPlayerAudio( const Player & player,
-                                           const char * msg )
+                                           const Message & msg )
 {
     if ( generalPredicate() )
     {
         serializer().serializePlayerAudio( transport(),
                                            M_stadium.time(),
                                            ( listener().side() == player.side() ? player.name() : player.fixedName() ),
-                                           msg );
+                                           msg->c_str() );
         transport() << std::ends << std::flush;
     }
 }
 
 void
 AudioSenderOnlineCoachv7::sendPlayerAudio( const Player & player,
-                                           const char * msg )
+                                           const Message & msg )
 {
     if ( generalPredicate() )
     {
         serializer().serializePlayerAudio( transport(),
                                            M_stadium.time(),
                                            ( listener().side() == player.side() ? player.shortName() : player.fixedShortName() ),
-                                           msg );
+                                           msg->c_str() );
         transport() << std::ends << std::flush;
     }
 }
@@ -26,13 +26,15 @@
 
 #include "observer.h"
 #include "param.h"
+#include "poolallocator.h"
 #include "types.h"
 
 #include <rcss/factory.hpp>
 
 #include <string>
 #include <map>
-#include <list>
+#include <memory>
+#include <vector>
 
 
 class Coach;
@@ -68,6 +70,9 @@ class AudioSender
 public:
     typedef std::shared_ptr< rcss::AudioSender > Ptr;
 
+    //! a player's say message, stored once and shared by all the listeners
+    typedef std::shared_ptr< const std::string > Message;
+
 protected:
     const Stadium& M_stadium;
 
@@ -97,7 +102,7 @@ public:
 
     virtual
     void sendPlayerAudio( const Player &,
-                          const char * )
+                          const Message & )
       { }
 
     virtual
@@ -167,7 +172,7 @@ public:
     void sendCoachStdAudio( const clang::Msg & msg );
 
     void sendPlayerAudio( const Player & player,
-                          const char * msg );
+                          const AudioSender::Message & msg );
 
     void newCycle();
 
@@ -205,6 +210,21 @@ public:
 };
 
 
+/*!
+  \class MessagePool
+  \brief recycles the say messages shared by the listeners.  A message
+  that all the listeners have delivered or dropped is refilled by the
+  next say instead of allocating a new one.
+*/
+class MessagePool {
+private:
+    std::vector< std::shared_ptr< std::string > > M_messages;
+
+public:
+    AudioSender::Message get( const char * msg );
+};
+
+
 class SerializerPlayer;
 
 class AudioSenderPlayer
@@ -245,15 +265,15 @@ public:
 
     virtual
     void sendPlayerAudio( const Player & player,
-                          const char * msg );
+                          const Message & msg );
 
     virtual
-    void sendSelfAudio( const char * )
+    void sendSelfAudio( const Message & )
       { }
 
     virtual
     void sendNonSelfPlayerAudio( const Player &,
-                                 const char * )
+                                 const Message & )
       { }
 
     virtual
@@ -322,11 +342,11 @@ public:
     void sendCoachStdAudio( const clang::Msg & msg ) override;
 
     virtual
-    void sendSelfAudio( const char * msg ) override;
+    void sendSelfAudio( const Message & msg ) override;
 
     virtual
     void sendNonSelfPlayerAudio( const Player & player,
-                                 const char * msg ) override;
+                                 const Message & msg ) override;
 
     virtual
     void sendOKClang() override;
@@ -356,31 +376,28 @@ public:
 
     virtual
     void sendNonSelfPlayerAudio( const Player & player,
-                                 const char * msg ) override;
+                                 const Message & msg ) override;
 };
 
 
 class AudioSenderPlayerv8
     : public AudioSenderPlayerv7 {
 protected:
-    // the containers and pairs below use char* instead of const
-    // char* as the strings belong to the containers and pairs and
-    // will be deleted after they are removed. By making the
-    // non-const, a string needs to be copied to be inserted. I
-    // know it's a bit of a dodgy safty check, but it's better
-    // than nothing.  I'll try to make it cleaner later.  Idealy
-    // we should store them once in a general store and then point
-    // to that store.  Then we could just delete from that store
-    // when we are done... More work for later.
+    // the messages are shared with the other listeners and released
+    // when the last listener has delivered or dropped them.
 
     typedef const Player* player_key_t;
-    typedef std::pair< player_key_t, char* > player_key_value_t;
+    typedef std::pair< player_key_t, Message > player_key_value_t;
     typedef const Coach* coach_key_t;
-    typedef std::pair< coach_key_t, char* > coach_key_value_t;
+    typedef std::pair< coach_key_t, Message > coach_key_value_t;
 
-    typedef std::multimap< player_key_t, char* > player_msg_cont_t;
-    typedef std::list< char* > self_msg_cont_t;
-    typedef std::list< coach_key_value_t > coach_msg_cont_t;
+    // the containers are refilled every cycle, so they keep their memory.
+    // the nodes of the map come from the pool of the stadium.
+    typedef std::multimap< player_key_t, Message,
+                           std::less< player_key_t >,
+                           PoolAllocator< std::pair< const player_key_t, Message > > > player_msg_cont_t;
+    typedef std::vector< Message > self_msg_cont_t;
+    typedef std::vector< coach_key_value_t > coach_msg_cont_t;
 
     class State {
     public:
@@ -468,15 +485,7 @@ protected:
     bool M_right_complete;
 
 public:
-    AudioSenderPlayerv8( const Params & params )
-        : AudioSenderPlayerv7( params ),
-          M_state_p( &M_unfocused ),
-          M_focus_count ( 0 ),
-          M_left_partial( false ),
-          M_left_complete( true ),
-          M_right_partial( false ),
-          M_right_complete( true )
-      {}
+    AudioSenderPlayerv8( const Params & params );
 
     virtual
     ~AudioSenderPlayerv8() override;
@@ -486,11 +495,11 @@ public:
                          const char * msg ) override;
 
     virtual
-    void sendSelfAudio( const char * msg ) override;
+    void sendSelfAudio( const Message & msg ) override;
 
     virtual
     void sendNonSelfPlayerAudio( const Player & player,
-                                 const char * msg ) override;
+                                 const Message & msg ) override;
 
     virtual
     void newCycle() override;
@@ -525,11 +534,11 @@ protected:
                                const char * msg );
 
     virtual
-    void sendCachedSelfAudio( const char * msg );
+    void sendCachedSelfAudio( const Message & msg );
 
     virtual
     void sendCachedNonSelfPlayerAudio( const Player & player,
-                                       const char * msg );
+                                       const Message & msg );
 
     virtual
     bool nonSelfPlayerPredicate( const Player & player ) const;
@@ -625,7 +634,7 @@ public:
 
     virtual
     void sendPlayerAudio( const Player & player,
-                          const char * msg ) override;
+                          const Message & msg ) override;
 };
 
 
@@ -644,7 +653,7 @@ public:
 
     virtual
     void sendPlayerAudio( const Player & player,
-                          const char * msg ) override;
+                          const Message & msg ) override;
 };
 
 
@@ -730,7 +739,7 @@ public:
 
     virtual
     void sendPlayerAudio( const Player & player,
-                          const char * msg );
+                          const Message & msg );
 };
 
 class AudioSenderOnlineCoachv7
@@ -746,7 +755,7 @@ public:
 
     virtual
     void sendPlayerAudio( const Player & player,
-                          const char * msg );
+                          const Message & msg );
 };
 
 }
@@ -0,0 +1,589 @@
+// -*-c++-*-
+
+/***************************************************************************
+                                batchenv.cpp
+              Batches of in-process HFO/keepaway training fields
+                             -------------------
+    begin                : 2026-10-18
+    copyright            : (C) 2026 by The RoboCup Soccer Server
+                           Maintenance Group.
+    email                : sserver-admin@lists.sourceforge.net
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU LGPL as published by the Free Software  *
+ *   Foundation; either version 3 of the License, or (at your option) any  *
+ *   later version.                                                        *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "batchenv.h"
+
+#include "allocstat.h"
+#include "binaryprotocol.h"
+#include "hfofeatures.h"
+#include "player.h"
+#include "random.h"
+#include "rcssbatch.h"
+#include "serverparam.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <locale>
+
+namespace rcss {
+
+namespace {
+
+//! the protocol version of the local players
+const double LOCAL_PLAYER_VERSION = 19.0;
+
+bool
+starts_with( const char * msg,
+             const char * prefix )
+{
+    return std::strncmp( msg, prefix, std::strlen( prefix ) ) == 0;
+}
+
+}
+
+unsigned long
+allocation_count()
+{
+    // allocstat.cpp is linked only into rcssserver
+    return 0;
+}
+
+BatchEnv::Status::Status( const Stadium & stadium,
+                          std::ostream & transport )
+    : AudioSender( stadium, transport ),
+      M_outcome( NONE )
+{
+
+}
+
+void
+BatchEnv::Status::sendRefereeAudio( const char * msg )
+{
+    // the status messages of HFORef and KeepawayRef
+    if ( starts_with( msg, "GOAL" ) )
+    {
+        M_outcome = OFFENSE_WON;
+    }
+    else if ( starts_with( msg, "CAPTURED_BY_DEFENSE" )
+              || starts_with( msg, "OUT_OF_BOUNDS" ) )
+    {
+        M_outcome = DEFENSE_WON;
+    }
+    else if ( starts_with( msg, "OUT_OF_TIME" )
+              || starts_with( msg, "training Keepaway" ) )
+    {
+        M_outcome = DRAW;
+    }
+    else if ( starts_with( msg, "HFO_FINISHED" ) )
+    {
+        M_outcome = FINISHED;
+    }
+}
+
+
+BatchEnv::BatchEnv( const unsigned int seed )
+    : M_engine( seed ),
+      M_status( new Status( M_stadium, M_transport ) ),
+      M_listener( M_status ),
+      M_finished( false )
+{
+
+}
+
+BatchEnv::~BatchEnv()
+{
+    M_stadium.removeListener( &M_listener );
+}
+
+bool
+BatchEnv::init( const int offense,
+                const int defense )
+{
+    DefaultRNG::Scope scope( M_engine );
+
+    if ( ! M_stadium.initLocal() )
+    {
+        return false;
+    }
+
+    // otherwise HFORef takes server::random_seed when that is given and
+    // every env would start with the same episodes
+    M_stadium.setRefereeSeed( irand( RAND_MAX ) );
+
+    M_stadium.addListener( &M_listener );
+
+    for ( int i = 0; i < offense + defense; ++i )
+    {
+        const bool left = ( i < offense );
+        const bool goalie = ( i == offense
+                              && ServerParam::instance().hfoMode() );
+        Player * p = M_stadium.addLocalPlayer( left ? "base_left" : "base_right",
+                                               left ? LEFT : RIGHT,
+                                               LOCAL_PLAYER_VERSION,
+                                               goalie );
+        if ( ! p )
+        {
+            std::cerr << "batch: could not add player " << i << std::endl;
+            return false;
+        }
+        M_agents.push_back( p );
+    }
+
+    M_features.reserve( binary::HFO_FEATURE_SIZE );
+    return true;
+}
+
+void
+BatchEnv::reset( float * observations,
+                 float * rewards,
+                 unsigned char * done )
+{
+    DefaultRNG::Scope scope( M_engine );
+
+    // the first play_on lets the referee count the players and start
+    // its log, the later episodes are restarted in place
+    if ( ! M_finished
+         && ! M_stadium.restartEpisode() )
+    {
+        M_stadium.changePlayMode( PM_PlayOn );
+    }
+
+    M_status->clear();
+    observe( observations, rewards, done );
+}
+
+void
+BatchEnv::step( const float * actions,
+                float * observations,
+                float * rewards,
+                unsigned char * done )
+{
+    DefaultRNG::Scope scope( M_engine );
+
+    M_status->clear();
+
+    if ( ! M_finished )
+    {
+        M_stadium.applyDelayedEffects();
+
+        for ( Player * p : M_agents )
+        {
+            applyAction( *p, actions );
+            actions += RCSS_BATCH_ACTION_SIZE;
+        }
+
+        M_stadium.stepLocal();
+    }
+
+    observe( observations, rewards, done );
+}
+
+void
+BatchEnv::saveCheckpoint( std::string & data )
+{
+    DefaultRNG::Scope scope( M_engine );
+
+    data.push_back( M_finished ? 1 : 0 );
+    M_stadium.saveCheckpoint( data );
+}
+
+bool
+BatchEnv::loadCheckpoint( const char * data,
+                          const size_t size,
+                          float * observations,
+                          float * rewards,
+                          unsigned char * done )
+{
+    DefaultRNG::Scope scope( M_engine );
+
+    if ( size < 1
+         || ! M_stadium.loadCheckpoint( data + 1, size - 1 ) )
+    {
+        return false;
+    }
+
+    M_finished = ( data[0] != 0 );
+    M_status->clear();
+    observe( observations, rewards, done );
+    return true;
+}
+
+void
+BatchEnv::applyAction( pcom::Builder & player,
+                       const float * action )
+{
+    // the commands go through the interface of the command parser
+    switch ( static_cast< int >( std::lround( action[0] ) ) ) {
+    case RCSS_BATCH_DASH:
+        player.dash( action[1], action[2] );
+        break;
+    case RCSS_BATCH_TURN:
+        player.turn( action[1] );
+        break;
+    case RCSS_BATCH_KICK:
+        player.kick( action[1], action[2] );
+        break;
+    default:
+        break;
+    }
+}
+
+void
+BatchEnv::observe( float * observations,
+                   float * rewards,
+                   unsigned char * done )
+{
+    const HFOFeatures features( M_stadium );
+
+    for ( const Player * p : M_agents )
+    {
+        features.compute( *p, M_features );
+        observations = std::copy( M_features.begin(), M_features.end(), observations );
+    }
+
+    const Outcome outcome = M_status->outcome();
+    if ( outcome == FINISHED )
+    {
+        M_finished = true;
+    }
+
+    float offense_reward = 0.0f;
+    if ( outcome == OFFENSE_WON )
+    {
+        offense_reward = +1.0f;
+    }
+    else if ( outcome == DEFENSE_WON )
+    {
+        offense_reward = -1.0f;
+    }
+    else if ( ServerParam::instance().keepAwayMode()
+              && M_stadium.playmode() == PM_PlayOn )
+    {
+        offense_reward = +1.0f;
+    }
+
+    for ( const Player * p : M_agents )
+    {
+        *rewards++ = ( p->side() == LEFT ? offense_reward : -offense_reward );
+    }
+
+    *done = ( M_finished || outcome != NONE ) ? 1 : 0;
+}
+
+
+BatchRunner::BatchRunner( const int offense,
+                          const int defense )
+    : M_offense( offense ),
+      M_defense( defense ),
+      M_generation( 0 ),
+      M_pending( 0 ),
+      M_quit( false ),
+      M_actions( nullptr )
+{
+
+}
+
+BatchRunner::~BatchRunner()
+{
+    {
+        std::lock_guard< std::mutex > lock( M_mutex );
+        M_quit = true;
+    }
+    M_start_cond.notify_all();
+
+    for ( std::thread & t : M_workers )
+    {
+        t.join();
+    }
+}
+
+bool
+BatchRunner::init( const int num_envs,
+                   const int num_threads,
+                   const unsigned int seed )
+{
+    if ( num_envs <= 0
+         || M_offense < 0 || M_offense > MAX_PLAYER
+         || M_defense < 0 || M_defense > MAX_PLAYER
+         || M_offense + M_defense == 0 )
+    {
+        std::cerr << "batch: illegal size. envs=" << num_envs
+                  << " offense=" << M_offense
+                  << " defense=" << M_defense << std::endl;
+        return false;
+    }
+
+    if ( ! ServerParam::instance().hfoMode()
+         && ! ServerParam::instance().keepAwayMode() )
+    {
+        std::cerr << "batch: needs server::hfo or server::keepaway" << std::endl;
+        return false;
+    }
+
+    for ( int i = 0; i < num_envs; ++i )
+    {
+        M_envs.emplace_back( new BatchEnv( seed + i ) );
+        if ( ! M_envs.back()->init( M_offense, M_defense ) )
+        {
+            return false;
+        }
+    }
+
+    M_observations.resize( M_envs.size() * numAgents() * binary::HFO_FEATURE_SIZE );
+    M_rewards.resize( M_envs.size() * numAgents() );
+    M_dones.resize( M_envs.size() );
+
+    const size_t partitions = std::max( 1, std::min( num_threads, num_envs ) );
+    for ( size_t i = 1; i < partitions; ++i )
+    {
+        M_workers.emplace_back( &BatchRunner::work, this, i );
+    }
+
+    return true;
+}
+
+void
+BatchRunner::reset()
+{
+    dispatch( nullptr );
+}
+
+void
+BatchRunner::step( const float * actions )
+{
+    dispatch( actions );
+}
+
+size_t
+BatchRunner::checkpoint( const int env,
+                         void * buffer,
+                         const size_t size )
+{
+    if ( env < 0 || numEnvs() <= env )
+    {
+        return 0;
+    }
+
+    M_checkpoint.clear();
+    M_envs[env]->saveCheckpoint( M_checkpoint );
+
+    if ( buffer
+         && M_checkpoint.size() <= size )
+    {
+        std::memcpy( buffer, M_checkpoint.data(), M_checkpoint.size() );
+    }
+    return M_checkpoint.size();
+}
+
+bool
+BatchRunner::restore( const int env,
+                      const void * buffer,
+                      const size_t size )
+{
+    if ( env < 0 || numEnvs() <= env
+         || ! buffer )
+    {
+        return false;
+    }
+
+    const size_t agents = numAgents();
+    return M_envs[env]->loadCheckpoint( static_cast< const char * >( buffer ), size,
+                                        M_observations.data() + env * agents * binary::HFO_FEATURE_SIZE,
+                                        M_rewards.data() + env * agents,
+                                        M_dones.data() + env );
+}
+
+void
+BatchRunner::dispatch( const float * actions )
+{
+    {
+        std::lock_guard< std::mutex > lock( M_mutex );
+        M_actions = actions;
+        M_pending = M_workers.size();
+        ++M_generation;
+    }
+    M_start_cond.notify_all();
+
+    run( 0 );
+
+    std::unique_lock< std::mutex > lock( M_mutex );
+    M_done_cond.wait( lock, [this]{ return M_pending == 0; } );
+}
+
+void
+BatchRunner::run( const size_t partition )
+{
+    const size_t partitions = M_workers.size() + 1;
+    const size_t agents = numAgents();
+
+    for ( size_t i = partition; i < M_envs.size(); i += partitions )
+    {
+        float * obs = M_observations.data() + i * agents * binary::HFO_FEATURE_SIZE;
+        float * rewards = M_rewards.data() + i * agents;
+        unsigned char * done = M_dones.data() + i;
+
+        if ( M_actions )
+        {
+            M_envs[i]->step( M_actions + i * agents * RCSS_BATCH_ACTION_SIZE,
+                             obs, rewards, done );
+        }
+        else
+        {
+            M_envs[i]->reset( obs, rewards, done );
+        }
+    }
+}
+
+void
+BatchRunner::work( const size_t partition )
+{
+    unsigned long generation = 0;
+
+    while ( true )
+    {
+        {
+            std::unique_lock< std::mutex > lock( M_mutex );
+            M_start_cond.wait( lock, [&]{ return M_quit || M_generation != generation; } );
+            if ( M_quit )
+            {
+                return;
+            }
+            generation = M_generation;
+        }
+
+        run( partition );
+
+        {
+            std::lock_guard< std::mutex > lock( M_mutex );
+            --M_pending;
+        }
+        M_done_cond.notify_one();
+    }
+}
+
+}
+
+
+struct rcss_batch {
+    rcss::BatchRunner runner;
+
+    rcss_batch( const int offense,
+                const int defense )
+        : runner( offense, defense )
+      { }
+};
+
+extern "C" {
+
+int
+rcss_batch_init( int argc, const char * const * argv )
+{
+    std::locale::global( std::locale::classic() );
+
+    return ServerParam::init( argc, argv ) ? 0 : 1;
+}
+
+rcss_batch *
+rcss_batch_create( int num_envs,
+                   int offense,
+                   int defense,
+                   int num_threads,
+                   unsigned int seed )
+{
+    rcss_batch * batch = new rcss_batch( offense, defense );
+    if ( ! batch->runner.init( num_envs, num_threads, seed ) )
+    {
+        delete batch;
+        return nullptr;
+    }
+    return batch;
+}
+
+void
+rcss_batch_destroy( rcss_batch * batch )
+{
+    delete batch;
+}
+
+int
+rcss_batch_num_envs( const rcss_batch * batch )
+{
+    return batch->runner.numEnvs();
+}
+
+int
+rcss_batch_num_agents( const rcss_batch * batch )
+{
+    return batch->runner.numAgents();
+}
+
+int
+rcss_batch_observation_size( void )
+{
+    return rcss::binary::HFO_FEATURE_SIZE;
+}
+
+void
+rcss_batch_reset( rcss_batch * batch )
+{
+    batch->runner.reset();
+}
+
+void
+rcss_batch_step( rcss_batch * batch,
+                 const float * actions )
+{
+    batch->runner.step( actions );
+}
+
+const float *
+rcss_batch_observations( const rcss_batch * batch )
+{
+    return batch->runner.observations().data();
+}
+
+const float *
+rcss_batch_rewards( const rcss_batch * batch )
+{
+    return batch->runner.rewards().data();
+}
+
+const unsigned char *
+rcss_batch_dones( const rcss_batch * batch )
+{
+    return batch->runner.dones().data();
+}
+
+size_t
+rcss_batch_checkpoint( rcss_batch * batch,
+                       int env,
+                       void * buffer,
+                       size_t size )
+{
+    return batch->runner.checkpoint( env, buffer, size );
+}
+
+int
+rcss_batch_restore( rcss_batch * batch,
+                    int env,
+                    const void * buffer,
+                    size_t size )
+{
+    return batch->runner.restore( env, buffer, size ) ? 0 : 1;
+}
+
+}
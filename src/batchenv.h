@@ -0,0 +1,244 @@
+// -*-c++-*-
+
+/***************************************************************************
+                                 batchenv.h
+              Batches of in-process HFO/keepaway training fields
+                             -------------------
+    begin                : 2026-10-18
+    copyright            : (C) 2026 by The RoboCup Soccer Server
+                           Maintenance Group.
+    email                : sserver-admin@lists.sourceforge.net
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU LGPL as published by the Free Software  *
+ *   Foundation; either version 3 of the License, or (at your option) any  *
+ *   later version.                                                        *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef RCSS_BATCHENV_H
+#define RCSS_BATCHENV_H
+
+#include "audio.h"
+#include "random.h"
+#include "stadium.h"
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+class Player;
+
+namespace rcss {
+
+namespace pcom {
+class Builder;
+}
+
+/*!
+  \class BatchEnv
+  \brief one field of a BatchRunner: a local Stadium, the agents added
+  to it and the random engine that all of its work draws from.
+*/
+class BatchEnv {
+public:
+
+    enum Outcome {
+        NONE,
+        OFFENSE_WON, //!< GOAL
+        DEFENSE_WON, //!< CAPTURED_BY_DEFENSE, OUT_OF_BOUNDS
+        DRAW, //!< OUT_OF_TIME, or the end of a keepaway episode
+        FINISHED, //!< HFO_FINISHED
+    };
+
+private:
+
+    /*!
+      \class Status
+      \brief listens to the referee and keeps the outcome of the
+      current cycle.
+    */
+    class Status
+        : public AudioSender {
+    private:
+        Outcome M_outcome;
+    public:
+        Status( const Stadium & stadium,
+                std::ostream & transport );
+
+        void sendRefereeAudio( const char * msg ) override;
+
+        Outcome outcome() const
+          {
+              return M_outcome;
+          }
+
+        void clear()
+          {
+              M_outcome = NONE;
+          }
+    };
+
+    DefaultRNG::Engine M_engine;
+    Stadium M_stadium;
+    std::ostringstream M_transport; //!< never written, the audio senders need one
+    std::shared_ptr< Status > M_status;
+    Listener M_listener;
+    std::vector< Player * > M_agents;
+    std::vector< float > M_features;
+    bool M_finished;
+
+    // not used
+    BatchEnv( const BatchEnv & ) = delete;
+    BatchEnv & operator=( const BatchEnv & ) = delete;
+
+public:
+    explicit
+    BatchEnv( const unsigned int seed );
+
+    ~BatchEnv();
+
+    bool init( const int offense,
+               const int defense );
+
+    int numAgents() const
+      {
+          return static_cast< int >( M_agents.size() );
+      }
+
+    void reset( float * observations,
+                float * rewards,
+                unsigned char * done );
+
+    void step( const float * actions,
+               float * observations,
+               float * rewards,
+               unsigned char * done );
+
+    //! appends the state of the stadium and its random engine to \p data
+    void saveCheckpoint( std::string & data );
+
+    /*!
+      \brief restores a state saved by any env with the same agents and
+      observes it like reset().
+    */
+    bool loadCheckpoint( const char * data,
+                         const size_t size,
+                         float * observations,
+                         float * rewards,
+                         unsigned char * done );
+
+private:
+    void applyAction( pcom::Builder & player,
+                      const float * action );
+
+    void observe( float * observations,
+                  float * rewards,
+                  unsigned char * done );
+};
+
+/*!
+  \class BatchRunner
+  \brief owns the envs of a batch and steps them in lockstep.
+
+  The envs are partitioned statically between the calling thread and
+  num_threads - 1 workers.  Stadiums share no mutable state while they
+  step, except the random engine, which each env installs in its thread
+  with a DefaultRNG::Scope.
+*/
+class BatchRunner {
+private:
+    const int M_offense;
+    const int M_defense;
+
+    std::vector< std::unique_ptr< BatchEnv > > M_envs;
+
+    std::vector< float > M_observations;
+    std::vector< float > M_rewards;
+    std::vector< unsigned char > M_dones;
+
+    std::vector< std::thread > M_workers;
+    std::mutex M_mutex;
+    std::condition_variable M_start_cond;
+    std::condition_variable M_done_cond;
+    unsigned long M_generation; //!< incremented for every reset or step
+    size_t M_pending; //!< workers that have not finished this generation
+    bool M_quit;
+    const float * M_actions; //!< nullptr while resetting
+
+    std::string M_checkpoint; //!< reused by checkpoint()
+
+    // not used
+    BatchRunner( const BatchRunner & ) = delete;
+    BatchRunner & operator=( const BatchRunner & ) = delete;
+
+public:
+    BatchRunner( const int offense,
+                 const int defense );
+
+    ~BatchRunner();
+
+    bool init( const int num_envs,
+               const int num_threads,
+               const unsigned int seed );
+
+    int numEnvs() const
+      {
+          return static_cast< int >( M_envs.size() );
+      }
+
+    int numAgents() const
+      {
+          return M_offense + M_defense;
+      }
+
+    const std::vector< float > & observations() const
+      {
+          return M_observations;
+      }
+
+    const std::vector< float > & rewards() const
+      {
+          return M_rewards;
+      }
+
+    const std::vector< unsigned char > & dones() const
+      {
+          return M_dones;
+      }
+
+    void reset();
+
+    void step( const float * actions );
+
+    /*!
+      \brief saves env \p env and copies the checkpoint to \p buffer if
+      it has room for it.
+      \return the size of the checkpoint, or 0 for an illegal env
+    */
+    size_t checkpoint( const int env,
+                       void * buffer,
+                       const size_t size );
+
+    bool restore( const int env,
+                  const void * buffer,
+                  const size_t size );
+
+private:
+    void dispatch( const float * actions );
+
+    void run( const size_t partition );
+
+    void work( const size_t partition );
+};
+
+}
+
+#endif
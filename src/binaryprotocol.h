@@ -0,0 +1,532 @@
+// -*-c++-*-
+
+/***************************************************************************
+                              binaryprotocol.h
+               Compact binary player protocol and reference codec
+                             -------------------
+    begin                : 2026-10-18
+    copyright            : (C) 2026 by The RoboCup Soccer Server
+                           Maintenance Group.
+    email                : sserver-admin@lists.sourceforge.net
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU LGPL as published by the Free Software  *
+ *   Foundation; either version 3 of the License, or (at your option) any  *
+ *   later version.                                                        *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef RCSS_BINARYPROTOCOL_H
+#define RCSS_BINARYPROTOCOL_H
+
+/*
+  This header does not depend on the rest of the server, so client
+  teams can copy it into their own source tree.
+
+  A player asks for the binary protocol by adding "(binary)" to its
+  init command together with "(version N)", N >= 18. The server then
+  sends see, sense_body, fullstate and hear messages in the format
+  below. The init reply, parameters, errors, warnings and the other
+  rare messages stay text; a binary message never starts with '(' so
+  the first byte tells the two apart. The player may send the
+  commands listed in CommandTag in binary form as well, and any
+  command in text form.
+
+  message := MAGIC kind(u8) [time(i32)] record* END
+  record  := tag(u8) length(u16) payload[length]
+
+  The time field is present in every message from the server and
+  absent in command messages. All numbers are little endian, reals
+  are IEEE 754 single precision and strings are a u16 length followed
+  by the bytes without a terminator. The END tag is the single zero
+  byte that also ends every text message. A decoder must skip records
+  whose tag it does not know, which lets new records be added without
+  a new protocol version.
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace rcss {
+namespace binary {
+
+const std::uint8_t MAGIC = 0xb5;
+
+enum Kind {
+    SEE = 1,
+    SENSE_BODY = 2,
+    FULLSTATE = 3,
+    HEAR = 4,
+    FEATURES = 5,
+    COMMAND = 16,
+};
+
+enum Tag {
+    END = 0,
+
+    // see
+    OBJECT = 1, //!< str name, u8 fields, f32 value per field bit
+    PLAYER = 2, //!< str name, u8 fields, u8 state, f32 value per field bit
+
+    // sense_body. the sense_body records may also appear in fullstate.
+    VIEW_MODE = 10, //!< str quality, str width
+    STAMINA = 11, //!< f32 stamina, effort, capacity
+    SPEED = 12, //!< f32 amount, direction
+    HEAD_ANGLE = 13, //!< f32 angle
+    BODY_COUNTS = 14, //!< i32 kick, dash, turn, say, turn_neck, catch, move, change_view, change_focus
+    ARM = 15, //!< i32 movable, expires; f32 target dist, target dir; i32 count
+    FOCUS = 16, //!< str team or "none", i32 unum (-1 if none), i32 count
+    TACKLE = 17, //!< i32 expires, count
+    COLLISION = 18, //!< u8 COLLIDE_* bits
+    FOUL = 19, //!< i32 charged, u8 card (0 none, 1 yellow, 2 red)
+    FOCUS_POINT = 20, //!< f32 dist, dir
+
+    // fullstate
+    PLAY_MODE = 30, //!< str mode
+    FS_COUNTS = 31, //!< i32 kick, dash, turn, catch, move, turn_neck, change_view, say, change_focus
+    SCORE = 32, //!< i32 our, their
+    BALL = 33, //!< f32 x, y, vx, vy
+    FS_PLAYER = 34, //!< u8 side ('l' or 'r'), i32 unum, u8 goalie, i32 type, f32 x, y, vx, vy, body, neck
+    FS_PLAYER_ARM = 35, //!< f32 dist, dir of the last FS_PLAYER
+    FS_PLAYER_FOCUS = 36, //!< f32 dist, dir of the last FS_PLAYER
+    FS_PLAYER_STAMINA = 37, //!< f32 stamina, effort, recovery, capacity of the last FS_PLAYER
+    FS_PLAYER_STATE = 38, //!< u8 STATE_* bits of the last FS_PLAYER
+
+    // hear
+    HEAR_REFEREE = 50, //!< str message
+    HEAR_COACH = 51, //!< str name, str message
+    HEAR_SELF = 52, //!< str message
+    HEAR_PLAYER = 53, //!< f32 dir, str message
+    HEAR_ALLY = 54, //!< f32 dir, i32 unum, str message
+    HEAR_OPP = 55, //!< f32 dir, str message
+    HEAR_ALLY_SHORT = 56, //!< i32 unum
+    HEAR_OPP_SHORT = 57, //!< no payload
+
+    // features
+    FEATURE_VECTOR = 60, //!< f32 array in the HFOFeature layout
+};
+
+enum CommandTag {
+    CMD_DASH = 64, //!< f32 power [, f32 dir]
+    CMD_TURN = 65, //!< f32 moment
+    CMD_TURN_NECK = 66, //!< f32 moment
+    CMD_KICK = 67, //!< f32 power, dir
+    CMD_LONG_KICK = 68, //!< f32 power, dir
+    CMD_CATCH = 69, //!< f32 dir
+    CMD_MOVE = 70, //!< f32 x, y
+    CMD_TACKLE = 71, //!< f32 power_or_dir [, u8 foul]
+    CMD_CHANGE_FOCUS = 72, //!< f32 dist, dir
+    CMD_POINTTO = 73, //!< f32 dist, dir. no payload for "(pointto off)"
+    CMD_CHANGE_VIEW = 74, //!< u8 width (0 narrow, 1 normal, 2 wide) [, u8 quality (0 low, 1 high)]
+    CMD_SAY = 75, //!< str message
+    CMD_SENSE_BODY = 76,
+    CMD_SCORE = 77,
+    CMD_DONE = 78,
+    CMD_BYE = 79,
+};
+
+//! bits of the fields byte of OBJECT and PLAYER
+enum Field {
+    FIELD_DIST = 1 << 0,
+    FIELD_DIR = 1 << 1,
+    FIELD_CHANGE = 1 << 2, //!< two values, dist change and dir change
+    FIELD_BODY = 1 << 3,
+    FIELD_HEAD = 1 << 4,
+    FIELD_POINT = 1 << 5,
+};
+
+//! bits of the state byte of PLAYER and FS_PLAYER_STATE
+enum State {
+    STATE_TACKLE = 1 << 0,
+    STATE_KICK = 1 << 1,
+    STATE_FOUL = 1 << 2,
+    STATE_YELLOW_CARD = 1 << 3,
+    STATE_RED_CARD = 1 << 4,
+};
+
+/*!
+  \brief the layout of FEATURE_VECTOR, sent each cycle in HFO mode
+  when the server is started with hfo_features on.
+
+  Positions are field coordinates, in which the offense attacks the
+  goal at positive x. Angles are degrees; the directions are relative
+  to the body of the agent. Distances and directions to other objects
+  pass through the same noise model as the see message, and the open
+  angles are computed from those observed positions. Teammates are
+  sorted by uniform number, opponents likewise; a slot whose unum is 0
+  is empty.
+*/
+enum HFOFeature {
+    HFO_SELF_X = 0,
+    HFO_SELF_Y = 1,
+    HFO_SELF_BODY = 2,
+    HFO_SELF_NECK = 3, //!< relative to the body
+    HFO_SELF_STAMINA = 4, //!< stamina / stamina_max
+    HFO_KICKABLE = 5, //!< 1 if the ball is kickable, otherwise 0
+    HFO_BALL_DIST = 6,
+    HFO_BALL_DIR = 7,
+    HFO_GOAL_DIST = 8, //!< to the center of the goal at positive x
+    HFO_GOAL_DIR = 9,
+    HFO_GOAL_OPEN_ANGLE = 10, //!< widest part of the goal not covered by an opponent
+    HFO_NEAREST_OPPONENT_DIST = 11, //!< -1 without opponents
+
+    HFO_TEAMMATES = 12, //!< 10 slots of HFO_TEAMMATE_SIZE
+    HFO_TEAMMATE_UNUM = 0,
+    HFO_TEAMMATE_DIST = 1,
+    HFO_TEAMMATE_DIR = 2,
+    HFO_TEAMMATE_GOAL_OPEN_ANGLE = 3,
+    HFO_TEAMMATE_PASS_OPEN_ANGLE = 4, //!< smallest angle between the pass line and a nearer opponent
+    HFO_TEAMMATE_SIZE = 5,
+
+    HFO_OPPONENTS = HFO_TEAMMATES + 10 * HFO_TEAMMATE_SIZE, //!< 11 slots of HFO_OPPONENT_SIZE
+    HFO_OPPONENT_UNUM = 0,
+    HFO_OPPONENT_DIST = 1,
+    HFO_OPPONENT_DIR = 2,
+    HFO_OPPONENT_SIZE = 3,
+
+    HFO_FEATURE_SIZE = HFO_OPPONENTS + 11 * HFO_OPPONENT_SIZE,
+};
+
+//! bits of COLLISION
+enum Collide {
+    COLLIDE_BALL = 1 << 0,
+    COLLIDE_PLAYER = 1 << 1,
+    COLLIDE_POST = 1 << 2,
+};
+
+
+inline
+void
+put_u16( char * p,
+         const std::uint16_t v )
+{
+    p[0] = static_cast< char >( v & 0xff );
+    p[1] = static_cast< char >( ( v >> 8 ) & 0xff );
+}
+
+inline
+void
+put_u32( char * p,
+         const std::uint32_t v )
+{
+    p[0] = static_cast< char >( v & 0xff );
+    p[1] = static_cast< char >( ( v >> 8 ) & 0xff );
+    p[2] = static_cast< char >( ( v >> 16 ) & 0xff );
+    p[3] = static_cast< char >( ( v >> 24 ) & 0xff );
+}
+
+inline
+void
+put_f32( char * p,
+         const float v )
+{
+    std::uint32_t u;
+    std::memcpy( &u, &v, sizeof( u ) );
+    put_u32( p, u );
+}
+
+inline
+std::uint16_t
+get_u16( const char * p )
+{
+    const unsigned char * u = reinterpret_cast< const unsigned char * >( p );
+    return static_cast< std::uint16_t >( u[0] | ( u[1] << 8 ) );
+}
+
+inline
+std::uint32_t
+get_u32( const char * p )
+{
+    const unsigned char * u = reinterpret_cast< const unsigned char * >( p );
+    return ( static_cast< std::uint32_t >( u[0] )
+             | ( static_cast< std::uint32_t >( u[1] ) << 8 )
+             | ( static_cast< std::uint32_t >( u[2] ) << 16 )
+             | ( static_cast< std::uint32_t >( u[3] ) << 24 ) );
+}
+
+inline
+float
+get_f32( const char * p )
+{
+    const std::uint32_t u = get_u32( p );
+    float v;
+    std::memcpy( &v, &u, sizeof( v ) );
+    return v;
+}
+
+
+/*!
+  \class Record
+  \brief one record of a message. The read functions take the values
+  in order and return false when the payload is too short.
+*/
+class Record {
+private:
+    int M_tag;
+    const char * M_data;
+    std::size_t M_size;
+    std::size_t M_pos;
+
+public:
+    Record()
+        : M_tag( END ),
+          M_data( nullptr ),
+          M_size( 0 ),
+          M_pos( 0 )
+      { }
+
+    Record( const int tag,
+            const char * data,
+            const std::size_t size )
+        : M_tag( tag ),
+          M_data( data ),
+          M_size( size ),
+          M_pos( 0 )
+      { }
+
+    int tag() const { return M_tag; }
+    std::size_t size() const { return M_size; }
+    bool atEnd() const { return M_pos >= M_size; }
+
+    bool readU8( int & v )
+      {
+          if ( M_pos + 1 > M_size ) return false;
+          v = static_cast< unsigned char >( M_data[M_pos] );
+          M_pos += 1;
+          return true;
+      }
+
+    bool readI32( int & v )
+      {
+          if ( M_pos + 4 > M_size ) return false;
+          v = static_cast< std::int32_t >( get_u32( M_data + M_pos ) );
+          M_pos += 4;
+          return true;
+      }
+
+    bool readF32( double & v )
+      {
+          if ( M_pos + 4 > M_size ) return false;
+          v = get_f32( M_data + M_pos );
+          M_pos += 4;
+          return true;
+      }
+
+    bool readString( std::string & v )
+      {
+          if ( M_pos + 2 > M_size ) return false;
+          const std::size_t len = get_u16( M_data + M_pos );
+          if ( M_pos + 2 + len > M_size ) return false;
+          v.assign( M_data + M_pos + 2, len );
+          M_pos += 2 + len;
+          return true;
+      }
+};
+
+
+/*!
+  \class Reader
+  \brief walks the records of one message.
+
+  \code
+  rcss::binary::Reader reader( buf, len );
+  if ( reader.isBinary() && reader.kind() == rcss::binary::SEE )
+  {
+      rcss::binary::Record rec;
+      while ( reader.next( rec ) )
+      {
+          ...
+      }
+  }
+  \endcode
+*/
+class Reader {
+private:
+    const char * M_data;
+    std::size_t M_size;
+    std::size_t M_pos;
+    int M_kind;
+    int M_time;
+    bool M_error;
+
+public:
+    Reader( const char * data,
+            const std::size_t size )
+        : M_data( data ),
+          M_size( size ),
+          M_pos( 0 ),
+          M_kind( 0 ),
+          M_time( 0 ),
+          M_error( false )
+      {
+          if ( M_size < 2
+               || static_cast< unsigned char >( M_data[0] ) != MAGIC )
+          {
+              M_error = true;
+              return;
+          }
+
+          M_kind = static_cast< unsigned char >( M_data[1] );
+          M_pos = 2;
+          if ( M_kind != COMMAND )
+          {
+              if ( M_size < 6 )
+              {
+                  M_error = true;
+                  return;
+              }
+              M_time = static_cast< std::int32_t >( get_u32( M_data + 2 ) );
+              M_pos = 6;
+          }
+      }
+
+    //! true if the message has a valid binary header
+    bool isBinary() const
+      {
+          return M_size >= 2 && static_cast< unsigned char >( M_data[0] ) == MAGIC;
+      }
+
+    int kind() const { return M_kind; }
+    int time() const { return M_time; }
+
+    //! true if the message is truncated or has a broken record
+    bool error() const { return M_error; }
+
+    /*!
+      \brief take the next record.
+      \return false at the end of the message or on error.
+    */
+    bool next( Record & rec )
+      {
+          if ( M_error || M_pos >= M_size ) return false;
+
+          const int tag = static_cast< unsigned char >( M_data[M_pos] );
+          if ( tag == END ) return false;
+
+          if ( M_pos + 3 > M_size )
+          {
+              M_error = true;
+              return false;
+          }
+
+          const std::size_t len = get_u16( M_data + M_pos + 1 );
+          if ( M_pos + 3 + len > M_size )
+          {
+              M_error = true;
+              return false;
+          }
+
+          rec = Record( tag, M_data + M_pos + 3, len );
+          M_pos += 3 + len;
+          return true;
+      }
+};
+
+
+/*!
+  \class CommandWriter
+  \brief builds a binary command message for a client. Several
+  commands can be put into one message, as in the text protocol.
+*/
+class CommandWriter {
+private:
+    std::string M_buf;
+
+public:
+    CommandWriter()
+      {
+          clear();
+      }
+
+    void clear()
+      {
+          M_buf.assign( 1, static_cast< char >( MAGIC ) );
+          M_buf += static_cast< char >( COMMAND );
+      }
+
+    //! the message including the END byte
+    std::string data() const
+      {
+          return M_buf + '\0';
+      }
+
+    void dash( const double power ) { reals( CMD_DASH, 1, power ); }
+    void dash( const double power, const double dir ) { reals( CMD_DASH, 2, power, dir ); }
+    void turn( const double moment ) { reals( CMD_TURN, 1, moment ); }
+    void turnNeck( const double moment ) { reals( CMD_TURN_NECK, 1, moment ); }
+    void kick( const double power, const double dir ) { reals( CMD_KICK, 2, power, dir ); }
+    void longKick( const double power, const double dir ) { reals( CMD_LONG_KICK, 2, power, dir ); }
+    void goalieCatch( const double dir ) { reals( CMD_CATCH, 1, dir ); }
+    void move( const double x, const double y ) { reals( CMD_MOVE, 2, x, y ); }
+    void tackle( const double power_or_dir ) { reals( CMD_TACKLE, 1, power_or_dir ); }
+    void changeFocus( const double dist, const double dir ) { reals( CMD_CHANGE_FOCUS, 2, dist, dir ); }
+    void pointto( const double dist, const double dir ) { reals( CMD_POINTTO, 2, dist, dir ); }
+    void pointtoOff() { header( CMD_POINTTO, 0 ); }
+    void senseBody() { header( CMD_SENSE_BODY, 0 ); }
+    void score() { header( CMD_SCORE, 0 ); }
+    void done() { header( CMD_DONE, 0 ); }
+    void bye() { header( CMD_BYE, 0 ); }
+
+    void tackle( const double power_or_dir,
+                 const bool foul )
+      {
+          header( CMD_TACKLE, 5 );
+          real( power_or_dir );
+          M_buf += static_cast< char >( foul ? 1 : 0 );
+      }
+
+    //! \param width 0 narrow, 1 normal, 2 wide. \param quality 0 low, 1 high, -1 omitted
+    void changeView( const int width,
+                     const int quality = -1 )
+      {
+          header( CMD_CHANGE_VIEW, quality < 0 ? 1 : 2 );
+          M_buf += static_cast< char >( width );
+          if ( quality >= 0 ) M_buf += static_cast< char >( quality );
+      }
+
+    void say( const std::string & msg )
+      {
+          header( CMD_SAY, 2 + msg.size() );
+          char len[2];
+          put_u16( len, static_cast< std::uint16_t >( msg.size() ) );
+          M_buf.append( len, 2 );
+          M_buf += msg;
+      }
+
+private:
+    void header( const int tag,
+                 const std::size_t len )
+      {
+          char buf[3];
+          buf[0] = static_cast< char >( tag );
+          put_u16( buf + 1, static_cast< std::uint16_t >( len ) );
+          M_buf.append( buf, 3 );
+      }
+
+    void real( const double v )
+      {
+          char buf[4];
+          put_f32( buf, static_cast< float >( v ) );
+          M_buf.append( buf, 4 );
+      }
+
+    void reals( const int tag,
+                const int n,
+                const double a,
+                const double b = 0.0 )
+      {
+          header( tag, 4 * n );
+          real( a );
+          if ( n > 1 ) real( b );
+      }
+};
+
+}
+}
+
+#endif
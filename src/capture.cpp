@@ -0,0 +1,228 @@
+// -*-c++-*-
+
+/***************************************************************************
+                                capture.cpp
+                  Capture files of the client datagrams
+                             -------------------
+    begin                : 2026-10-18
+    copyright            : (C) 2026 by The RoboCup Soccer Server
+                           Maintenance Group.
+    email                : sserver-admin@lists.sourceforge.net
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU LGPL as published by the Free Software  *
+ *   Foundation; either version 3 of the License, or (at your option) any  *
+ *   later version.                                                        *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "capture.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <map>
+
+namespace rcss {
+
+namespace {
+
+const char CAPTURE_MAGIC[] = "rcsscap";
+const std::uint8_t CAPTURE_VERSION = 1;
+
+std::ofstream g_fout;
+std::chrono::steady_clock::time_point g_origin;
+std::map< std::pair< rcss::net::Addr::HostType, rcss::net::Addr::PortType >,
+          std::uint16_t > g_client_ids;
+
+template< typename T >
+void
+write_value( const T & value )
+{
+    g_fout.write( reinterpret_cast< const char * >( &value ), sizeof( T ) );
+}
+
+template< typename T >
+bool
+read_value( std::istream & is,
+            T & value )
+{
+    return static_cast< bool >( is.read( reinterpret_cast< char * >( &value ), sizeof( T ) ) );
+}
+
+void
+write_record( const std::int64_t time,
+              const std::uint16_t client,
+              const std::uint16_t port,
+              const std::uint8_t dir,
+              const char * data,
+              const std::uint16_t size )
+{
+    write_value( time );
+    write_value( client );
+    write_value( port );
+    write_value( dir );
+    write_value( size );
+    g_fout.write( data, size );
+}
+
+}
+
+bool
+Capture::open( const std::string & path )
+{
+    close();
+
+    g_fout.open( path.c_str(), std::ios_base::binary | std::ios_base::trunc );
+    if ( ! g_fout )
+    {
+        std::cerr << "Error: could not open the capture file \""
+                  << path << "\"" << std::endl;
+        return false;
+    }
+
+    g_fout.write( CAPTURE_MAGIC, sizeof( CAPTURE_MAGIC ) - 1 );
+    write_value( CAPTURE_VERSION );
+    g_origin = std::chrono::steady_clock::now();
+    g_client_ids.clear();
+    return true;
+}
+
+bool
+Capture::isOpen()
+{
+    return g_fout.is_open();
+}
+
+void
+Capture::close()
+{
+    if ( g_fout.is_open() )
+    {
+        g_fout.close();
+    }
+}
+
+void
+Capture::record( const Direction dir,
+                 const rcss::net::Addr & peer,
+                 const rcss::net::Addr::PortType server_port,
+                 const char * data,
+                 const size_t size )
+{
+    if ( ! g_fout.is_open() )
+    {
+        return;
+    }
+
+    const std::int64_t time
+        = std::chrono::duration_cast< std::chrono::nanoseconds >
+        ( std::chrono::steady_clock::now() - g_origin ).count();
+
+    const std::pair< rcss::net::Addr::HostType, rcss::net::Addr::PortType >
+        key( peer.getHost(), peer.getPort() );
+    std::map< std::pair< rcss::net::Addr::HostType, rcss::net::Addr::PortType >,
+              std::uint16_t >::iterator it = g_client_ids.find( key );
+    if ( it == g_client_ids.end() )
+    {
+        const std::uint16_t id = static_cast< std::uint16_t >( g_client_ids.size() );
+        it = g_client_ids.insert( std::make_pair( key, id ) ).first;
+
+        const rcss::net::Addr::HostType host = peer.getHost();
+        write_record( time, id, peer.getPort(), CLIENT,
+                      reinterpret_cast< const char * >( &host ), sizeof( host ) );
+    }
+
+    write_record( time, it->second, server_port, static_cast< std::uint8_t >( dir ),
+                  data, static_cast< std::uint16_t >( std::min< size_t >( size, 0xffff ) ) );
+}
+
+
+bool
+CaptureReader::open( const std::string & path )
+{
+    M_fin.open( path.c_str(), std::ios_base::binary );
+    if ( ! M_fin )
+    {
+        std::cerr << "Error: could not open the capture file \""
+                  << path << "\"" << std::endl;
+        return false;
+    }
+
+    char magic[sizeof( CAPTURE_MAGIC ) - 1];
+    std::uint8_t version = 0;
+    if ( ! M_fin.read( magic, sizeof( magic ) )
+         || std::memcmp( magic, CAPTURE_MAGIC, sizeof( magic ) ) != 0
+         || ! read_value( M_fin, version )
+         || version != CAPTURE_VERSION )
+    {
+        std::cerr << "Error: \"" << path << "\" is not a capture file"
+                  << " of version " << static_cast< int >( CAPTURE_VERSION ) << std::endl;
+        M_fin.close();
+        return false;
+    }
+
+    M_clients.clear();
+    return true;
+}
+
+bool
+CaptureReader::next( Record & rec )
+{
+    while ( M_fin )
+    {
+        std::uint16_t size = 0;
+        if ( ! read_value( M_fin, rec.time_ )
+             || ! read_value( M_fin, rec.client_ )
+             || ! read_value( M_fin, rec.port_ )
+             || ! read_value( M_fin, rec.direction_ )
+             || ! read_value( M_fin, size ) )
+        {
+            return false;
+        }
+
+        rec.data_.resize( size );
+        if ( size > 0
+             && ! M_fin.read( &rec.data_[0], size ) )
+        {
+            std::cerr << "Error: truncated capture record" << std::endl;
+            return false;
+        }
+
+        if ( rec.direction_ == Capture::CLIENT )
+        {
+            rcss::net::Addr::HostType host = 0;
+            if ( size == sizeof( host ) )
+            {
+                std::memcpy( &host, rec.data_.data(), sizeof( host ) );
+            }
+            if ( M_clients.size() <= rec.client_ )
+            {
+                M_clients.resize( rec.client_ + 1 );
+            }
+            M_clients[rec.client_] = rcss::net::Addr( rec.port_, host );
+            continue;
+        }
+
+        if ( rec.client_ >= M_clients.size() )
+        {
+            std::cerr << "Error: capture record of an unknown client "
+                      << rec.client_ << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+}
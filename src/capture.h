@@ -0,0 +1,113 @@
+// -*-c++-*-
+
+/***************************************************************************
+                                 capture.h
+                  Capture files of the client datagrams
+                             -------------------
+    begin                : 2026-10-18
+    copyright            : (C) 2026 by The RoboCup Soccer Server
+                           Maintenance Group.
+    email                : sserver-admin@lists.sourceforge.net
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU LGPL as published by the Free Software  *
+ *   Foundation; either version 3 of the License, or (at your option) any  *
+ *   later version.                                                        *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef RCSS_CAPTURE_H
+#define RCSS_CAPTURE_H
+
+#include <rcss/net/addr.hpp>
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace rcss {
+
+/*!
+  \class Capture
+  \brief records the datagrams exchanged with the clients.
+
+  A capture file starts with the magic "rcsscap" and a version byte,
+  followed by records of
+  <pre>
+  int64 time [ns since the capture was opened, monotonic]
+  uint16 client id
+  uint16 server port
+  uint8 direction
+  uint16 size
+  size bytes of data
+  </pre>
+  in the byte order of the host.  The first record of a client is a
+  CLIENT record that holds its host (uint32) as data and its port as
+  the server port.  The server port of the other records is the well
+  known port the datagram went through, or 0 for the dedicated socket
+  of the client.  Compressed messages are recorded before compression
+  on the way out and as received on the way in.
+*/
+class Capture {
+public:
+    enum Direction {
+        INBOUND = 0,
+        OUTBOUND = 1,
+        CLIENT = 2,
+    };
+
+private:
+    Capture() = delete;
+
+public:
+    static bool open( const std::string & path );
+
+    static bool isOpen();
+
+    static void close();
+
+    static void record( const Direction dir,
+                        const rcss::net::Addr & peer,
+                        const rcss::net::Addr::PortType server_port,
+                        const char * data,
+                        const size_t size );
+};
+
+/*!
+  \class CaptureReader
+  \brief reads the records of a capture file.  The CLIENT records are
+  consumed to build the table of client addresses.
+*/
+class CaptureReader {
+public:
+    struct Record {
+        std::int64_t time_; //!< [ns]
+        std::uint16_t client_;
+        std::uint16_t port_;
+        std::uint8_t direction_;
+        std::string data_;
+    };
+
+private:
+    std::ifstream M_fin;
+    std::vector< rcss::net::Addr > M_clients;
+
+public:
+    bool open( const std::string & path );
+
+    //! reads the next INBOUND or OUTBOUND record, false at the end
+    bool next( Record & rec );
+
+    const std::vector< rcss::net::Addr > & clients() const
+      {
+          return M_clients;
+      }
+};
+
+}
+
+#endif
@@ -0,0 +1,115 @@
+// -*-c++-*-
+
+/***************************************************************************
+                               checkpoint.cpp
+                  Binary snapshots of the simulation state
+                             -------------------
+    begin                : 2026-10-18
+    copyright            : (C) 2026 by The RoboCup Soccer Server
+                           Maintenance Group.
+    email                : sserver-admin@lists.sourceforge.net
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU LGPL as published by the Free Software  *
+ *   Foundation; either version 3 of the License, or (at your option) any  *
+ *   later version.                                                        *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "checkpoint.h"
+
+#include "player.h"
+#include "stadium.h"
+
+#include <cstdint>
+
+namespace rcss {
+
+CheckpointWriter::CheckpointWriter( std::string & data )
+    : M_data( data )
+{
+
+}
+
+void
+CheckpointWriter::putString( const std::string & str )
+{
+    put( static_cast< std::uint32_t >( str.size() ) );
+    M_data.append( str );
+}
+
+void
+CheckpointWriter::putPlayer( const Player * player )
+{
+    if ( ! player )
+    {
+        put( static_cast< std::int8_t >( NEUTRAL ) );
+        put( static_cast< std::int8_t >( 0 ) );
+        return;
+    }
+
+    put( static_cast< std::int8_t >( player->side() ) );
+    put( static_cast< std::int8_t >( player->unum() ) );
+}
+
+
+CheckpointReader::CheckpointReader( const Stadium & stadium,
+                                    const char * data,
+                                    const size_t size )
+    : M_stadium( stadium ),
+      M_ptr( data ),
+      M_end( data + size ),
+      M_ok( true )
+{
+
+}
+
+void
+CheckpointReader::getString( std::string & str )
+{
+    const std::uint32_t size = get< std::uint32_t >();
+    if ( ! M_ok
+         || static_cast< size_t >( M_end - M_ptr ) < size )
+    {
+        M_ok = false;
+        str.clear();
+        return;
+    }
+
+    str.assign( M_ptr, size );
+    M_ptr += size;
+}
+
+Player *
+CheckpointReader::getPlayer()
+{
+    const int side = get< std::int8_t >();
+    const int unum = get< std::int8_t >();
+
+    if ( ! M_ok
+         || side == NEUTRAL )
+    {
+        return nullptr;
+    }
+
+    for ( Player * p : M_stadium.players() )
+    {
+        if ( p->side() == side
+             && p->unum() == unum )
+        {
+            return p;
+        }
+    }
+
+    M_ok = false;
+    return nullptr;
+}
+
+}
@@ -0,0 +1,140 @@
+// -*-c++-*-
+
+/***************************************************************************
+                                checkpoint.h
+                  Binary snapshots of the simulation state
+                             -------------------
+    begin                : 2026-10-18
+    copyright            : (C) 2026 by The RoboCup Soccer Server
+                           Maintenance Group.
+    email                : sserver-admin@lists.sourceforge.net
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU LGPL as published by the Free Software  *
+ *   Foundation; either version 3 of the License, or (at your option) any  *
+ *   later version.                                                        *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef RCSS_CHECKPOINT_H
+#define RCSS_CHECKPOINT_H
+
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+class Player;
+class Stadium;
+
+namespace rcss {
+
+/*!
+  \class CheckpointWriter
+  \brief appends the state of the simulation objects to a binary blob.
+
+  Values, including the random engines, are stored with their in-memory
+  representation, so a checkpoint can only be restored by a server of
+  the same build and architecture.
+  The blob starts with a magic, a version and its size, which the
+  stadium checks before it restores anything.
+*/
+class CheckpointWriter {
+private:
+    std::string & M_data;
+
+    // not used
+    CheckpointWriter( const CheckpointWriter & ) = delete;
+    CheckpointWriter & operator=( const CheckpointWriter & ) = delete;
+
+public:
+    explicit
+    CheckpointWriter( std::string & data );
+
+    template< typename T >
+    void put( const T & value )
+      {
+          static_assert( std::is_trivially_copyable< T >::value,
+                         "checkpoint values must be trivially copyable" );
+          M_data.append( reinterpret_cast< const char * >( &value ), sizeof( T ) );
+      }
+
+    void putString( const std::string & str );
+
+    //! a player is stored as its side and uniform number, nullptr as NEUTRAL
+    void putPlayer( const Player * player );
+};
+
+/*!
+  \class CheckpointReader
+  \brief reads a blob written by CheckpointWriter.
+
+  Reading past the end, or a player that is not in the stadium, clears
+  ok() and yields default values, so that the callers can read a whole
+  object before the result is checked once.
+*/
+class CheckpointReader {
+private:
+    const Stadium & M_stadium;
+    const char * M_ptr;
+    const char * M_end;
+    bool M_ok;
+
+    // not used
+    CheckpointReader( const CheckpointReader & ) = delete;
+    CheckpointReader & operator=( const CheckpointReader & ) = delete;
+
+public:
+    CheckpointReader( const Stadium & stadium,
+                      const char * data,
+                      const size_t size );
+
+    bool ok() const
+      {
+          return M_ok;
+      }
+
+    bool atEnd() const
+      {
+          return M_ptr == M_end;
+      }
+
+    void fail()
+      {
+          M_ok = false;
+      }
+
+    template< typename T >
+    void get( T & value )
+      {
+          static_assert( std::is_trivially_copyable< T >::value,
+                         "checkpoint values must be trivially copyable" );
+          if ( ! M_ok
+               || static_cast< size_t >( M_end - M_ptr ) < sizeof( T ) )
+          {
+              M_ok = false;
+              value = T();
+              return;
+          }
+          std::memcpy( &value, M_ptr, sizeof( T ) );
+          M_ptr += sizeof( T );
+      }
+
+    template< typename T >
+    T get()
+      {
+          T value;
+          get( value );
+          return value;
+      }
+
+    void getString( std::string & str );
+
+    Player * getPlayer();
+};
+
+}
+
+#endif
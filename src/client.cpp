@@ -24,11 +24,14 @@
 #endif
 
 #include "compress.h"
+#include "loadgenerator.h"
+#include "rcssshm.h"
 
 #include <rcss/net/socketstreambuf.hpp>
 #include <rcss/net/udpsocket.hpp>
 #include <rcss/gzip/gzstream.hpp>
 
+#include <algorithm>
 #include <sstream>
 #include <iostream>
 #include <cerrno>
@@ -58,6 +61,57 @@
 #endif
 
 
+#ifdef __linux__
+/*!
+  \class ShmQueueStreamBuf
+  \brief sends one message to a shared memory queue on each flush, in
+  the same way as SocketStreamBuf sends one datagram.
+*/
+class ShmQueueStreamBuf
+    : public std::streambuf {
+private:
+    rcss_shm_queue & M_queue;
+    std::string M_msg;
+
+public:
+    explicit
+    ShmQueueStreamBuf( rcss_shm_queue & queue )
+        : std::streambuf(),
+          M_queue( queue )
+      { }
+
+protected:
+    int_type overflow( int_type c ) override
+      {
+          if ( ! traits_type::eq_int_type( c, traits_type::eof() ) )
+          {
+              M_msg += traits_type::to_char_type( c );
+          }
+          return traits_type::not_eof( c );
+      }
+
+    std::streamsize xsputn( const char_type * s,
+                            std::streamsize n ) override
+      {
+          M_msg.append( s, static_cast< std::size_t >( n ) );
+          return n;
+      }
+
+    int sync() override
+      {
+          if ( ! M_msg.empty()
+               && rcss_shm_send( &M_queue, M_msg.data(), M_msg.size() ) != 0 )
+          {
+              // dropped like a datagram that did not get through
+              std::cerr << "shared memory queue is full" << std::endl;
+          }
+          M_msg.clear();
+          return 0;
+      }
+};
+#endif
+
+
 class Client {
 private:
     rcss::net::Addr M_dest;
@@ -68,6 +122,13 @@ private:
     int M_comp_level;
     bool M_clean_cycle;
 
+#ifdef __linux__
+    //! the segment requested by "(shm NAME)" in the init command
+    std::string M_shm_name;
+    rcss_shm_segment * M_shm;
+    std::streambuf * M_shm_buf;
+#endif
+
 #ifdef HAVE_LIBZ
     Decompressor M_decomp;
 #endif
@@ -77,7 +138,8 @@ private:
     Client & operator=( const Client & );
 public:
     Client( const std::string & server,
-            const int port )
+            const int port,
+            const std::string & shm_name )
         : M_dest( port ),
           M_socket(),
           M_socket_buf( nullptr ),
@@ -85,7 +147,18 @@ public:
           M_transport( nullptr ),
           M_comp_level( -1 ),
           M_clean_cycle( true )
+#ifdef __linux__
+        , M_shm_name( shm_name ),
+          M_shm( nullptr ),
+          M_shm_buf( nullptr )
+#endif
       {
+#ifndef __linux__
+          if ( ! shm_name.empty() )
+          {
+              std::cerr << "-shm is not supported on this platform" << std::endl;
+          }
+#endif
           M_dest.setHost( server );
           open();
           bind();
@@ -161,6 +234,20 @@ private:
               M_gz_buf = nullptr;
           }
 
+#ifdef __linux__
+          if ( M_shm_buf )
+          {
+              delete M_shm_buf;
+              M_shm_buf = nullptr;
+          }
+
+          if ( M_shm )
+          {
+              rcss_shm_detach( M_shm );
+              M_shm = nullptr;
+          }
+#endif
+
           if ( M_socket_buf )
           {
               delete M_socket_buf;
@@ -171,18 +258,25 @@ private:
     int setCompression( int level )
       {
 #ifdef HAVE_LIBZ
+          std::streambuf * base = M_socket_buf;
+#ifdef __linux__
+          if ( M_shm_buf )
+          {
+              base = M_shm_buf;
+          }
+#endif
           if ( level >= 0 )
           {
               if ( ! M_gz_buf )
               {
-                  M_gz_buf = new rcss::gz::gzstreambuf( *M_socket_buf );
+                  M_gz_buf = new rcss::gz::gzstreambuf( *base );
               }
               M_gz_buf->setLevel( level );
               M_transport->rdbuf( M_gz_buf );
           }
           else
           {
-              M_transport->rdbuf( M_socket_buf );
+              M_transport->rdbuf( base );
           }
           return M_comp_level = level;
 #endif
@@ -232,6 +326,49 @@ private:
           std::cout << std::string( msg, len - 1 ) << std::endl;
       }
 
+#ifdef __linux__
+    /*!
+      The server creates the segment before it replies to the init
+      command, which may take a moment if it is busy.
+    */
+    void attachSharedMemory()
+      {
+          for ( int i = 0; i < 100 && ! M_shm; ++i )
+          {
+              M_shm = rcss_shm_attach( M_shm_name.c_str() );
+              if ( ! M_shm )
+              {
+                  usleep( 10 * 1000 );
+              }
+          }
+
+          if ( M_shm )
+          {
+              std::cerr << "attached to shared memory /" << M_shm_name << std::endl;
+              M_shm_name.clear();
+
+              M_shm_buf = new ShmQueueStreamBuf( M_shm->to_server );
+              M_transport->rdbuf( M_shm_buf );
+          }
+          else
+          {
+              std::cerr << "could not attach to shared memory /" << M_shm_name
+                        << ", using UDP" << std::endl;
+              M_shm_name.clear();
+          }
+      }
+
+    void readSharedMemory()
+      {
+          size_t len = 0;
+          while ( const char * msg = rcss_shm_front( &M_shm->to_client, &len ) )
+          {
+              processMsg( msg, len );
+              rcss_shm_pop( &M_shm->to_client );
+          }
+      }
+#endif
+
     void messageLoop()
       {
           fd_set read_fds;
@@ -254,7 +391,20 @@ private:
           {
 
               read_fds = read_fds_back;
-              int ret = ::select( max_fd, &read_fds, nullptr, nullptr, nullptr );
+              timeval * timeout = nullptr;
+#ifdef __linux__
+              // nothing wakes select() for the messages in the segment,
+              // so it is polled every 10 milliseconds
+              timeval poll_interval;
+              if ( M_shm )
+              {
+                  readSharedMemory();
+                  poll_interval.tv_sec = 0;
+                  poll_interval.tv_usec = 10 * 1000;
+                  timeout = &poll_interval;
+              }
+#endif
+              int ret = ::select( max_fd, &read_fds, nullptr, nullptr, timeout );
               if ( ret < 0 )
               {
                   perror( "Error selecting input" );
@@ -276,6 +426,12 @@ private:
 
                           M_transport->write( buf, len + 1 );
                           M_transport->flush();
+#ifdef __linux__
+                          if ( ! M_shm_name.empty() )
+                          {
+                              attachSharedMemory();
+                          }
+#endif
                           if ( ! M_transport->good() )
                           {
                               if ( errno != ECONNREFUSED )
@@ -354,6 +510,9 @@ main ( int argc, char **argv )
 
     std::string server = "localhost";
     int port = 6000;
+    std::string shm_name;
+    bool load = false;
+    LoadGenerator::Options load_opt;
 
     for ( int i = 0; i < argc; ++i )
     {
@@ -373,9 +532,118 @@ main ( int argc, char **argv )
                 ++i;
             }
         }
+        else if ( std::strcmp( argv[ i ], "-shm" ) == 0 )
+        {
+            // the name given in "(shm NAME)" of the init command
+            if ( i + 1 < argc )
+            {
+                shm_name = argv[ i + 1 ];
+                ++i;
+            }
+        }
+        else if ( std::strcmp( argv[ i ], "-load" ) == 0 )
+        {
+            if ( i + 1 < argc )
+            {
+                load = true;
+                load_opt.players_ = std::atoi( argv[ i + 1 ] );
+                ++i;
+            }
+        }
+        else if ( std::strcmp( argv[ i ], "-coaches" ) == 0 )
+        {
+            if ( i + 1 < argc )
+            {
+                load_opt.coaches_ = std::atoi( argv[ i + 1 ] );
+                ++i;
+            }
+        }
+        else if ( std::strcmp( argv[ i ], "-coach_port" ) == 0 )
+        {
+            if ( i + 1 < argc )
+            {
+                load_opt.coach_port_ = std::atoi( argv[ i + 1 ] );
+                ++i;
+            }
+        }
+        else if ( std::strcmp( argv[ i ], "-team" ) == 0 )
+        {
+            if ( i + 1 < argc )
+            {
+                load_opt.team_ = argv[ i + 1 ];
+                ++i;
+            }
+        }
+        else if ( std::strcmp( argv[ i ], "-version" ) == 0 )
+        {
+            if ( i + 1 < argc )
+            {
+                load_opt.version_ = std::atof( argv[ i + 1 ] );
+                ++i;
+            }
+        }
+        else if ( std::strcmp( argv[ i ], "-policy" ) == 0 )
+        {
+            if ( i + 1 < argc )
+            {
+                if ( ! load_opt.parsePolicy( argv[ i + 1 ] ) )
+                {
+                    std::cerr << "Illegal policy: " << argv[ i + 1 ]
+                              << " (e.g. dash=50,turn=20,kick=10,say=5,change_view=5)"
+                              << std::endl;
+                    return EXIT_FAILURE;
+                }
+                ++i;
+            }
+        }
+        else if ( std::strcmp( argv[ i ], "-think_latency" ) == 0 )
+        {
+            if ( i + 1 < argc )
+            {
+                load_opt.think_latency_
+                    = std::chrono::microseconds( static_cast< long long >( std::atof( argv[ i + 1 ] ) * 1000.0 ) );
+                ++i;
+            }
+        }
+        else if ( std::strcmp( argv[ i ], "-duration" ) == 0 )
+        {
+            if ( i + 1 < argc )
+            {
+                load_opt.duration_ = std::atof( argv[ i + 1 ] );
+                ++i;
+            }
+        }
+        else if ( std::strcmp( argv[ i ], "-report" ) == 0 )
+        {
+            if ( i + 1 < argc )
+            {
+                load_opt.report_interval_ = std::max( 0.1, std::atof( argv[ i + 1 ] ) );
+                ++i;
+            }
+        }
+        else if ( std::strcmp( argv[ i ], "-seed" ) == 0 )
+        {
+            if ( i + 1 < argc )
+            {
+                load_opt.seed_ = static_cast< unsigned int >( std::atoi( argv[ i + 1 ] ) );
+                ++i;
+            }
+        }
+    }
+
+    if ( load )
+    {
+        // load generator mode:
+        //   -load N -coaches N -team NAME -version V -coach_port PORT
+        //   -policy dash=W,turn=W,kick=W,say=W,change_view=W
+        //   -think_latency MSEC -duration SEC -report SEC -seed N
+        load_opt.server_ = server;
+        load_opt.port_ = port;
+        LoadGenerator generator( load_opt );
+        return ( generator.run() ? EXIT_SUCCESS : EXIT_FAILURE );
     }
 
-    client = new Client( server, port );
+    client = new Client( server, port, shm_name );
     client->run();
 
     return EXIT_SUCCESS;
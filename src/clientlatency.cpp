@@ -0,0 +1,174 @@
+// -*-c++-*-
+
+/***************************************************************************
+                             clientlatency.cpp
+                  Response latencies of the remote clients
+                             -------------------
+    begin                : 2026-10-18
+    copyright            : (C) 2026 by The RoboCup Soccer Server
+                           Maintenance Group.
+    email                : sserver-admin@lists.sourceforge.net
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU LGPL as published by the Free Software  *
+ *   Foundation; either version 3 of the License, or (at your option) any  *
+ *   later version.                                                        *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "clientlatency.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <ostream>
+
+namespace rcss {
+
+namespace {
+
+double
+elapsed_usec( const ClientLatency::Clock::time_point & from )
+{
+    return std::chrono::duration_cast< std::chrono::duration< double, std::micro > >
+        ( ClientLatency::Clock::now() - from ).count();
+}
+
+}
+
+LatencyHistogram::LatencyHistogram()
+    : M_count( 0 ),
+      M_sum( 0.0 ),
+      M_max( 0.0 )
+{
+    std::fill( M_buckets, M_buckets + BUCKETS, 0 );
+    std::fill( M_recent, M_recent + RECENT, 0.0 );
+}
+
+void
+LatencyHistogram::add( const double usec )
+{
+    int bucket = 0;
+    if ( usec >= 1.0 )
+    {
+        bucket = std::min( static_cast< int >( std::log2( usec ) ) + 1, BUCKETS - 1 );
+    }
+
+    ++M_buckets[bucket];
+    M_recent[M_count % RECENT] = usec;
+    ++M_count;
+    M_sum += usec;
+    M_max = std::max( M_max, usec );
+}
+
+double
+LatencyHistogram::quantile( const double rate ) const
+{
+    if ( M_count == 0 )
+    {
+        return 0.0;
+    }
+
+    const double target = rate * M_count;
+    unsigned long sum = 0;
+    for ( int i = 0; i < BUCKETS; ++i )
+    {
+        if ( M_buckets[i] > 0
+             && sum + M_buckets[i] >= target )
+        {
+            // bucket i holds [2^(i-1), 2^i), interpolated linearly
+            const double low = ( i == 0 ? 0.0 : std::ldexp( 1.0, i - 1 ) );
+            const double high = std::ldexp( 1.0, i );
+            const double rank = ( target - sum ) / M_buckets[i];
+            return std::min( low + ( high - low ) * rank, M_max );
+        }
+        sum += M_buckets[i];
+    }
+
+    return M_max;
+}
+
+double
+LatencyHistogram::recentMean() const
+{
+    const unsigned long size = std::min( M_count, static_cast< unsigned long >( RECENT ) );
+    if ( size == 0 )
+    {
+        return 0.0;
+    }
+
+    double sum = 0.0;
+    for ( unsigned long i = 0; i < size; ++i )
+    {
+        sum += M_recent[i];
+    }
+    return sum / size;
+}
+
+std::ostream &
+LatencyHistogram::print( std::ostream & os ) const
+{
+    const std::ios_base::fmtflags flags = os.flags();
+    const std::streamsize precision = os.precision();
+
+    os << std::fixed << std::setprecision( 3 )
+       << M_count
+       << ' ' << mean() * 0.001
+       << ' ' << quantile( 0.5 ) * 0.001
+       << ' ' << quantile( 0.95 ) * 0.001
+       << ' ' << M_max * 0.001
+       << ' ' << recentMean() * 0.001;
+
+    os.flags( flags );
+    os.precision( precision );
+    return os;
+}
+
+
+ClientLatency::ClientLatency()
+    : M_sensor_pending( false ),
+      M_think_pending( false ),
+      M_missed_cycles( 0 )
+{
+
+}
+
+void
+ClientLatency::commandReceived()
+{
+    if ( M_sensor_pending )
+    {
+        M_response.add( elapsed_usec( M_sensor_time ) );
+        M_sensor_pending = false;
+    }
+}
+
+void
+ClientLatency::doneReceived()
+{
+    if ( M_think_pending )
+    {
+        M_think.add( elapsed_usec( M_think_time ) );
+        M_think_pending = false;
+    }
+}
+
+std::ostream &
+ClientLatency::print( std::ostream & os ) const
+{
+    os << "(response ";
+    M_response.print( os );
+    os << ") (think ";
+    M_think.print( os );
+    os << ") (missed " << M_missed_cycles << ')';
+    return os;
+}
+
+}
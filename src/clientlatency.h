@@ -0,0 +1,158 @@
+// -*-c++-*-
+
+/***************************************************************************
+                              clientlatency.h
+                  Response latencies of the remote clients
+                             -------------------
+    begin                : 2026-10-18
+    copyright            : (C) 2026 by The RoboCup Soccer Server
+                           Maintenance Group.
+    email                : sserver-admin@lists.sourceforge.net
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU LGPL as published by the Free Software  *
+ *   Foundation; either version 3 of the License, or (at your option) any  *
+ *   later version.                                                        *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef RCSS_CLIENTLATENCY_H
+#define RCSS_CLIENTLATENCY_H
+
+#include <chrono>
+#include <iosfwd>
+
+namespace rcss {
+
+/*!
+  \class LatencyHistogram
+  \brief a distribution of latencies in power of two microsecond
+  buckets.  The last RECENT samples are kept as well, to tell a client
+  that is late now from one that was late once.
+*/
+class LatencyHistogram {
+public:
+    enum {
+        BUCKETS = 25, //!< up to 2^24 us, about 16 seconds
+        RECENT = 100,
+    };
+
+private:
+    unsigned long M_buckets[BUCKETS];
+    unsigned long M_count;
+    double M_sum; //!< [us]
+    double M_max; //!< [us]
+
+    double M_recent[RECENT]; //!< a ring of the last samples [us]
+
+public:
+    LatencyHistogram();
+
+    void add( const double usec );
+
+    unsigned long count() const
+      {
+          return M_count;
+      }
+
+    double mean() const
+      {
+          return ( M_count > 0 ? M_sum / M_count : 0.0 );
+      }
+
+    double max() const
+      {
+          return M_max;
+      }
+
+    //! the \p rate quantile, interpolated within its bucket [us]
+    double quantile( const double rate ) const;
+
+    double recentMean() const;
+
+    //! prints (count mean p50 p95 max recent_mean) in milliseconds
+    std::ostream & print( std::ostream & os ) const;
+};
+
+/*!
+  \class ClientLatency
+  \brief the latencies of a RemoteClient.
+
+  The response latency is measured from the first sensor message that
+  the client has not answered yet to its next message.  In synch mode
+  the think latency is measured from (think) to (done), and the cycles
+  that ended without the (done) of the client are counted as missed.
+*/
+class ClientLatency {
+public:
+    typedef std::chrono::steady_clock Clock;
+
+private:
+    Clock::time_point M_sensor_time;
+    bool M_sensor_pending;
+    Clock::time_point M_think_time;
+    bool M_think_pending;
+
+    LatencyHistogram M_response;
+    LatencyHistogram M_think;
+    unsigned long M_missed_cycles;
+
+public:
+    ClientLatency();
+
+    void sensorSent()
+      {
+          if ( ! M_sensor_pending )
+          {
+              M_sensor_time = Clock::now();
+              M_sensor_pending = true;
+          }
+      }
+
+    void commandReceived();
+
+    void thinkSent()
+      {
+          M_think_time = Clock::now();
+          M_think_pending = true;
+      }
+
+    void doneReceived();
+
+    void cycleMissed()
+      {
+          ++M_missed_cycles;
+      }
+
+    bool empty() const
+      {
+          return M_response.count() == 0
+              && M_think.count() == 0
+              && M_missed_cycles == 0;
+      }
+
+    const LatencyHistogram & response() const
+      {
+          return M_response;
+      }
+
+    const LatencyHistogram & think() const
+      {
+          return M_think;
+      }
+
+    unsigned long missedCycles() const
+      {
+          return M_missed_cycles;
+      }
+
+    //! prints (response ...) (think ...) (missed N)
+    std::ostream & print( std::ostream & os ) const;
+};
+
+}
+
+#endif
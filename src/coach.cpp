@@ -50,6 +50,29 @@
 
 namespace {
 
+/*!
+  \brief check whether a trainer command changes the state that the
+  coaches see, so that their cached look has to be rebuilt before the
+  next simulation step.
+*/
+bool
+changes_world( const char * com )
+{
+    static const char * const commands[] = {
+        "start", "change_mode", "move", "scene",
+        "recover", "restore", "change_player_type",
+    };
+
+    for ( const char * c : commands )
+    {
+        if ( ! std::strcmp( c, com ) )
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 PlayMode
 play_mode_id( const char * mode )
 {
@@ -251,6 +274,12 @@ Coach::parse_command( const char * command )
         return;
     }
 
+    if ( changes_world( com ) )
+    {
+        // the trainer may change the world state between two steps
+        rcss::VisualSenderCoach::newCycle();
+    }
+
     if ( ! std::strcmp( com, "start" ) )
     {
         M_stadium.kickOff();
@@ -264,6 +293,10 @@ Coach::parse_command( const char * command )
     {
         parse_move( command );
     }
+    else if ( ! std::strcmp( com, "scene" ) )
+    {
+        parse_scene( command );
+    }
     else if ( ! std::strcmp( com, "look" ) )
     {
         look();
@@ -276,6 +309,18 @@ Coach::parse_command( const char * command )
     {
         recover();
     }
+    else if ( ! std::strcmp( com, "latency" ) )
+    {
+        send_latency();
+    }
+    else if ( ! std::strcmp( com, "checkpoint" ) )
+    {
+        checkpoint( command );
+    }
+    else if ( ! std::strcmp( com, "restore" ) )
+    {
+        restore( command );
+    }
     else if ( ! std::strcmp( com, "check_ball" ) )
     {
         check_ball();
@@ -347,6 +392,7 @@ Coach::parse_command( const char * command )
     {
         //std::cerr << "Recv trainer done" << std::endl;
         M_done_received = true;
+        latency().doneReceived();
         return;
     }
     else if ( ! std::strcmp( com, "compression" ) )
@@ -550,6 +596,157 @@ Coach::parse_move( const char * command )
     return n_read;
 }
 
+/*!
+  (scene [(change_mode MODE)] [(time TIME)] [(recover)]
+         [(ball X Y [VELX VELY])]
+         {(player l|r UNUM X Y [BODY [VELX VELY [STAMINA]]])})
+
+  The whole scene is checked before any of it is applied, and it is
+  acknowledged once.
+*/
+void
+Coach::parse_scene( const char * command )
+{
+    int n_read = 0;
+    std::sscanf( command, " ( scene %n", &n_read );
+    if ( n_read == 0 )
+    {
+        send( "(error illegal_command_form)" );
+        return;
+    }
+    command += n_read;
+
+    Scene scene;
+    char elem[32];
+    while ( true )
+    {
+        n_read = 0;
+        if ( std::sscanf( command, " ( %31[a-z_] %n", elem, &n_read ) != 1 )
+        {
+            break;
+        }
+        command += n_read;
+
+        // the arguments of the element, which may be empty
+        char args[256] = "";
+        n_read = 0;
+        std::sscanf( command, "%255[^()]%n", args, &n_read );
+        command += n_read;
+
+        n_read = 0;
+        std::sscanf( command, " ) %n", &n_read );
+        if ( n_read == 0 )
+        {
+            send( "(error illegal_command_form)" );
+            return;
+        }
+        command += n_read;
+
+        if ( ! std::strcmp( elem, "change_mode" ) )
+        {
+            char mode[128];
+            if ( std::sscanf( args, " %127[-0-9a-zA-Z.+*/?<>_] ", mode ) != 1 )
+            {
+                send( "(error illegal_command_form)" );
+                return;
+            }
+
+            scene.playmode_ = play_mode_id( mode );
+            if ( scene.playmode_ == PM_Null )
+            {
+                send( "(error illegal_mode)" );
+                return;
+            }
+        }
+        else if ( ! std::strcmp( elem, "time" ) )
+        {
+            if ( std::sscanf( args, " %d ", &scene.time_ ) != 1
+                 || scene.time_ < 0 )
+            {
+                send( "(error illegal_command_form)" );
+                return;
+            }
+        }
+        else if ( ! std::strcmp( elem, "recover" ) )
+        {
+            scene.recover_ = true;
+        }
+        else if ( ! std::strcmp( elem, "ball" ) )
+        {
+            double x = 0.0, y = 0.0, velx = 0.0, vely = 0.0;
+            const int n = std::sscanf( args, " %lf %lf %lf %lf ",
+                                       &x, &y, &velx, &vely );
+            if ( ( n != 2 && n != 4 )
+                 || std::isnan( x ) != 0
+                 || std::isnan( y ) != 0
+                 || std::isnan( velx ) != 0
+                 || std::isnan( vely ) != 0 )
+            {
+                send( "(error illegal_object_form)" );
+                return;
+            }
+
+            scene.has_ball_ = true;
+            scene.ball_pos_.assign( x, y );
+            scene.ball_vel_.assign( velx, vely );
+        }
+        else if ( ! std::strcmp( elem, "player" ) )
+        {
+            char side = 0;
+            int unum = 0;
+            double x = 0.0, y = 0.0, ang = 0.0, velx = 0.0, vely = 0.0, stamina = 0.0;
+            const int n = std::sscanf( args, " %c %d %lf %lf %lf %lf %lf %lf ",
+                                       &side, &unum, &x, &y, &ang, &velx, &vely, &stamina );
+            if ( n < 4 || n == 6
+                 || ( side != 'l' && side != 'r' )
+                 || std::isnan( x ) != 0
+                 || std::isnan( y ) != 0
+                 || std::isnan( ang ) != 0
+                 || std::isnan( velx ) != 0
+                 || std::isnan( vely ) != 0
+                 || std::isnan( stamina ) != 0 )
+            {
+                send( "(error illegal_object_form)" );
+                return;
+            }
+
+            Scene::PlayerState state;
+            state.side_ = ( side == 'l' ? LEFT : RIGHT );
+            state.unum_ = unum;
+            state.pos_.assign( x, y );
+            state.has_angle_ = ( n >= 5 );
+            state.angle_ = normalize_angle( Deg2Rad( ang ) );
+            state.has_vel_ = ( n >= 7 );
+            state.vel_.assign( velx, vely );
+            state.has_stamina_ = ( n >= 8 );
+            state.stamina_ = stamina;
+            scene.players_.push_back( state );
+        }
+        else
+        {
+            send( "(error illegal_command_form)" );
+            return;
+        }
+    }
+
+    n_read = 0;
+    std::sscanf( command, " ) %n", &n_read );
+    if ( n_read == 0
+         || command[n_read] != '\0' )
+    {
+        send( "(error illegal_command_form)" );
+        return;
+    }
+
+    if ( ! M_stadium.setScene( scene ) )
+    {
+        send( "(error illegal_object_form)" );
+        return;
+    }
+
+    send( "(ok scene)" );
+}
+
 void
 Coach::ear( std::string mode )
 {
@@ -719,6 +916,60 @@ Coach::recover()
     send( ost.str().c_str() );
 }
 
+void
+Coach::send_latency()
+{
+    std::ostringstream ost;
+    ost << "(ok latency ";
+    M_stadium.printLatency( ost );
+    ost << ')';
+    send( ost.str().c_str() );
+}
+
+void
+Coach::checkpoint( const char * command )
+{
+    // (checkpoint file) writes server::checkpoint_file.  the trainer
+    // never names a path itself.
+    char target[8];
+    if ( std::sscanf( command, " ( checkpoint %7[^ ()] ) ", target ) == 1 )
+    {
+        if ( std::strcmp( target, "file" ) != 0
+             || ServerParam::instance().checkpointFile().empty()
+             || ! M_stadium.saveCheckpointFile( ServerParam::instance().checkpointFile() ) )
+        {
+            send( "(error checkpoint_failed)" );
+            return;
+        }
+    }
+    else
+    {
+        M_checkpoint.clear();
+        M_stadium.saveCheckpoint( M_checkpoint );
+    }
+
+    send( "(ok checkpoint)" );
+}
+
+void
+Coach::restore( const char * command )
+{
+    char target[8];
+    bool result = false;
+    if ( std::sscanf( command, " ( restore %7[^ ()] ) ", target ) == 1 )
+    {
+        result = ( std::strcmp( target, "file" ) == 0
+                   && ! ServerParam::instance().checkpointFile().empty()
+                   && M_stadium.loadCheckpointFile( ServerParam::instance().checkpointFile() ) );
+    }
+    else if ( ! M_checkpoint.empty() )
+    {
+        result = M_stadium.restoreCheckpoint( M_checkpoint.data(), M_checkpoint.size() );
+    }
+
+    send( result ? "(ok restore)" : "(error restore_failed)" );
+}
+
 
 void
 Coach::change_player_type( const std::string & team_name,
@@ -1382,6 +1633,7 @@ OnlineCoach::parse_command( const char * command )
     {
         //std::cerr << "Recv olc done" << std::endl;
         M_done_received = true;
+        latency().doneReceived();
         return;
     }
     else if ( ! std::strcmp( com, "compression" ) )
@@ -61,6 +61,8 @@ protected:
 
 private:
 
+    std::string M_checkpoint; //!< the state saved by (checkpoint) without an argument
+
     // not used
     Coach() = delete;
     Coach( const Coach & ) = delete;
@@ -125,12 +127,16 @@ public:
 private:
     int parse_change_mode( const char * command );
     int parse_move( const char * command );
+    void parse_scene( const char * command );
 
     void change_mode( std::string mode );
 
     void ear( std::string mode );
 
     void recover();
+    void checkpoint( const char * command );
+    void send_latency();
+    void restore( const char * command );
     void change_player_type( const std::string & team_name,
                              int unum,
                              int player_type );
@@ -0,0 +1,336 @@
+// -*-c++-*-
+
+/***************************************************************************
+                               commandlog.cpp
+                  Logs of the commands applied to the simulation
+                             -------------------
+    begin                : 2026-10-18
+    copyright            : (C) 2026 by The RoboCup Soccer Server
+                           Maintenance Group.
+    email                : sserver-admin@lists.sourceforge.net
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU LGPL as published by the Free Software  *
+ *   Foundation; either version 3 of the License, or (at your option) any  *
+ *   later version.                                                        *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "commandlog.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace rcss {
+
+namespace {
+
+const char COMMANDLOG_MAGIC[] = "rcsscmd";
+const std::uint8_t COMMANDLOG_VERSION = 1;
+
+enum RecordType {
+    // 0 .. 6 are the callbacks
+    MESSAGE = 16,
+    DISCONNECT = 17,
+};
+
+struct Record {
+    std::uint8_t type_;
+    std::uint8_t channel_;
+    rcss::net::Addr::HostType host_;
+    rcss::net::Addr::PortType port_;
+    std::string data_;
+};
+
+std::ofstream g_fout;
+
+std::ifstream g_fin;
+bool g_replaying = false;
+bool g_has_record = false;
+Record g_record;
+unsigned long g_skipped = 0;
+
+template< typename T >
+void
+write_value( const T & value )
+{
+    g_fout.write( reinterpret_cast< const char * >( &value ), sizeof( T ) );
+}
+
+template< typename T >
+bool
+read_value( T & value )
+{
+    return static_cast< bool >( g_fin.read( reinterpret_cast< char * >( &value ), sizeof( T ) ) );
+}
+
+void
+write_addr( const rcss::net::Addr & addr )
+{
+    write_value( static_cast< std::uint32_t >( addr.getHost() ) );
+    write_value( static_cast< std::uint16_t >( addr.getPort() ) );
+}
+
+bool
+read_addr( Record & rec )
+{
+    std::uint32_t host = 0;
+    std::uint16_t port = 0;
+    if ( ! read_value( host )
+         || ! read_value( port ) )
+    {
+        return false;
+    }
+    rec.host_ = host;
+    rec.port_ = port;
+    return true;
+}
+
+//! reads the next record into g_record
+void
+advance()
+{
+    g_has_record = false;
+
+    Record & rec = g_record;
+    if ( ! read_value( rec.type_ ) )
+    {
+        return;
+    }
+
+    if ( rec.type_ == MESSAGE )
+    {
+        std::uint16_t size = 0;
+        if ( ! read_value( rec.channel_ )
+             || ! read_addr( rec )
+             || ! read_value( size ) )
+        {
+            return;
+        }
+        rec.data_.resize( size );
+        if ( size > 0
+             && ! g_fin.read( &rec.data_[0], size ) )
+        {
+            return;
+        }
+    }
+    else if ( rec.type_ == DISCONNECT )
+    {
+        if ( ! read_addr( rec ) )
+        {
+            return;
+        }
+    }
+    else if ( rec.type_ > CommandLog::SEND_THINK )
+    {
+        std::cerr << "Error: unknown command log record "
+                  << static_cast< int >( rec.type_ ) << std::endl;
+        return;
+    }
+
+    g_has_record = true;
+}
+
+bool
+is_from( const Record & rec,
+         const rcss::net::Addr & addr )
+{
+    return rec.host_ == addr.getHost()
+        && rec.port_ == addr.getPort();
+}
+
+}
+
+bool
+CommandLog::openRecord( const std::string & path,
+                        const int random_seed )
+{
+    g_fout.open( path.c_str(), std::ios_base::binary | std::ios_base::trunc );
+    if ( ! g_fout )
+    {
+        std::cerr << "Error: could not open the command log \""
+                  << path << "\"" << std::endl;
+        return false;
+    }
+
+    g_fout.write( COMMANDLOG_MAGIC, sizeof( COMMANDLOG_MAGIC ) - 1 );
+    write_value( COMMANDLOG_VERSION );
+    write_value( static_cast< std::int32_t >( random_seed ) );
+    return true;
+}
+
+bool
+CommandLog::isRecording()
+{
+    return g_fout.is_open();
+}
+
+void
+CommandLog::recordCallback( const Callback cb )
+{
+    if ( g_fout.is_open() )
+    {
+        write_value( static_cast< std::uint8_t >( cb ) );
+    }
+}
+
+void
+CommandLog::recordMessage( const Channel channel,
+                           const rcss::net::Addr & addr,
+                           const char * msg,
+                           const size_t len )
+{
+    if ( ! g_fout.is_open() )
+    {
+        return;
+    }
+
+    const std::uint16_t size = static_cast< std::uint16_t >( std::min< size_t >( len, 0xffff ) );
+    write_value( static_cast< std::uint8_t >( MESSAGE ) );
+    write_value( static_cast< std::uint8_t >( channel ) );
+    write_addr( addr );
+    write_value( size );
+    g_fout.write( msg, size );
+}
+
+void
+CommandLog::recordDisconnect( const rcss::net::Addr & addr )
+{
+    if ( g_fout.is_open() )
+    {
+        write_value( static_cast< std::uint8_t >( DISCONNECT ) );
+        write_addr( addr );
+    }
+}
+
+bool
+CommandLog::openReplay( const std::string & path,
+                        int & random_seed )
+{
+    g_fin.open( path.c_str(), std::ios_base::binary );
+    if ( ! g_fin )
+    {
+        std::cerr << "Error: could not open the command log \""
+                  << path << "\"" << std::endl;
+        return false;
+    }
+
+    char magic[sizeof( COMMANDLOG_MAGIC ) - 1];
+    std::uint8_t version = 0;
+    std::int32_t seed = 0;
+    if ( ! g_fin.read( magic, sizeof( magic ) )
+         || std::memcmp( magic, COMMANDLOG_MAGIC, sizeof( magic ) ) != 0
+         || ! read_value( version )
+         || version != COMMANDLOG_VERSION
+         || ! read_value( seed ) )
+    {
+        std::cerr << "Error: \"" << path << "\" is not a command log"
+                  << " of version " << static_cast< int >( COMMANDLOG_VERSION ) << std::endl;
+        g_fin.close();
+        return false;
+    }
+
+    random_seed = seed;
+    g_replaying = true;
+    g_skipped = 0;
+    advance();
+    return true;
+}
+
+bool
+CommandLog::isReplaying()
+{
+    return g_replaying;
+}
+
+bool
+CommandLog::nextCallback( Callback & cb )
+{
+    while ( g_has_record )
+    {
+        const std::uint8_t type = g_record.type_;
+        advance();
+
+        if ( type <= SEND_THINK )
+        {
+            cb = static_cast< Callback >( type );
+            return true;
+        }
+
+        // the re-simulation has diverged from the recorded one
+        ++g_skipped;
+    }
+
+    return false;
+}
+
+int
+CommandLog::nextMessage( const Channel channel,
+                         const rcss::net::Addr * client,
+                         rcss::net::Addr & from,
+                         char * msg,
+                         const size_t max_len )
+{
+    if ( ! g_has_record
+         || g_record.type_ != MESSAGE
+         || g_record.channel_ != channel
+         || ( client && ! is_from( g_record, *client ) ) )
+    {
+        errno = EWOULDBLOCK;
+        return -1;
+    }
+
+    const size_t len = std::min( g_record.data_.size(), max_len );
+    std::memcpy( msg, g_record.data_.data(), len );
+    from = rcss::net::Addr( g_record.port_, g_record.host_ );
+    advance();
+    return static_cast< int >( len );
+}
+
+bool
+CommandLog::nextDisconnect( const rcss::net::Addr & addr )
+{
+    if ( ! g_has_record
+         || g_record.type_ != DISCONNECT
+         || ! is_from( g_record, addr ) )
+    {
+        return false;
+    }
+
+    advance();
+    return true;
+}
+
+unsigned long
+CommandLog::skippedRecords()
+{
+    return g_skipped;
+}
+
+void
+CommandLog::close()
+{
+    if ( g_fout.is_open() )
+    {
+        g_fout.close();
+    }
+
+    if ( g_fin.is_open() )
+    {
+        g_fin.close();
+    }
+    g_has_record = false;
+}
+
+}
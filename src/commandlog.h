@@ -0,0 +1,126 @@
+// -*-c++-*-
+
+/***************************************************************************
+                                commandlog.h
+                  Logs of the commands applied to the simulation
+                             -------------------
+    begin                : 2026-10-18
+    copyright            : (C) 2026 by The RoboCup Soccer Server
+                           Maintenance Group.
+    email                : sserver-admin@lists.sourceforge.net
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU LGPL as published by the Free Software  *
+ *   Foundation; either version 3 of the License, or (at your option) any  *
+ *   later version.                                                        *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef RCSS_COMMANDLOG_H
+#define RCSS_COMMANDLOG_H
+
+#include <rcss/net/addr.hpp>
+
+#include <string>
+
+namespace rcss {
+
+/*!
+  \class CommandLog
+  \brief records the timer callbacks and the client messages in the
+  order the server processed them, and feeds them back for an offline
+  re-simulation.
+
+  A re-simulation with the seed of the log calls the same callbacks and
+  reads the same messages at the same points, so that the random engine
+  is used in the same order and the game log is reproduced exactly.
+  No socket is used: the message of a client is taken from the log
+  when the client is polled, and everything sent to it is discarded.
+
+  The file starts with the magic "rcsscmd", a version byte and the
+  random seed (int32), followed by a type byte per record.  A MESSAGE
+  record has a channel byte, the host (uint32) and port (uint16) of the
+  client, a size (uint16) and the data.  A DISCONNECT record, written
+  when the socket of a client failed, has the host and port.  All
+  values are in the byte order of the host.
+*/
+class CommandLog {
+public:
+    enum Callback {
+        RECV_FROM_CLIENTS = 0,
+        NEW_SIMULATOR_STEP = 1,
+        SEND_SENSE_BODY = 2,
+        SEND_VISUALS = 3,
+        SEND_SYNCH_VISUALS = 4,
+        SEND_COACH_MESSAGES = 5,
+        SEND_THINK = 6,
+    };
+
+    enum Channel {
+        DEDICATED = 0, //!< the socket of the client
+        PLAYER_PORT = 1,
+        OFFLINE_COACH_PORT = 2,
+        ONLINE_COACH_PORT = 3,
+    };
+
+private:
+    CommandLog() = delete;
+
+public:
+
+    //
+    // recording
+    //
+
+    static bool openRecord( const std::string & path,
+                            const int random_seed );
+
+    static bool isRecording();
+
+    static void recordCallback( const Callback cb );
+
+    static void recordMessage( const Channel channel,
+                               const rcss::net::Addr & addr,
+                               const char * msg,
+                               const size_t len );
+
+    static void recordDisconnect( const rcss::net::Addr & addr );
+
+    //
+    // replaying
+    //
+
+    static bool openReplay( const std::string & path,
+                            int & random_seed );
+
+    static bool isReplaying();
+
+    //! the next callback, the records that were not consumed are skipped
+    static bool nextCallback( Callback & cb );
+
+    /*!
+      \brief takes the next record if it is a message on \p channel from
+      \p client, or from any client if \p client is nullptr.
+      \return the size of the message, or -1 with errno EWOULDBLOCK
+    */
+    static int nextMessage( const Channel channel,
+                            const rcss::net::Addr * client,
+                            rcss::net::Addr & from,
+                            char * msg,
+                            const size_t max_len );
+
+    //! takes the next record if it is the disconnection of \p addr
+    static bool nextDisconnect( const rcss::net::Addr & addr );
+
+    //! the number of records that the re-simulation did not consume
+    static unsigned long skippedRecords();
+
+    static void close();
+};
+
+}
+
+#endif
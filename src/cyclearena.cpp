@@ -0,0 +1,190 @@
+// -*-c++-*-
+
+/***************************************************************************
+                                cyclearena.cpp
+                  Bump allocator for the temporaries of a step
+                             -------------------
+    begin                : 2026-10-18
+    copyright            : (C) 2026 by The RoboCup Soccer Server
+                           Maintenance Group.
+    email                : sserver-admin@lists.sourceforge.net
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU LGPL as published by the Free Software  *
+ *   Foundation; either version 3 of the License, or (at your option) any  *
+ *   later version.                                                        *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "cyclearena.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+namespace rcss {
+
+namespace {
+
+// the chunk header is padded so that the data behind it is aligned
+const std::size_t CHUNK_HEADER_SIZE
+= ( ( sizeof( std::size_t ) * 2 + alignof( std::max_align_t ) - 1 )
+    / alignof( std::max_align_t ) ) * alignof( std::max_align_t );
+
+}
+
+const std::size_t CycleArena::MIN_CHUNK_SIZE = 64 * 1024;
+
+CycleArena::CycleArena()
+    : M_chunks( nullptr ),
+      M_pos( nullptr ),
+      M_end( nullptr ),
+      M_used( 0 )
+{
+
+}
+
+CycleArena::~CycleArena()
+{
+    releaseChunks();
+}
+
+void *
+CycleArena::allocate( const std::size_t size,
+                      const std::size_t align )
+{
+    std::uintptr_t p = reinterpret_cast< std::uintptr_t >( M_pos );
+    p = ( p + align - 1 ) & ~( static_cast< std::uintptr_t >( align ) - 1 );
+
+    if ( ! M_pos
+         || p + size > reinterpret_cast< std::uintptr_t >( M_end ) )
+    {
+        addChunk( std::max( size + align, MIN_CHUNK_SIZE ) );
+        p = reinterpret_cast< std::uintptr_t >( M_pos );
+        p = ( p + align - 1 ) & ~( static_cast< std::uintptr_t >( align ) - 1 );
+    }
+
+    M_pos = reinterpret_cast< char * >( p + size );
+    M_used += size;
+    return reinterpret_cast< void * >( p );
+}
+
+void
+CycleArena::reset()
+{
+    if ( M_chunks && M_chunks->next_ )
+    {
+        // the last step did not fit into one chunk.  replace them by
+        // one chunk that is large enough for a step like it.
+        std::size_t total = 0;
+        for ( const Chunk * c = M_chunks; c; c = c->next_ )
+        {
+            total += c->size_;
+        }
+        releaseChunks();
+        addChunk( std::max( total, M_used ) );
+    }
+    else if ( M_chunks )
+    {
+        M_pos = reinterpret_cast< char * >( M_chunks ) + CHUNK_HEADER_SIZE;
+    }
+
+    M_used = 0;
+}
+
+void
+CycleArena::addChunk( const std::size_t size )
+{
+    Chunk * c = static_cast< Chunk * >( ::operator new( CHUNK_HEADER_SIZE + size ) );
+    c->next_ = M_chunks;
+    c->size_ = size;
+    M_chunks = c;
+
+    M_pos = reinterpret_cast< char * >( c ) + CHUNK_HEADER_SIZE;
+    M_end = M_pos + size;
+}
+
+void
+CycleArena::releaseChunks()
+{
+    while ( M_chunks )
+    {
+        Chunk * next = M_chunks->next_;
+        ::operator delete( M_chunks );
+        M_chunks = next;
+    }
+
+    M_pos = nullptr;
+    M_end = nullptr;
+}
+
+
+ArenaStreamBuf::ArenaStreamBuf( CycleArena & arena )
+    : std::streambuf(),
+      M_arena( arena )
+{
+
+}
+
+ArenaStreamBuf::int_type
+ArenaStreamBuf::overflow( int_type c )
+{
+    if ( traits_type::eq_int_type( c, traits_type::eof() ) )
+    {
+        return traits_type::not_eof( c );
+    }
+
+    grow( 1 );
+    *pptr() = traits_type::to_char_type( c );
+    pbump( 1 );
+    return c;
+}
+
+std::streamsize
+ArenaStreamBuf::xsputn( const char_type * s,
+                        std::streamsize n )
+{
+    if ( n <= 0 )
+    {
+        return 0;
+    }
+
+    if ( epptr() - pptr() < n )
+    {
+        grow( static_cast< std::size_t >( n ) );
+    }
+
+    std::memcpy( pptr(), s, static_cast< std::size_t >( n ) );
+    pbump( static_cast< int >( n ) );
+    return n;
+}
+
+void
+ArenaStreamBuf::grow( const std::size_t min_size )
+{
+    const std::size_t used = size();
+    const std::size_t capacity = static_cast< std::size_t >( epptr() - pbase() );
+    const std::size_t new_capacity = std::max( std::max( capacity * 2,
+                                                         used + min_size ),
+                                               static_cast< std::size_t >( 1024 ) );
+
+    // the old buffer stays in the arena until its next reset
+    char * buf = static_cast< char * >( M_arena.allocate( new_capacity, 1 ) );
+    if ( used > 0 )
+    {
+        std::memcpy( buf, pbase(), used );
+    }
+
+    setp( buf, buf + new_capacity );
+    pbump( static_cast< int >( used ) );
+}
+
+}
@@ -0,0 +1,159 @@
+// -*-c++-*-
+
+/***************************************************************************
+                                 cyclearena.h
+                  Bump allocator for the temporaries of a step
+                             -------------------
+    begin                : 2026-10-18
+    copyright            : (C) 2026 by The RoboCup Soccer Server
+                           Maintenance Group.
+    email                : sserver-admin@lists.sourceforge.net
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU LGPL as published by the Free Software  *
+ *   Foundation; either version 3 of the License, or (at your option) any  *
+ *   later version.                                                        *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef RCSS_CYCLEARENA_H
+#define RCSS_CYCLEARENA_H
+
+#include <cstddef>
+#include <streambuf>
+
+namespace rcss {
+
+/*!
+  \class CycleArena
+  \brief a bump allocator for the temporaries of a simulation step,
+  e.g. the buffers that a frame is serialized into before it is cached.
+
+  Nothing is released on its own.  reset() gives back everything at
+  once when the stadium starts the next step.  A step that needed more
+  than one chunk leaves a single chunk of the total size behind, so
+  steps of the usual size do not touch the heap.
+*/
+class CycleArena {
+private:
+    struct Chunk {
+        Chunk * next_;
+        std::size_t size_;
+    };
+
+    static const std::size_t MIN_CHUNK_SIZE;
+
+    Chunk * M_chunks; //!< the chunk in use, followed by the full ones
+    char * M_pos;
+    char * M_end;
+    std::size_t M_used; //!< the bytes handed out since the last reset
+
+    // not used
+    CycleArena( const CycleArena & ) = delete;
+    CycleArena & operator=( const CycleArena & ) = delete;
+
+public:
+    CycleArena();
+    ~CycleArena();
+
+    void * allocate( const std::size_t size,
+                     const std::size_t align = alignof( std::max_align_t ) );
+
+    //! releases all the memory handed out since the last reset
+    void reset();
+
+private:
+    void addChunk( const std::size_t size );
+    void releaseChunks();
+};
+
+
+/*!
+  \class ArenaAllocator
+  \brief an allocator for containers that live no longer than the
+  current step of a CycleArena.  Their memory is released by reset().
+*/
+template< typename T >
+class ArenaAllocator {
+private:
+    CycleArena * M_arena;
+
+    template< typename U >
+    friend class ArenaAllocator;
+
+public:
+    typedef T value_type;
+
+    explicit
+    ArenaAllocator( CycleArena & arena ) noexcept
+        : M_arena( &arena )
+      { }
+
+    template< typename U >
+    ArenaAllocator( const ArenaAllocator< U > & other ) noexcept
+        : M_arena( other.M_arena )
+      { }
+
+    T * allocate( const std::size_t n )
+      {
+          return static_cast< T * >( M_arena->allocate( n * sizeof( T ), alignof( T ) ) );
+      }
+
+    void deallocate( T *,
+                     const std::size_t ) noexcept
+      { }
+
+    template< typename U >
+    bool operator==( const ArenaAllocator< U > & other ) const noexcept
+      {
+          return M_arena == other.M_arena;
+      }
+
+    template< typename U >
+    bool operator!=( const ArenaAllocator< U > & other ) const noexcept
+      {
+          return M_arena != other.M_arena;
+      }
+};
+
+
+/*!
+  \class ArenaStreamBuf
+  \brief an output buffer in a CycleArena, used instead of an
+  ostringstream for data that is copied elsewhere in the same step.
+*/
+class ArenaStreamBuf
+    : public std::streambuf {
+private:
+    CycleArena & M_arena;
+
+public:
+    explicit
+    ArenaStreamBuf( CycleArena & arena );
+
+    const char * data() const
+      {
+          return pbase();
+      }
+
+    std::size_t size() const
+      {
+          return static_cast< std::size_t >( pptr() - pbase() );
+      }
+
+protected:
+    int_type overflow( int_type c ) override;
+
+    std::streamsize xsputn( const char_type * s,
+                            std::streamsize n ) override;
+
+private:
+    void grow( const std::size_t min_size );
+};
+
+}
+
+#endif
@@ -33,7 +33,10 @@
 #include "types.h"
 #include "xpmholder.h"
 
+#include <functional>
+#include <map>
 #include <sstream>
+#include <typeindex>
 #include <cmath>
 
 #ifdef HAVE_NETINET_IN_H
@@ -66,6 +69,87 @@ DispSender::~DispSender()
 
 }
 
+namespace {
+
+/*!
+  The serialized show data of a frame depends only on the sender
+  class and the serializer class, so all monitors (and the logger)
+  sharing these reuse the bytes of the first one.
+*/
+struct ShowFrame {
+    unsigned long frame_;
+    std::string data_;
+
+    ShowFrame()
+        : frame_( 0 )
+      { }
+};
+
+typedef std::map< std::pair< std::type_index, std::type_index >, ShowFrame > ShowFrameCache;
+
+unsigned long g_frame = 1;
+
+ShowFrameCache &
+show_frame_cache()
+{
+    static ShowFrameCache s_cache;
+    return s_cache;
+}
+
+}
+
+void
+DispSender::newFrame()
+{
+    ++g_frame;
+}
+
+const std::string &
+DispSender::cachedFrame( const Stadium & stadium,
+                         const std::type_info & format,
+                         const std::type_info & serializer,
+                         const std::function< void( std::ostream & ) > & build )
+{
+    ShowFrame & entry = show_frame_cache()[ std::make_pair( std::type_index( format ),
+                                                            std::type_index( serializer ) ) ];
+    if ( entry.frame_ != g_frame )
+    {
+        rcss::ArenaStreamBuf buf( stadium.cycleArena() );
+        std::ostream os( &buf );
+        build( os );
+        entry.data_.assign( buf.data(), buf.size() );
+        entry.frame_ = g_frame;
+    }
+
+    return entry.data_;
+}
+
+const std::string &
+DispSender::cachedShowBody( const SerializerMonitor & ser,
+                            const Stadium & stadium )
+{
+    return cachedFrame( stadium,
+                        typeid( DispSender ),
+                        typeid( ser ),
+                        [&]( std::ostream & os )
+                        {
+                            ser.serializeBall( os, stadium.ball() );
+
+                            for ( Stadium::PlayerCont::const_reference p : stadium.players() )
+                            {
+                                ser.serializePlayerBegin( os, *p );
+                                ser.serializePlayerPos( os, *p );
+                                ser.serializePlayerArm( os, *p );
+                                ser.serializePlayerViewMode( os, *p );
+                                ser.serializePlayerFocusPoint( os, *p );
+                                ser.serializePlayerStamina( os, *p );
+                                ser.serializePlayerFocus( os, *p );
+                                ser.serializePlayerCounts( os, *p );
+                                ser.serializePlayerEnd( os );
+                            }
+                        } );
+}
+
 /*!
 //===================================================================
 //
@@ -122,25 +206,23 @@ DispSenderMonitorV1::~DispSenderMonitorV1()
 void
 DispSenderMonitorV1::sendShow()
 {
-    static dispinfo_t dinfo;
-    static int last_sent_time = -1;
-    static int last_sent_stoppage_time = -1;
-
-    //
-    // send cached data
-    //
-
-    if ( stadium().time() == last_sent_time
-         && stadium().stoppageTime() == last_sent_stoppage_time )
-    {
-        transport().write( reinterpret_cast< char * >( &dinfo ),
-                           sizeof( dispinfo_t ) );
-        transport().flush();
-        return;
-    }
+    const std::string & data = cachedFrame( stadium(),
+                                            typeid( *this ),
+                                            typeid( serializer() ),
+                                            [this]( std::ostream & os )
+                                            {
+                                                serializeShow( os );
+                                            } );
+
+    transport().write( data.data(), data.size() );
+    transport().flush();
+}
 
-    last_sent_time = stadium().time();
-    last_sent_stoppage_time = stadium().stoppageTime();
+void
+DispSenderMonitorV1::serializeShow( std::ostream & os ) const
+{
+    dispinfo_t dinfo;
+    std::memset( &dinfo, 0, sizeof( dispinfo_t ) );
 
     //
     // show mode
@@ -217,9 +299,8 @@ DispSenderMonitorV1::sendShow()
     // write to stream
     //
 
-    transport().write( reinterpret_cast< char * >( &dinfo ),
-                       sizeof( dispinfo_t ) );
-    transport().flush();
+    os.write( reinterpret_cast< char * >( &dinfo ),
+              sizeof( dispinfo_t ) );
 }
 
 void
@@ -283,25 +364,23 @@ DispSenderMonitorV2::~DispSenderMonitorV2()
 void
 DispSenderMonitorV2::sendShow()
 {
-    static dispinfo_t2 dinfo;
-    static int last_sent_time = -1;
-    static int last_sent_stoppage_time = -1;
-
-    //
-    // send cached data
-    //
-
-    if ( stadium().time() == last_sent_time
-         && stadium().stoppageTime() == last_sent_stoppage_time )
-    {
-        transport().write( reinterpret_cast< char * >( &dinfo ),
-                           sizeof( dispinfo_t2 ) );
-        transport().flush();
-        return;
-    }
+    const std::string & data = cachedFrame( stadium(),
+                                            typeid( *this ),
+                                            typeid( serializer() ),
+                                            [this]( std::ostream & os )
+                                            {
+                                                serializeShow( os );
+                                            } );
+
+    transport().write( data.data(), data.size() );
+    transport().flush();
+}
 
-    last_sent_time = stadium().time();
-    last_sent_stoppage_time = stadium().stoppageTime();
+void
+DispSenderMonitorV2::serializeShow( std::ostream & os ) const
+{
+    dispinfo_t2 dinfo;
+    std::memset( &dinfo, 0, sizeof( dispinfo_t2 ) );
 
     //
     // show mode
@@ -399,9 +478,8 @@ DispSenderMonitorV2::sendShow()
     // write to stream
     //
 
-    transport().write( reinterpret_cast< char * >( &dinfo ),
-                       sizeof( dispinfo_t2 ) );
-    transport().flush();
+    os.write( reinterpret_cast< char * >( &dinfo ),
+              sizeof( dispinfo_t2 ) );
 }
 
 void
@@ -442,62 +520,33 @@ DispSenderMonitorV3::~DispSenderMonitorV3()
 void
 DispSenderMonitorV3::sendShow()
 {
-    static std::string message;
-    static int last_sent_time = -1;
-    static int last_sent_stoppage_time = -1;
-
-    //
-    // send cached data
-    //
-
-    if ( stadium().time() == last_sent_time
-         && stadium().stoppageTime() == last_sent_stoppage_time )
-    {
-        transport() << message << std::ends << std::flush;
-        return;
-    }
-
-    last_sent_time = stadium().time();
-    last_sent_stoppage_time = stadium().stoppageTime();
-
-    message.clear();
-
-    //
-    // create new data
-    //
-
-    std::ostringstream ostr;
+    const std::string & data = cachedFrame( stadium(),
+                                            typeid( *this ),
+                                            typeid( serializer() ),
+                                            [this]( std::ostream & os )
+                                            {
+                                                serializeShow( os );
+                                            } );
+
+    transport() << data << std::ends << std::flush;
+}
 
-    serializer().serializeShowBegin( ostr,
+void
+DispSenderMonitorV3::serializeShow( std::ostream & os ) const
+{
+    serializer().serializeShowBegin( os,
                                      stadium().time(), stadium().stoppageTime() );
-    serializer().serializePlayModeId( ostr,
+    serializer().serializePlayModeId( os,
                                       stadium().playmode() );
-    serializer().serializeScore( ostr,
+    serializer().serializeScore( os,
                                  stadium().teamLeft(),
                                  stadium().teamRight() );
 
-    serializer().serializeBall( ostr,
-                                stadium().ball() );
-
-    serializer().serializePlayerArrayBegin( ostr );
-    for ( Stadium::PlayerCont::const_reference p : stadium().players() )
-    {
-        serializer().serializePlayerBegin( ostr, *p );
-        serializer().serializePlayerPos( ostr, *p );
-        serializer().serializePlayerArm( ostr, *p );
-        serializer().serializePlayerViewMode( ostr, *p );
-        serializer().serializePlayerFocusPoint( ostr, *p );
-        serializer().serializePlayerStamina( ostr, *p );
-        serializer().serializePlayerFocus( ostr, *p );
-        serializer().serializePlayerCounts( ostr, *p );
-        serializer().serializePlayerEnd( ostr );
-    }
-    serializer().serializePlayerArrayEnd( ostr );
-
-    serializer().serializeShowEnd( ostr );
+    // the player array delimiters are empty in the S-expression
+    // format, so the body is shared with the game log.
+    os << cachedShowBody( serializer(), stadium() );
 
-    message = ostr.str();
-    transport() << message << std::ends << std::flush;
+    serializer().serializeShowEnd( os );
 }
 
 void
@@ -537,32 +586,20 @@ DispSenderMonitorJSON::~DispSenderMonitorJSON()
 void
 DispSenderMonitorJSON::sendShow()
 {
-    static std::string message;
-    static int last_sent_time = -1;
-    static int last_sent_stoppage_time = -1;
-
-    //
-    // send cached data
-    //
-
-    if ( stadium().time() == last_sent_time
-         && stadium().stoppageTime() == last_sent_stoppage_time )
-    {
-        transport() << message << std::ends << std::flush;
-        return;
-    }
-
-    last_sent_time = stadium().time();
-    last_sent_stoppage_time = stadium().stoppageTime();
-
-    message.clear();
-
-    //
-    // create new data
-    //
-
-    std::ostringstream ostr;
+    const std::string & data = cachedFrame( stadium(),
+                                            typeid( *this ),
+                                            typeid( serializer() ),
+                                            [this]( std::ostream & os )
+                                            {
+                                                serializeShow( os );
+                                            } );
+
+    transport() << data << std::ends << std::flush;
+}
 
+void
+DispSenderMonitorJSON::serializeShow( std::ostream & ostr ) const
+{
     serializer().serializeShowBegin( ostr,
                                      stadium().time(), stadium().stoppageTime() );
     ostr << ',';
@@ -595,9 +632,6 @@ DispSenderMonitorJSON::sendShow()
     serializer().serializePlayerArrayEnd( ostr );
 
     serializer().serializeShowEnd( ostr );
-
-    message = ostr.str();
-    transport() << message << std::ends << std::flush;
 }
 
 void
@@ -1004,21 +1038,7 @@ DispSenderLoggerV4::sendShow()
     serializer().serializeShowBegin( transport(),
                                      stadium().time(), stadium().stoppageTime() );
 
-    serializer().serializeBall( transport(),
-                                stadium().ball() );
-
-    for ( Stadium::PlayerCont::const_reference p : stadium().players() )
-    {
-        serializer().serializePlayerBegin( transport(), *p );
-        serializer().serializePlayerPos( transport(), *p );
-        serializer().serializePlayerArm( transport(), *p );
-        serializer().serializePlayerViewMode( transport(), *p );
-        serializer().serializePlayerFocusPoint( transport(), *p );
-        serializer().serializePlayerStamina( transport(), *p );
-        serializer().serializePlayerFocus( transport(), *p );
-        serializer().serializePlayerCounts( transport(), *p );
-        serializer().serializePlayerEnd( transport() );
-    }
+    transport() << cachedShowBody( serializer(), stadium() );
 
     serializer().serializeShowEnd( transport() );
 
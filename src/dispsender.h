@@ -28,7 +28,10 @@
 
 #include <rcss/factory.hpp>
 
+#include <functional>
 #include <memory>
+#include <string>
+#include <typeinfo>
 
 class Stadium;
 class Logger;
@@ -53,6 +56,34 @@ public:
     virtual
     ~DispSender() override;
 
+    /*!
+      \brief start a new display frame. The serialized show data is
+      cached for the current frame and shared between all senders of
+      the same format.
+    */
+    static
+    void newFrame();
+
+protected:
+
+    /*!
+      \brief get the data serialized by \p build for the current
+      frame. \p build is only called by the first sender of the frame
+      and writes into the step arena of \p stadium.
+    */
+    static
+    const std::string & cachedFrame( const Stadium & stadium,
+                                     const std::type_info & format,
+                                     const std::type_info & serializer,
+                                     const std::function< void( std::ostream & ) > & build );
+
+    //! the ball and player part of the S-expression show message
+    static
+    const std::string & cachedShowBody( const SerializerMonitor & ser,
+                                        const Stadium & stadium );
+
+public:
+
     virtual
     void sendShow() = 0;
 
@@ -210,6 +241,10 @@ public:
     void sendTeamGraphic( const Side side,
                           const unsigned int x,
                           const unsigned int y ) override;
+
+protected:
+
+    void serializeShow( std::ostream & os ) const;
 };
 
 
@@ -237,6 +272,10 @@ public:
     //void sendTeamGraphic( const Side side,
     //                      const unsigned int x,
     //                      const unsigned int y );
+
+protected:
+
+    void serializeShow( std::ostream & os ) const;
 };
 
 /*!
@@ -263,6 +302,10 @@ public:
     //void sendTeamGraphic( const Side side,
     //                      const unsigned int x,
     //                      const unsigned int y );
+
+protected:
+
+    void serializeShow( std::ostream & os ) const;
 };
 
 
@@ -316,6 +359,10 @@ public:
     void sendTeamGraphic( const Side side,
                          const unsigned int x,
                          const unsigned int y ) override;
+
+protected:
+
+    void serializeShow( std::ostream & os ) const;
 };
 
 
@@ -30,6 +30,11 @@
 #include "serializer.h"
 #include "team.h"
 
+#include <map>
+#include <ostream>
+#include <tuple>
+#include <typeindex>
+
 namespace rcss {
 
 /*!
@@ -84,6 +89,66 @@ FullStateSenderPlayer::~FullStateSenderPlayer()
     //std::cerr << "delete FullStateSenderPlayer" << std::endl;
 }
 
+namespace {
+
+/*!
+  The cached parts depend on the sender class, the serializer class
+  and the receiver's side (the score is sent from its point of view).
+*/
+struct FullStatePart {
+    unsigned long cycle_;
+    std::string data_;
+
+    FullStatePart()
+        : cycle_( 0 )
+      { }
+};
+
+typedef std::tuple< std::type_index, // sender
+                    std::type_index, // serializer
+                    int,             // side
+                    int              // part
+                    > FullStateKey;
+
+typedef std::map< FullStateKey, FullStatePart > FullStateCache;
+
+unsigned long g_cycle = 1;
+
+FullStateCache &
+full_state_cache()
+{
+    static FullStateCache s_cache;
+    return s_cache;
+}
+
+}
+
+void
+FullStateSenderPlayer::newCycle()
+{
+    ++g_cycle;
+}
+
+const std::string &
+FullStateSenderPlayer::cachedPart( const Part part,
+                                   const std::function< void( std::ostream & ) > & build ) const
+{
+    FullStatePart & entry = full_state_cache()[ FullStateKey( std::type_index( typeid( *this ) ),
+                                                              std::type_index( typeid( serializer() ) ),
+                                                              self().side(),
+                                                              part ) ];
+    if ( entry.cycle_ != g_cycle )
+    {
+        rcss::ArenaStreamBuf buf( stadium().cycleArena() );
+        std::ostream os( &buf );
+        build( os );
+        entry.data_.assign( buf.data(), buf.size() );
+        entry.cycle_ = g_cycle;
+    }
+
+    return entry.data_;
+}
+
 
 /*!
 //===================================================================
@@ -144,25 +209,31 @@ FullStateSenderPlayerV5::sendFullState()
     static const char * playmode_string[] = PLAYMODE_STRINGS;
 
     // send begining of FS
-    serializer().serializeFSBegin( transport(), stadium().time() );
-
-    if ( stadium().playmode() == PM_FreeKick_Left
-         && stadium().ballCatcher() )
-    {
-        serializer().serializeFSPlayMode( transport(),
-                                          "goalie_catch_ball_l" );
-    }
-    else if ( stadium().playmode() == PM_FreeKick_Right
-              && stadium().ballCatcher() )
-    {
-        serializer().serializeFSPlayMode( transport(),
-                                          "goalie_catch_ball_r" );
-    }
-    else
-    {
-        serializer().serializeFSPlayMode( transport(),
-                                          playmode_string[stadium().playmode()] );
-    }
+    const std::string & head
+        = cachedPart( HEAD,
+                      [this]( std::ostream & os )
+                      {
+                          serializer().serializeFSBegin( os, stadium().time() );
+
+                          if ( stadium().playmode() == PM_FreeKick_Left
+                               && stadium().ballCatcher() )
+                          {
+                              serializer().serializeFSPlayMode( os,
+                                                                "goalie_catch_ball_l" );
+                          }
+                          else if ( stadium().playmode() == PM_FreeKick_Right
+                                    && stadium().ballCatcher() )
+                          {
+                              serializer().serializeFSPlayMode( os,
+                                                                "goalie_catch_ball_r" );
+                          }
+                          else
+                          {
+                              serializer().serializeFSPlayMode( os,
+                                                                playmode_string[stadium().playmode()] );
+                          }
+                      } );
+    transport() << head;
 
     serializer().serializeFSViewMode( transport(),
                                       ( self().highQuality()
@@ -176,19 +247,25 @@ FullStateSenderPlayerV5::sendFullState()
 
     sendSelf();
 
-    sendScore();
+    const std::string & body
+        = cachedPart( BODY,
+                      [this]( std::ostream & os )
+                      {
+                          sendScore( os );
 
-    sendBall();
+                          sendBall( os );
 
-    for ( Stadium::PlayerCont::const_reference p : stadium().players() )
-    {
-        if ( ! p->isEnabled() ) continue;
+                          for ( Stadium::PlayerCont::const_reference p : stadium().players() )
+                          {
+                              if ( ! p->isEnabled() ) continue;
 
-        sendPlayer( *p );
-    }
+                              sendPlayer( os, *p );
+                          }
 
-    // send end of FS
-    serializer().serializeFSEnd( transport() );
+                          // send end of FS
+                          serializer().serializeFSEnd( os );
+                      } );
+    transport() << body;
 
     transport() << std::ends << std::flush;
 }
@@ -200,7 +277,7 @@ FullStateSenderPlayerV5::sendSelf()
 }
 
 void
-FullStateSenderPlayerV5::sendScore()
+FullStateSenderPlayerV5::sendScore( std::ostream & os )
 {
     int left = 0, right = 0;
     if ( stadium().teamLeft().enabled() )
@@ -213,16 +290,16 @@ FullStateSenderPlayerV5::sendScore()
         left = stadium().teamRight().point();
     }
 
-    serializer().serializeFSScore( transport(),
+    serializer().serializeFSScore( os,
                                    left,
                                    right );
 }
 
 void
-FullStateSenderPlayerV5::sendBall()
+FullStateSenderPlayerV5::sendBall( std::ostream & os )
 {
     const float quantize_step = .001;
-    serializer().serializeFSBall( transport(),
+    serializer().serializeFSBall( os,
                                   Quantize( stadium().ball().pos().x,
                                             quantize_step ),
                                   Quantize( stadium().ball().pos().y,
@@ -234,11 +311,12 @@ FullStateSenderPlayerV5::sendBall()
 }
 
 void
-FullStateSenderPlayerV5::sendPlayer( const Player & p )
+FullStateSenderPlayerV5::sendPlayer( std::ostream & os,
+                                     const Player & p )
 {
     const float quantize_step = .001;
     char side = ( p.side() == LEFT ? 'l' : 'r' );
-    serializer().serializeFSPlayerBegin( transport(),
+    serializer().serializeFSPlayerBegin( os,
                                          side,
                                          p.unum(),
                                          false, // goalie info not sent
@@ -255,12 +333,12 @@ FullStateSenderPlayerV5::sendPlayer( const Player & p )
                                                    quantize_step ),
                                          Quantize( Rad2Deg( p.angleNeckCommitted() ),
                                                    quantize_step ) ); //neck_angle
-    serializer().serializeFSPlayerStamina( transport(),
+    serializer().serializeFSPlayerStamina( os,
                                            int( p.stamina() ),
                                            Quantize( p.effort(), .0001 ),
                                            Quantize( p.recovery(), .0001 ),
                                            p.staminaCapacity() );
-    serializer().serializeFSPlayerEnd( transport() );
+    serializer().serializeFSPlayerEnd( os );
 }
 
 /*!
@@ -311,7 +389,7 @@ FullStateSenderPlayerV8::sendSelf()
 }
 
 void
-FullStateSenderPlayerV8::sendScore()
+FullStateSenderPlayerV8::sendScore( std::ostream & os )
 {
     int left = 0, right = 0;
     if ( stadium().teamLeft().enabled() )
@@ -329,15 +407,15 @@ FullStateSenderPlayerV8::sendScore()
         std::swap( left, right );
     }
 
-    serializer().serializeFSScore( transport(),
+    serializer().serializeFSScore( os,
                                    left,
                                    right );
 }
 
 void
-FullStateSenderPlayerV8::sendBall()
+FullStateSenderPlayerV8::sendBall( std::ostream & os )
 {
-    serializer().serializeFSBall( transport(),
+    serializer().serializeFSBall( os,
                                   stadium().ball().pos().x,
                                   stadium().ball().pos().y,
                                   stadium().ball().vel().x,
@@ -345,10 +423,11 @@ FullStateSenderPlayerV8::sendBall()
 }
 
 void
-FullStateSenderPlayerV8::sendPlayer( const Player & p )
+FullStateSenderPlayerV8::sendPlayer( std::ostream & os,
+                                     const Player & p )
 {
     char side = ( p.team()->side() == LEFT ? 'l' : 'r' );
-    serializer().serializeFSPlayerBegin( transport(),
+    serializer().serializeFSPlayerBegin( os,
                                          side,
                                          p.unum(),
                                          p.isGoalie(),
@@ -366,18 +445,18 @@ FullStateSenderPlayerV8::sendPlayer( const Player & p )
         p.arm().getRelDest( rcss::geom::Vector2D( p.pos().x, p.pos().y ),
                             p.angleBodyCommitted() + p.angleNeckCommitted(),
                             arm_vec );
-        serializer().serializeFSPlayerArm( transport(),
+        serializer().serializeFSPlayerArm( os,
                                            arm_vec.getMag(),
                                            arm_vec.getHead() );
     }
 
-    serializer().serializeFSPlayerStamina( transport(),
+    serializer().serializeFSPlayerStamina( os,
                                            p.stamina(),
                                            p.effort(),
                                            p.recovery(),
                                            p.staminaCapacity() );
 
-    serializer().serializeFSPlayerEnd( transport() );
+    serializer().serializeFSPlayerEnd( os );
 }
 
 
@@ -405,10 +484,11 @@ FullStateSenderPlayerV13::~FullStateSenderPlayerV13()
 
 
 void
-FullStateSenderPlayerV13::sendPlayer( const Player & p )
+FullStateSenderPlayerV13::sendPlayer( std::ostream & os,
+                                      const Player & p )
 {
     char side = ( p.team()->side() == LEFT ? 'l' : 'r' );
-    serializer().serializeFSPlayerBegin( transport(),
+    serializer().serializeFSPlayerBegin( os,
                                          side,
                                          p.unum(),
                                          p.isGoalie(),
@@ -426,20 +506,20 @@ FullStateSenderPlayerV13::sendPlayer( const Player & p )
         p.arm().getRelDest( rcss::geom::Vector2D( p.pos().x, p.pos().y ),
                             p.angleBodyCommitted() + p.angleNeckCommitted(),
                             arm_vec );
-        serializer().serializeFSPlayerArm( transport(),
+        serializer().serializeFSPlayerArm( os,
                                            arm_vec.getMag(),
                                            arm_vec.getHead() );
     }
 
-    serializer().serializeFSPlayerStamina( transport(),
+    serializer().serializeFSPlayerStamina( os,
                                            p.stamina(),
                                            p.effort(),
                                            p.recovery(),
                                            p.staminaCapacity() );
 
-    serializer().serializeFSPlayerState( transport(), p );
+    serializer().serializeFSPlayerState( os, p );
 
-    serializer().serializeFSPlayerEnd( transport() );
+    serializer().serializeFSPlayerEnd( os );
 }
 
 
@@ -467,10 +547,11 @@ FullStateSenderPlayerV18::FullStateSenderPlayerV18( const Params & params )
 
 
 void
-FullStateSenderPlayerV18::sendPlayer( const Player & p )
+FullStateSenderPlayerV18::sendPlayer( std::ostream & os,
+                                      const Player & p )
 {
     char side = ( p.team()->side() == LEFT ? 'l' : 'r' );
-    serializer().serializeFSPlayerBegin( transport(),
+    serializer().serializeFSPlayerBegin( os,
                                          side,
                                          p.unum(),
                                          p.isGoalie(),
@@ -488,22 +569,22 @@ FullStateSenderPlayerV18::sendPlayer( const Player & p )
         p.arm().getRelDest( rcss::geom::Vector2D( p.pos().x, p.pos().y ),
                             p.angleBodyCommitted() + p.angleNeckCommitted(),
                             arm_vec );
-        serializer().serializeFSPlayerArm( transport(),
+        serializer().serializeFSPlayerArm( os,
                                            arm_vec.getMag(),
                                            arm_vec.getHead() );
     }
 
-    serializer().serializeFSPlayerFocus( transport(), p );
+    serializer().serializeFSPlayerFocus( os, p );
 
-    serializer().serializeFSPlayerStamina( transport(),
+    serializer().serializeFSPlayerStamina( os,
                                            p.stamina(),
                                            p.effort(),
                                            p.recovery(),
                                            p.staminaCapacity() );
 
-    serializer().serializeFSPlayerState( transport(), p );
+    serializer().serializeFSPlayerState( os, p );
 
-    serializer().serializeFSPlayerEnd( transport() );
+    serializer().serializeFSPlayerEnd( os );
 }
 
 /*!
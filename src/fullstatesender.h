@@ -28,7 +28,9 @@
 
 #include <rcss/factory.hpp>
 
+#include <functional>
 #include <memory>
+#include <string>
 
 class Stadium;
 class Player;
@@ -116,7 +118,24 @@ public:
     virtual
     ~FullStateSenderPlayer() override;
 
+    /*!
+      \brief start a new sensing cycle. The parts of the full state
+      message that do not depend on the receiver are serialized once
+      per cycle, side and protocol, and shared between the players.
+    */
+    static
+    void newCycle();
+
 protected:
+
+    enum Part {
+        HEAD,
+        BODY,
+    };
+
+    //! get the \p part of this cycle, calling \p build only for the first player
+    const std::string & cachedPart( const Part part,
+                                    const std::function< void( std::ostream & ) > & build ) const;
     const
     SerializerPlayer & serializer() const
       {
@@ -225,13 +244,14 @@ protected:
     void sendSelf();
 
     virtual
-    void sendScore();
+    void sendScore( std::ostream & os );
 
     virtual
-    void sendBall();
+    void sendBall( std::ostream & os );
 
     virtual
-    void sendPlayer( const Player & p );
+    void sendPlayer( std::ostream & os,
+                     const Player & p );
 };
 
 /*!
@@ -258,13 +278,14 @@ protected:
     void sendSelf() override;
 
     virtual
-    void sendScore() override;
+    void sendScore( std::ostream & os ) override;
 
     virtual
-    void sendBall() override;
+    void sendBall( std::ostream & os ) override;
 
     virtual
-    void sendPlayer( const Player & p ) override;
+    void sendPlayer( std::ostream & os,
+                     const Player & p ) override;
 };
 
 
@@ -291,7 +312,8 @@ public:
 protected:
 
     virtual
-    void sendPlayer( const Player & p ) override;
+    void sendPlayer( std::ostream & os,
+                     const Player & p ) override;
 };
 
 /*!
@@ -317,7 +339,8 @@ public:
 protected:
 
     virtual
-    void sendPlayer( const Player & p ) override;
+    void sendPlayer( std::ostream & os,
+                     const Player & p ) override;
 };
 
 
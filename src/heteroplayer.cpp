@@ -35,6 +35,7 @@
 
 #include "heteroplayer.h"
 
+#include "checkpoint.h"
 #include "serverparam.h"
 #include "playerparam.h"
 #include "utility.h"
@@ -273,6 +274,74 @@ HeteroPlayer::setDefaultGaussianObservationParams()
     M_land_focus_dist_noise_rate = SP.landFocusDistNoiseRate();
 }
 
+void
+HeteroPlayer::saveState( rcss::CheckpointWriter & writer ) const
+{
+    writer.put( M_player_speed_max );
+    writer.put( M_stamina_inc_max );
+    writer.put( M_player_decay );
+    writer.put( M_inertia_moment );
+    writer.put( M_dash_power_rate );
+    writer.put( M_player_size );
+    writer.put( M_kickable_margin );
+    writer.put( M_kick_rand );
+    writer.put( M_extra_stamina );
+    writer.put( M_effort_max );
+    writer.put( M_effort_min );
+    writer.put( M_kick_power_rate );
+    writer.put( M_foul_detect_probability );
+    writer.put( M_catchable_area_l_stretch );
+    writer.put( M_unum_far_length );
+    writer.put( M_unum_too_far_length );
+    writer.put( M_team_far_length );
+    writer.put( M_team_too_far_length );
+    writer.put( M_player_max_observation_length );
+    writer.put( M_ball_vel_far_length );
+    writer.put( M_ball_vel_too_far_length );
+    writer.put( M_ball_max_observation_length );
+    writer.put( M_land_vel_far_length );
+    writer.put( M_land_vel_too_far_length );
+    writer.put( M_flag_max_observation_length );
+    writer.put( M_dist_noise_rate );
+    writer.put( M_focus_dist_noise_rate );
+    writer.put( M_land_dist_noise_rate );
+    writer.put( M_land_focus_dist_noise_rate );
+}
+
+void
+HeteroPlayer::loadState( rcss::CheckpointReader & reader )
+{
+    reader.get( M_player_speed_max );
+    reader.get( M_stamina_inc_max );
+    reader.get( M_player_decay );
+    reader.get( M_inertia_moment );
+    reader.get( M_dash_power_rate );
+    reader.get( M_player_size );
+    reader.get( M_kickable_margin );
+    reader.get( M_kick_rand );
+    reader.get( M_extra_stamina );
+    reader.get( M_effort_max );
+    reader.get( M_effort_min );
+    reader.get( M_kick_power_rate );
+    reader.get( M_foul_detect_probability );
+    reader.get( M_catchable_area_l_stretch );
+    reader.get( M_unum_far_length );
+    reader.get( M_unum_too_far_length );
+    reader.get( M_team_far_length );
+    reader.get( M_team_too_far_length );
+    reader.get( M_player_max_observation_length );
+    reader.get( M_ball_vel_far_length );
+    reader.get( M_ball_vel_too_far_length );
+    reader.get( M_ball_max_observation_length );
+    reader.get( M_land_vel_far_length );
+    reader.get( M_land_vel_too_far_length );
+    reader.get( M_flag_max_observation_length );
+    reader.get( M_dist_noise_rate );
+    reader.get( M_focus_dist_noise_rate );
+    reader.get( M_land_dist_noise_rate );
+    reader.get( M_land_focus_dist_noise_rate );
+}
+
 std::ostream &
 HeteroPlayer::print( std::ostream & o ) const
 {
@@ -36,6 +36,11 @@
 
 #include <iostream>
 
+namespace rcss {
+class CheckpointWriter;
+class CheckpointReader;
+}
+
 class HeteroPlayer {
 public:
     HeteroPlayer();
@@ -83,6 +88,10 @@ public:
                           const unsigned int version ) const;
     void printParamsJSON( std::ostream & o,
                           const unsigned int version ) const;
+
+    //! writes the parameters for a checkpoint
+    void saveState( rcss::CheckpointWriter & writer ) const;
+    void loadState( rcss::CheckpointReader & reader );
 private:
 
     double delta( const double & min,
@@ -0,0 +1,225 @@
+// -*-c++-*-
+
+/***************************************************************************
+                               hfofeatures.cpp
+                  Feature vector observations for HFO agents
+                             -------------------
+    begin                : 2026-10-18
+    copyright            : (C) 2026 by The RoboCup Soccer Server
+                           Maintenance Group.
+    email                : sserver-admin@lists.sourceforge.net
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU LGPL as published by the Free Software  *
+ *   Foundation; either version 3 of the License, or (at your option) any  *
+ *   later version.                                                        *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "hfofeatures.h"
+
+#include "binaryprotocol.h"
+#include "noisyobservation.h"
+#include "player.h"
+#include "serverparam.h"
+#include "stadium.h"
+#include "utility.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace rcss {
+
+namespace {
+
+/*!
+  \brief the widest angle between top and bottom, seen from \p from,
+  that is not covered by one of \p blockers.
+  \return the angle in degrees
+*/
+double
+open_angle( const PVector & from,
+            const PVector & top,
+            const PVector & bottom,
+            const std::vector< PVector > & blockers )
+{
+    const PVector center = ( top + bottom ) /= 2.0;
+    const double center_dir = ( center - from ).th();
+    const double range = from.distance( center );
+
+    double lo = normalize_angle( ( top - from ).th() - center_dir );
+    double hi = normalize_angle( ( bottom - from ).th() - center_dir );
+    if ( lo > hi ) std::swap( lo, hi );
+
+    double angles[16];
+    int n = 0;
+    angles[n++] = lo;
+    angles[n++] = hi;
+    for ( const PVector & b : blockers )
+    {
+        if ( n >= 16 ) break;
+        if ( from.distance( b ) > range ) continue;
+
+        const double a = normalize_angle( ( b - from ).th() - center_dir );
+        if ( lo < a && a < hi )
+        {
+            angles[n++] = a;
+        }
+    }
+    std::sort( angles, angles + n );
+
+    double widest = 0.0;
+    for ( int i = 1; i < n; ++i )
+    {
+        widest = std::max( widest, angles[i] - angles[i-1] );
+    }
+    return Rad2Deg( widest );
+}
+
+}
+
+HFOFeatures::HFOFeatures( const Stadium & stadium )
+    : M_stadium( stadium )
+{
+    for ( const Player * p : stadium.players() )
+    {
+        if ( p->isEnabled() )
+        {
+            M_players.push_back( p );
+        }
+    }
+
+    std::sort( M_players.begin(), M_players.end(),
+               []( const Player * lhs, const Player * rhs )
+               {
+                   return lhs->unum() < rhs->unum();
+               } );
+
+    M_opponents.reserve( M_players.size() );
+}
+
+void
+HFOFeatures::compute( const Player & self,
+                      std::vector< float > & features ) const
+{
+    const ServerParam & param = ServerParam::instance();
+
+    features.assign( binary::HFO_FEATURE_SIZE, 0.0f );
+
+    const QuantizeObservation quantize_observation( self );
+    const GaussianObservation gaussian_observation( self );
+    const NoisyObservation & observation
+        = ( self.isGaussianSee()
+            ? static_cast< const NoisyObservation & >( gaussian_observation )
+            : static_cast< const NoisyObservation & >( quantize_observation ) );
+    const PVector focus_point = self.focusPoint();
+    const double body = self.angleBodyCommitted();
+
+    // observed distance and direction in degrees relative to the body,
+    // and the position they imply.
+    auto observe = [&]( const PVector & pos,
+                        const bool landmark,
+                        double * dist,
+                        double * dir,
+                        PVector * observed_pos )
+        {
+            const double actual_dist = self.pos().distance( pos );
+            const double focus_dist = pos.distance( focus_point );
+            *dist = ( landmark
+                      ? observation.calcDistLandmark( actual_dist, focus_dist )
+                      : observation.calcDist( actual_dist, focus_dist ) );
+            *dir = Rad2IDegRound( normalize_angle( ( pos - self.pos() ).th() - body ) );
+            if ( observed_pos )
+            {
+                *observed_pos = self.pos() + PVector::fromPolar( *dist, body + Deg2Rad( *dir ) );
+            }
+        };
+
+    features[binary::HFO_SELF_X] = self.pos().x;
+    features[binary::HFO_SELF_Y] = self.pos().y;
+    features[binary::HFO_SELF_BODY] = Rad2Deg( body );
+    features[binary::HFO_SELF_NECK] = Rad2Deg( self.angleNeckCommitted() );
+    features[binary::HFO_SELF_STAMINA] = self.stamina() / param.staminaMax();
+    features[binary::HFO_KICKABLE] = self.ballKickable() ? 1.0f : 0.0f;
+
+    double dist = 0.0, dir = 0.0;
+
+    observe( M_stadium.ball().pos(), false, &dist, &dir, nullptr );
+    features[binary::HFO_BALL_DIST] = dist;
+    features[binary::HFO_BALL_DIR] = dir;
+
+    const PVector goal( ServerParam::PITCH_LENGTH * 0.5, 0.0 );
+    const PVector goal_top( goal.x, -param.goalWidth() * 0.5 );
+    const PVector goal_bottom( goal.x, param.goalWidth() * 0.5 );
+
+    observe( goal, true, &dist, &dir, nullptr );
+    features[binary::HFO_GOAL_DIST] = dist;
+    features[binary::HFO_GOAL_DIR] = dir;
+
+    //
+    // opponents
+    //
+    M_opponents.clear();
+    double nearest = -1.0;
+    int slot = 0;
+    for ( const Player * p : M_players )
+    {
+        if ( p->side() == self.side() ) continue;
+
+        PVector pos;
+        observe( p->pos(), false, &dist, &dir, &pos );
+        M_opponents.push_back( pos );
+        if ( nearest < 0.0 || dist < nearest ) nearest = dist;
+
+        if ( slot < 11 )
+        {
+            const int i = binary::HFO_OPPONENTS + slot * binary::HFO_OPPONENT_SIZE;
+            features[i + binary::HFO_OPPONENT_UNUM] = p->unum();
+            features[i + binary::HFO_OPPONENT_DIST] = dist;
+            features[i + binary::HFO_OPPONENT_DIR] = dir;
+            ++slot;
+        }
+    }
+
+    features[binary::HFO_NEAREST_OPPONENT_DIST] = nearest;
+    features[binary::HFO_GOAL_OPEN_ANGLE] = open_angle( self.pos(), goal_top, goal_bottom, M_opponents );
+
+    //
+    // teammates
+    //
+    slot = 0;
+    for ( const Player * p : M_players )
+    {
+        if ( slot >= 10 ) break;
+        if ( p->side() != self.side() || p == &self ) continue;
+
+        PVector pos;
+        observe( p->pos(), false, &dist, &dir, &pos );
+
+        double pass_angle = 180.0;
+        for ( const PVector & o : M_opponents )
+        {
+            if ( self.pos().distance( o ) >= dist ) continue;
+            const double a = std::fabs( Rad2Deg( normalize_angle( ( o - self.pos() ).th()
+                                                                  - ( pos - self.pos() ).th() ) ) );
+            pass_angle = std::min( pass_angle, a );
+        }
+
+        const int i = binary::HFO_TEAMMATES + slot * binary::HFO_TEAMMATE_SIZE;
+        features[i + binary::HFO_TEAMMATE_UNUM] = p->unum();
+        features[i + binary::HFO_TEAMMATE_DIST] = dist;
+        features[i + binary::HFO_TEAMMATE_DIR] = dir;
+        features[i + binary::HFO_TEAMMATE_GOAL_OPEN_ANGLE] = open_angle( pos, goal_top, goal_bottom, M_opponents );
+        features[i + binary::HFO_TEAMMATE_PASS_OPEN_ANGLE] = pass_angle;
+        ++slot;
+    }
+}
+
+}
@@ -0,0 +1,64 @@
+// -*-c++-*-
+
+/***************************************************************************
+                                hfofeatures.h
+                  Feature vector observations for HFO agents
+                             -------------------
+    begin                : 2026-10-18
+    copyright            : (C) 2026 by The RoboCup Soccer Server
+                           Maintenance Group.
+    email                : sserver-admin@lists.sourceforge.net
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU LGPL as published by the Free Software  *
+ *   Foundation; either version 3 of the License, or (at your option) any  *
+ *   later version.                                                        *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef RCSS_HFOFEATURES_H
+#define RCSS_HFOFEATURES_H
+
+#include "object.h"
+
+#include <vector>
+
+class Player;
+class Stadium;
+
+namespace rcss {
+
+/*!
+  \class HFOFeatures
+  \brief computes the feature vectors described by
+  rcss::binary::HFOFeature.
+
+  The constructor collects the players once in a cycle, and compute()
+  is called for each agent with the same instance.
+*/
+class HFOFeatures {
+private:
+    const Stadium & M_stadium;
+    std::vector< const Player * > M_players; //!< enabled players sorted by unum
+
+    // work area reused between agents
+    mutable std::vector< PVector > M_opponents;
+
+    // not used
+    HFOFeatures( const HFOFeatures & ) = delete;
+    HFOFeatures & operator=( const HFOFeatures & ) = delete;
+
+public:
+    explicit
+    HFOFeatures( const Stadium & stadium );
+
+    void compute( const Player & self,
+                  std::vector< float > & features ) const;
+};
+
+}
+
+#endif
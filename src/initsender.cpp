@@ -31,8 +31,99 @@
 #include "playerparam.h"
 #include "heteroplayer.h"
 
+#include <map>
+#include <sstream>
+#include <tuple>
+#include <typeindex>
+
 namespace rcss {
 
+namespace {
+
+/*!
+  The serialized messages only depend on the concrete sender and
+  serializer classes, the protocol version and the log/network
+  framing, so clients sharing these share the cached bytes.
+*/
+typedef std::tuple< std::type_index, // sender
+                    std::type_index, // serializer
+                    unsigned int,    // version
+                    bool,            // game log
+                    int              // message kind
+                    > InitCacheKey;
+
+typedef std::map< InitCacheKey, InitSenderCommon::Messages > InitCache;
+
+InitCache &
+init_cache()
+{
+    static InitCache s_cache;
+    return s_cache;
+}
+
+}
+
+/*
+//===================================================================
+//
+//  CLASS: InitSenderCommon
+//
+//===================================================================
+*/
+
+void
+InitSenderCommon::clearCache()
+{
+    init_cache().clear();
+}
+
+void
+InitSenderCommon::endMessage( std::ostream & os )
+{
+    if ( isGameLog() )
+    {
+        os << '\n';
+    }
+    else
+    {
+        os << std::ends;
+    }
+}
+
+void
+InitSenderCommon::send( const MessageKind kind )
+{
+    const InitCacheKey key( std::type_index( typeid( *this ) ),
+                            std::type_index( typeid( serializer() ) ),
+                            version(),
+                            isGameLog(),
+                            kind );
+
+    InitCache::iterator it = init_cache().find( key );
+    if ( it == init_cache().end() )
+    {
+        Messages msgs;
+        switch ( kind ) {
+        case SERVER_PARAMS:
+            serializeServerParams( msgs );
+            break;
+        case PLAYER_PARAMS:
+            serializePlayerParams( msgs );
+            break;
+        case PLAYER_TYPES:
+            serializePlayerTypes( msgs );
+            break;
+        }
+        it = init_cache().insert( InitCache::value_type( key, msgs ) ).first;
+    }
+
+    for ( const std::string & msg : it->second )
+    {
+        transport().write( msg.data(), msg.size() );
+        transport() << std::flush;
+    }
+}
+
 /*
 //===================================================================
 //
@@ -64,364 +155,351 @@ InitSender::~InitSender()
 */
 
 void
-InitSenderCommonV7::sendServerParams()
+InitSenderCommonV7::serializeServerParams( Messages & msgs )
 {
-    serializer().serializeServerParamBegin( transport() );
-    serializer().serializeParam( transport(),
+    std::ostringstream os;
+    serializer().serializeServerParamBegin( os );
+    serializer().serializeParam( os,
                                  ServerParam::instance().goalWidth() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().inertiaMoment() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().playerSize() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().playerDecay() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().playerRand() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().playerWeight() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().playerSpeedMax() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().playerAccelMax() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().staminaMax() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().staminaInc() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().recoverInit() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().recoverDecThr() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().recoverMin() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().recoverDec() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().effortInit() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().effortDecThr() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().effortMin() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().effortDec() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().effortIncThr() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().effortInc() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().kickRand() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().teamActuatorNoise() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().playerRandFactorLeft() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().playerRandFactorRight() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().kickRandFactorLeft() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().kickRandFactorRight() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().ballSize() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().ballDecay() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().ballRand() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().ballWeight() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().ballSpeedMax() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().ballAccelMax() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().dashPowerRate() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().kickPowerRate() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().kickableMargin() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().controlRadius() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().controlRadiusWidth() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().maxPower() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().minPower() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().maxMoment() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().minMoment() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().maxNeckMoment() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().minNeckMoment() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().maxNeckAngle() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().minNeckAngle() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().visibleAngleDegree() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().visibleDistance() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().windDir() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().windForce() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().windAngle() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().windRand() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().kickableArea() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().catchAreaLength() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().catchAreaWidth() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().catchProbability() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().goalieMaxMoves() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().cornerKickMargin() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().offsideActiveArea() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().windNone() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().windRandom() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().freeformCountMax() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().freeformMsgSize() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().clangWinSize() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().clangDefineWin() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().clangMetaWin() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().clangAdviceWin() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().clangInfoWin() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().clangMessDelay() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().clangMessPerCycle() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().halfTime() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().simStep() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().sendStep() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().recvStep() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().senseBodyStep() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().lcmStep() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().sayMsgSize() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().hearMax() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().hearInc() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().hearDecay() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().catchBanCycle() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().slowDownFactor() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().useOffside() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().kickOffOffside() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().offsideKickMargin() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().audioCutDist() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().quantizeStep() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().landmarkQuantizeStep() );
 #ifdef NEW_QSTEP
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().dirQStep() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().distQStepLeft() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().distQStepRight() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().landQStepLeft() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().landQStepRight() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().dirQStepLeft() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().dirQStepRight() );
 #else
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  -1 );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  -1 );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  -1 );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  -1 );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  -1 );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  -1 );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  -1 );
 #endif
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().coachMode() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().coachWithRefereeMode() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().coachOldHear() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().coachVisualStep() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().startGoalLeft() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().startGoalRight() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().fullstateLeft() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().fullstateRight() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  ServerParam::instance().dropTime() );
-    serializer().serializeServerParamEnd( transport() );
-    if ( isGameLog() )
-    {
-        transport() << std::endl;
-    }
-    else
-    {
-        transport() << std::ends << std::flush;
-    }
+    serializer().serializeServerParamEnd( os );
+    endMessage( os );
+    msgs.push_back( os.str() );
 }
 
 void
-InitSenderCommonV7::sendPlayerParams()
+InitSenderCommonV7::serializePlayerParams( Messages & msgs )
 {
-    serializer().serializePlayerParamBegin( transport() );
-    serializer().serializeParam( transport(),
+    std::ostringstream os;
+    serializer().serializePlayerParamBegin( os );
+    serializer().serializeParam( os,
                                  PlayerParam::instance().playerTypes() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  PlayerParam::instance().subsMax() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  PlayerParam::instance().ptMax() );
 
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  PlayerParam::instance().playerSpeedMaxDeltaMin() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  PlayerParam::instance().playerSpeedMaxDeltaMax() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  PlayerParam::instance().staminaIncMaxDeltaFactor() );
 
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  PlayerParam::instance().playerDecayDeltaMin() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  PlayerParam::instance().playerDecayDeltaMax() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  PlayerParam::instance().inertiaMomentDeltaFactor() );
 
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  PlayerParam::instance().dashPowerRateDeltaMin() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  PlayerParam::instance().dashPowerRateDeltaMax() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  PlayerParam::instance().playerSizeDeltaFactor() );
 
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  PlayerParam::instance().kickableMarginDeltaMin() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  PlayerParam::instance().kickableMarginDeltaMax() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  PlayerParam::instance().kickRandDeltaFactor() );
 
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  PlayerParam::instance().extraStaminaDeltaMin() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  PlayerParam::instance().extraStaminaDeltaMax() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  PlayerParam::instance().effortMaxDeltaFactor() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  PlayerParam::instance().effortMinDeltaFactor() );
-    serializer().serializePlayerParamEnd( transport() );
-    if ( isGameLog() )
-    {
-        transport() << std::endl;
-    }
-    else
-    {
-        transport() << std::ends << std::flush;
-    }
+    serializer().serializePlayerParamEnd( os );
+    endMessage( os );
+    msgs.push_back( os.str() );
 }
 
 void
-InitSenderCommonV7::sendPlayerTypes()
+InitSenderCommonV7::serializePlayerTypes( Messages & msgs )
 {
     for ( int i = 0; i < PlayerParam::instance().playerTypes(); ++i )
     {
         const HeteroPlayer * type = stadium().playerType( i );
         if ( type )
         {
-            serializer().serializePlayerTypeBegin( transport(), i );
+            std::ostringstream os;
+            serializer().serializePlayerTypeBegin( os, i );
 
-            serializePlayerType( *type );
+            serializePlayerType( os, *type );
 
-            serializer().serializePlayerTypeEnd( transport() );
-            if ( isGameLog() )
-            {
-                transport() << std::endl;
-            }
-            else
-            {
-                transport() << std::ends << std::flush;
-            }
+            serializer().serializePlayerTypeEnd( os );
+            endMessage( os );
+            msgs.push_back( os.str() );
         }
     }
 }
 
 void
-InitSenderCommonV7::serializePlayerType( const HeteroPlayer & type )
+InitSenderCommonV7::serializePlayerType( std::ostream & os,
+                                         const HeteroPlayer & type )
 {
-    // serializer().serializeParam( transport(),
+    // serializer().serializeParam( os,
     //                              id );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  type.playerSpeedMax() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  type.staminaIncMax() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  type.playerDecay() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  type.inertiaMoment() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  type.dashPowerRate() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  type.playerSize() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  type.kickableMargin() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  type.kickRand() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  type.extraStamina() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  type.effortMax() );
-    serializer().serializeParam( transport(),
+    serializer().serializeParam( os,
                                  type.effortMin() );
 }
 
 //-------------------------------------
 
 void
-InitSenderCommonV8::sendServerParams()
+InitSenderCommonV8::serializeServerParams( Messages & msgs )
 {
-    serializer().serializeServerParamBegin( transport() );
+    std::ostringstream os;
+    serializer().serializeServerParamBegin( os );
     for ( ServerParam::VerMap::const_reference param : ServerParam::instance().verMap() )
     {
-        sendServerParam( param );
+        serializeServerParam( os, param );
     }
     // std::for_each( ServerParam::instance().verMap().begin(),
     //                ServerParam::instance().verMap().end(),
@@ -431,19 +509,14 @@ InitSenderCommonV8::sendServerParams()
     //                } );
     //                // std::bind1st( std::mem_fun( &rcss::InitSenderCommonV8::sendServerParam ),
     //                //               this ) );
-    serializer().serializeServerParamEnd( transport() );
-    if ( isGameLog() )
-    {
-        transport() << std::endl;
-    }
-    else
-    {
-        transport() << std::ends << std::flush;
-    }
+    serializer().serializeServerParamEnd( os );
+    endMessage( os );
+    msgs.push_back( os.str() );
 }
 
 void
-InitSenderCommonV8::sendServerParam( const ServerParam::VerMap::value_type & param )
+InitSenderCommonV8::serializeServerParam( std::ostream & os,
+                                          const ServerParam::VerMap::value_type & param )
 {
     if ( param.second <= version() )
     {
@@ -451,7 +524,7 @@ InitSenderCommonV8::sendServerParam( const ServerParam::VerMap::value_type & par
         int ivalue;
         if ( ServerParam::instance().getInt( param.first, ivalue ) )
         {
-            serializer().serializeParam( transport(),
+            serializer().serializeParam( os,
                                          param.first,
                                          ivalue );
             return;
@@ -460,7 +533,7 @@ InitSenderCommonV8::sendServerParam( const ServerParam::VerMap::value_type & par
         bool bvalue;
         if ( ServerParam::instance().getBool( param.first, bvalue ) )
         {
-            serializer().serializeParam( transport(),
+            serializer().serializeParam( os,
                                          param.first,
                                          bvalue );
             return;
@@ -469,7 +542,7 @@ InitSenderCommonV8::sendServerParam( const ServerParam::VerMap::value_type & par
         double dvalue;
         if ( ServerParam::instance().getDouble( param.first, dvalue ) )
         {
-            serializer().serializeParam( transport(),
+            serializer().serializeParam( os,
                                          param.first,
                                          dvalue );
             return;
@@ -478,7 +551,7 @@ InitSenderCommonV8::sendServerParam( const ServerParam::VerMap::value_type & par
         std::string svalue;
         if ( ServerParam::instance().getStr( param.first, svalue ) )
         {
-            serializer().serializeParam( transport(),
+            serializer().serializeParam( os,
                                          param.first,
                                          svalue );
             return;
@@ -487,12 +560,13 @@ InitSenderCommonV8::sendServerParam( const ServerParam::VerMap::value_type & par
 }
 
 void
-InitSenderCommonV8::sendPlayerParams()
+InitSenderCommonV8::serializePlayerParams( Messages & msgs )
 {
-    serializer().serializePlayerParamBegin( transport() );
+    std::ostringstream os;
+    serializer().serializePlayerParamBegin( os );
     for ( PlayerParam::VerMap::const_reference param : PlayerParam::instance().verMap() )
     {
-        sendPlayerParam( param );
+        serializePlayerParam( os, param );
     }
     // std::for_each( PlayerParam::instance().verMap().begin(),
     //                PlayerParam::instance().verMap().end(),
@@ -502,27 +576,22 @@ InitSenderCommonV8::sendPlayerParams()
     //                } );
     //                // std::bind1st( std::mem_fun( &rcss::InitSenderCommonV8::sendPlayerParam ),
     //                //               this ) );
-    serializer().serializePlayerParamEnd( transport() );
-    if ( isGameLog() )
-    {
-        transport() << std::endl;
-    }
-    else
-    {
-        transport() << std::ends << std::flush;
-    }
+    serializer().serializePlayerParamEnd( os );
+    endMessage( os );
+    msgs.push_back( os.str() );
 }
 
 
 void
-InitSenderCommonV8::sendPlayerParam( const PlayerParam::VerMap::value_type & param )
+InitSenderCommonV8::serializePlayerParam( std::ostream & os,
+                                          const PlayerParam::VerMap::value_type & param )
 {
     if ( param.second <= version() )
     {
         int ivalue;
         if ( PlayerParam::instance().getInt( param.first, ivalue ) )
         {
-            serializer().serializeParam( transport(),
+            serializer().serializeParam( os,
                                          param.first,
                                          ivalue );
             return;
@@ -531,7 +600,7 @@ InitSenderCommonV8::sendPlayerParam( const PlayerParam::VerMap::value_type & par
         bool bvalue;
         if ( PlayerParam::instance().getBool( param.first, bvalue ) )
         {
-            serializer().serializeParam( transport(),
+            serializer().serializeParam( os,
                                          param.first,
                                          bvalue );
             return;
@@ -540,7 +609,7 @@ InitSenderCommonV8::sendPlayerParam( const PlayerParam::VerMap::value_type & par
         double dvalue;
         if ( PlayerParam::instance().getDouble( param.first, dvalue ) )
         {
-            serializer().serializeParam( transport(),
+            serializer().serializeParam( os,
                                          param.first,
                                          dvalue );
             return;
@@ -549,7 +618,7 @@ InitSenderCommonV8::sendPlayerParam( const PlayerParam::VerMap::value_type & par
         std::string svalue;
         if ( PlayerParam::instance().getStr( param.first, svalue ) )
         {
-            serializer().serializeParam( transport(),
+            serializer().serializeParam( os,
                                          param.first,
                                          svalue );
             return;
@@ -558,26 +627,21 @@ InitSenderCommonV8::sendPlayerParam( const PlayerParam::VerMap::value_type & par
 }
 
 void
-InitSenderCommonV8::sendPlayerTypes()
+InitSenderCommonV8::serializePlayerTypes( Messages & msgs )
 {
     for ( int i = 0; i < PlayerParam::instance().playerTypes(); ++i )
     {
         const HeteroPlayer * type = stadium().playerType( i );
         if ( type )
         {
-            serializer().serializePlayerTypeBegin( transport(), i );
+            std::ostringstream os;
+            serializer().serializePlayerTypeBegin( os, i );
 
-            type->printParamsSExp( transport(), version() );
+            type->printParamsSExp( os, version() );
 
-            serializer().serializePlayerTypeEnd( transport() );
-            if ( isGameLog() )
-            {
-                transport() << std::endl;
-            }
-            else
-            {
-                transport() << std::ends << std::flush;
-            }
+            serializer().serializePlayerTypeEnd( os );
+            endMessage( os );
+            msgs.push_back( os.str() );
         }
     }
 }
@@ -588,14 +652,25 @@ InitSenderCommonV8::sendPlayerTypes()
 /*-------------------------------------------------------------------*/
 
 void
-InitSenderCommonJSON::sendServerParams()
+InitSenderCommonJSON::endMessage( std::ostream & os )
+{
+    // log records are separated by the leading ",\n"
+    if ( ! isGameLog() )
+    {
+        os << std::ends;
+    }
+}
+
+void
+InitSenderCommonJSON::serializeServerParams( Messages & msgs )
 {
+    std::ostringstream os;
     if ( isGameLog() )
     {
-        transport() << ",\n";
+        os << ",\n";
     }
 
-    serializer().serializeServerParamBegin( transport() );
+    serializer().serializeServerParamBegin( os );
     bool first = true;
     for ( ServerParam::VerMap::const_reference param : ServerParam::instance().verMap() )
     {
@@ -607,10 +682,10 @@ InitSenderCommonJSON::sendServerParams()
             }
             else
             {
-                transport() << ',';
+                os << ',';
             }
 
-            sendServerParam( param );
+            serializeServerParam( os, param );
         }
     }
     // std::for_each( ServerParam::instance().verMap().begin(),
@@ -621,41 +696,35 @@ InitSenderCommonJSON::sendServerParams()
     //                    {
     //                        if ( ! first )
     //                        {
-    //                            transport() << ",";
+    //                            os << ",";
     //                            first = false;
     //                        }
     //                        sendServerParam( v );
     //                    }
     //                } );
-    serializer().serializeServerParamEnd( transport() );
-
-    if ( isGameLog() )
-    {
-        transport() << std::flush;
-    }
-    else
-    {
-        transport() << std::ends << std::flush;
-    }
+    serializer().serializeServerParamEnd( os );
+    endMessage( os );
+    msgs.push_back( os.str() );
 }
 
 void
-InitSenderCommonJSON::sendPlayerParams()
+InitSenderCommonJSON::serializePlayerParams( Messages & msgs )
 {
+    std::ostringstream os;
     if ( isGameLog() )
     {
-        transport() << ",\n";
+        os << ",\n";
     }
 
-    serializer().serializePlayerParamBegin( transport() );
+    serializer().serializePlayerParamBegin( os );
     bool first = true;
     for ( PlayerParam::VerMap::const_reference param : PlayerParam::instance().verMap() )
     {
         if ( param.second <= version() )
         {
-            if ( first ) first = false; else transport() << ',';
+            if ( first ) first = false; else os << ',';
 
-            sendPlayerParam( param );
+            serializePlayerParam( os, param );
         }
     }
     // std::for_each( PlayerParam::instance().verMap().begin(),
@@ -666,27 +735,20 @@ InitSenderCommonJSON::sendPlayerParams()
     //                    {
     //                        if ( ! first )
     //                        {
-    //                            transport() << ",";
+    //                            os << ",";
     //                            first = false;
     //                        }
     //                        sendPlayerParam( v );
     //                    }
     //                } );
-    serializer().serializePlayerParamEnd( transport() );
-
-    if ( isGameLog() )
-    {
-        transport() << std::flush;
-    }
-    else
-    {
-        transport() << std::ends << std::flush;
-    }
+    serializer().serializePlayerParamEnd( os );
+    endMessage( os );
+    msgs.push_back( os.str() );
 }
 
 
 void
-InitSenderCommonJSON::sendPlayerTypes()
+InitSenderCommonJSON::serializePlayerTypes( Messages & msgs )
 {
     const int max_types = PlayerParam::instance().playerTypes();
     if ( max_types == 0 )
@@ -699,35 +761,31 @@ InitSenderCommonJSON::sendPlayerTypes()
         const HeteroPlayer * type = stadium().playerType( i );
         if ( type )
         {
+            std::ostringstream os;
             if ( isGameLog() )
             {
-                transport() << ",\n";
+                os << ",\n";
             }
 
-            serializer().serializePlayerTypeBegin( transport(), i );
+            serializer().serializePlayerTypeBegin( os, i );
 
-            type->printParamsJSON( transport(), version() );
+            type->printParamsJSON( os, version() );
 
-            serializer().serializePlayerTypeEnd( transport() );
-            if ( isGameLog() )
-            {
-                transport() << std::flush;
-            }
-            else
-            {
-                transport() << std::ends << std::flush;
-            }
+            serializer().serializePlayerTypeEnd( os );
+            endMessage( os );
+            msgs.push_back( os.str() );
         }
     }
 }
 
 void
-InitSenderCommonJSON::sendServerParam( ServerParam::VerMap::value_type param )
+InitSenderCommonJSON::serializeServerParam( std::ostream & os,
+                                            ServerParam::VerMap::value_type param )
 {
     int ivalue;
     if ( ServerParam::instance().getInt( param.first, ivalue ) )
     {
-        serializer().serializeParam( transport(),
+        serializer().serializeParam( os,
                                      param.first,
                                      ivalue );
         return;
@@ -736,7 +794,7 @@ InitSenderCommonJSON::sendServerParam( ServerParam::VerMap::value_type param )
     bool bvalue;
     if ( ServerParam::instance().getBool( param.first, bvalue ) )
     {
-        serializer().serializeParam( transport(),
+        serializer().serializeParam( os,
                                      param.first,
                                      bvalue );
         return;
@@ -745,7 +803,7 @@ InitSenderCommonJSON::sendServerParam( ServerParam::VerMap::value_type param )
     double dvalue;
     if ( ServerParam::instance().getDouble( param.first, dvalue ) )
     {
-        serializer().serializeParam( transport(),
+        serializer().serializeParam( os,
                                      param.first,
                                      dvalue );
         return;
@@ -754,7 +812,7 @@ InitSenderCommonJSON::sendServerParam( ServerParam::VerMap::value_type param )
     std::string svalue;
     if ( ServerParam::instance().getStr( param.first, svalue ) )
     {
-        serializer().serializeParam( transport(),
+        serializer().serializeParam( os,
                                      param.first,
                                      svalue );
         return;
@@ -762,12 +820,13 @@ InitSenderCommonJSON::sendServerParam( ServerParam::VerMap::value_type param )
 }
 
 void
-InitSenderCommonJSON::sendPlayerParam( const PlayerParam::VerMap::value_type & param )
+InitSenderCommonJSON::serializePlayerParam( std::ostream & os,
+                                            const PlayerParam::VerMap::value_type & param )
 {
     int ivalue;
     if ( PlayerParam::instance().getInt( param.first, ivalue ) )
     {
-        serializer().serializeParam( transport(),
+        serializer().serializeParam( os,
                                      param.first,
                                      ivalue );
         return;
@@ -776,7 +835,7 @@ InitSenderCommonJSON::sendPlayerParam( const PlayerParam::VerMap::value_type & p
     bool bvalue;
     if ( PlayerParam::instance().getBool( param.first, bvalue ) )
     {
-        serializer().serializeParam( transport(),
+        serializer().serializeParam( os,
                                      param.first,
                                      bvalue );
         return;
@@ -785,7 +844,7 @@ InitSenderCommonJSON::sendPlayerParam( const PlayerParam::VerMap::value_type & p
     double dvalue;
     if ( PlayerParam::instance().getDouble( param.first, dvalue ) )
     {
-        serializer().serializeParam( transport(),
+        serializer().serializeParam( os,
                                      param.first,
                                      dvalue );
         return;
@@ -794,7 +853,7 @@ InitSenderCommonJSON::sendPlayerParam( const PlayerParam::VerMap::value_type & p
     std::string svalue;
     if ( PlayerParam::instance().getStr( param.first, svalue ) )
     {
-        serializer().serializeParam( transport(),
+        serializer().serializeParam( os,
                                      param.first,
                                      svalue );
         return;
@@ -29,6 +29,8 @@
 #include "playerparam.h"
 
 #include <memory>
+#include <string>
+#include <vector>
 
 class Stadium;
 class HeteroPlayer;
@@ -43,11 +45,24 @@ class Serializer;
 //  CLASS: InitSenderCommon
 //
 //  DESC: base sender for init protocol for all clients.
+//        The parameter messages are identical for every client of the
+//        same protocol, so they are serialized once and then sent
+//        from a shared cache until clearCache() is called.
 //
 //===================================================================
 */
 
 class InitSenderCommon {
+public:
+    //! one entry per datagram (or log record)
+    typedef std::vector< std::string > Messages;
+
+    enum MessageKind {
+        SERVER_PARAMS,
+        PLAYER_PARAMS,
+        PLAYER_TYPES,
+    };
+
 private:
     std::ostream & M_transport;
     const std::shared_ptr< Serializer > M_serializer;
@@ -97,14 +112,46 @@ public:
           return M_game_log;
       }
 
+    void sendServerParams()
+      {
+          send( SERVER_PARAMS );
+      }
+
+    void sendPlayerParams()
+      {
+          send( PLAYER_PARAMS );
+      }
+
+    void sendPlayerTypes()
+      {
+          send( PLAYER_TYPES );
+      }
+
+    /*!
+      \brief discard all cached messages. must be called whenever
+      ServerParam, PlayerParam or the player types are modified.
+     */
+    static
+    void clearCache();
+
+protected:
+
     virtual
-    void sendServerParams() = 0;
+    void serializeServerParams( Messages & msgs ) = 0;
 
     virtual
-    void sendPlayerParams() = 0;
+    void serializePlayerParams( Messages & msgs ) = 0;
 
     virtual
-    void sendPlayerTypes() = 0;
+    void serializePlayerTypes( Messages & msgs ) = 0;
+
+    //! terminate a message in the format required by the transport
+    virtual
+    void endMessage( std::ostream & os );
+
+private:
+
+    void send( const MessageKind kind );
 };
 
 /*!
@@ -195,16 +242,18 @@ public:
     ~InitSenderCommonV1() override
       { }
 
+protected:
+
     virtual
-    void sendServerParams() override
+    void serializeServerParams( Messages & ) override
       { }
 
     virtual
-    void sendPlayerParams() override
+    void serializePlayerParams( Messages & ) override
       { }
 
     virtual
-    void sendPlayerTypes() override
+    void serializePlayerTypes( Messages & ) override
       { }
 };
 
@@ -238,18 +287,20 @@ public:
     ~InitSenderCommonV7() override
       { }
 
+protected:
+
     virtual
-    void sendServerParams() override;
+    void serializeServerParams( Messages & msgs ) override;
 
     virtual
-    void sendPlayerParams() override;
+    void serializePlayerParams( Messages & msgs ) override;
 
     virtual
-    void sendPlayerTypes() override;
+    void serializePlayerTypes( Messages & msgs ) override;
 
-protected:
     virtual
-    void serializePlayerType( const HeteroPlayer & type );
+    void serializePlayerType( std::ostream & os,
+                              const HeteroPlayer & type );
 
 };
 
@@ -282,20 +333,24 @@ public:
     ~InitSenderCommonV8() override
       { }
 
+protected:
+
     virtual
-    void sendServerParams() override;
+    void serializeServerParams( Messages & msgs ) override;
 
     virtual
-    void sendPlayerParams() override;
+    void serializePlayerParams( Messages & msgs ) override;
 
     virtual
-    void sendPlayerTypes() override;
+    void serializePlayerTypes( Messages & msgs ) override;
 
 private:
 
-    void sendServerParam( const ServerParam::VerMap::value_type & param );
+    void serializeServerParam( std::ostream & os,
+                               const ServerParam::VerMap::value_type & param );
 
-    void sendPlayerParam( const PlayerParam::VerMap::value_type & param );
+    void serializePlayerParam( std::ostream & os,
+                               const PlayerParam::VerMap::value_type & param );
 };
 
 
@@ -328,20 +383,24 @@ public:
     ~InitSenderCommonJSON() override
     { }
 
-    virtual
-    void sendServerParams() override;
+protected:
 
     virtual
-    void sendPlayerParams() override;
+    void serializeServerParams( Messages & msgs ) override;
 
     virtual
-    void sendPlayerTypes() override;
+    void serializePlayerParams( Messages & msgs ) override;
 
+    virtual
+    void serializePlayerTypes( Messages & msgs ) override;
 
-protected:
+    virtual
+    void endMessage( std::ostream & os ) override;
 
-    void sendServerParam( ServerParam::VerMap::value_type param );
-    void sendPlayerParam( const PlayerParam::VerMap::value_type & param );
+    void serializeServerParam( std::ostream & os,
+                               ServerParam::VerMap::value_type param );
+    void serializePlayerParam( std::ostream & os,
+                               const PlayerParam::VerMap::value_type & param );
 
 };
 
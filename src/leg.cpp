@@ -147,6 +147,20 @@ Leg::tackle()
     M_command_type = TACKLE;
 }
 
+void
+Leg::restore( const CommandType type,
+              const double kick_power,
+              const double kick_dir,
+              const double dash_power,
+              const double dash_dir )
+{
+    M_command_type = type;
+    M_kick_power = kick_power;
+    M_kick_dir = kick_dir;
+    M_dash_power = dash_power;
+    M_dash_dir = dash_dir;
+}
+
 PVector
 Leg::calcDashAccel( const double consumed_stamina ) const
 {
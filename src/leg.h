@@ -72,6 +72,12 @@ public:
 
     void tackle();
 
+    //! sets the command saved in a checkpoint
+    void restore( const CommandType type,
+                  const double kick_power,
+                  const double kick_dir,
+                  const double dash_power,
+                  const double dash_dir );
 
     bool commandDone() const
       {
@@ -0,0 +1,435 @@
+// -*-c++-*-
+
+/***************************************************************************
+                             loadgenerator.cpp
+                  Simulated clients to put load on a server
+                             -------------------
+    begin                : 2026-10-18
+    copyright            : (C) 2026 by The RoboCup Soccer Server
+                           Maintenance Group.
+    email                : sserver-admin@lists.sourceforge.net
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU LGPL as published by the Free Software  *
+ *   Foundation; either version 3 of the License, or (at your option) any  *
+ *   later version.                                                        *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "loadgenerator.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <poll.h>
+
+LoadGenerator::Options::Options()
+    : server_( "localhost" ),
+      port_( 6000 ),
+      coach_port_( 6002 ),
+      players_( 22 ),
+      coaches_( 0 ),
+      version_( 19.0 ),
+      team_( "load" ),
+      think_latency_( 0 ),
+      duration_( 0.0 ),
+      report_interval_( 5.0 ),
+      seed_( 0 ),
+      dash_( 50.0 ),
+      turn_( 20.0 ),
+      kick_( 10.0 ),
+      say_( 5.0 ),
+      change_view_( 5.0 )
+{
+
+}
+
+bool
+LoadGenerator::Options::parsePolicy( const std::string & policy )
+{
+    dash_ = turn_ = kick_ = say_ = change_view_ = 0.0;
+
+    std::istringstream is( policy );
+    std::string item;
+    while ( std::getline( is, item, ',' ) )
+    {
+        const std::string::size_type eq = item.find( '=' );
+        if ( eq == std::string::npos )
+        {
+            return false;
+        }
+
+        const std::string name = item.substr( 0, eq );
+        const double weight = std::atof( item.c_str() + eq + 1 );
+        if ( weight < 0.0 ) return false;
+
+        if ( name == "dash" ) dash_ = weight;
+        else if ( name == "turn" ) turn_ = weight;
+        else if ( name == "kick" ) kick_ = weight;
+        else if ( name == "say" ) say_ = weight;
+        else if ( name == "change_view" ) change_view_ = weight;
+        else return false;
+    }
+
+    return dash_ + turn_ + kick_ + say_ + change_view_ > 0.0;
+}
+
+
+LoadGenerator::Stats::Stats()
+    : received_( 0 ),
+      sense_body_( 0 ),
+      see_( 0 ),
+      think_( 0 ),
+      errors_( 0 ),
+      sent_( 0 ),
+      dropped_( 0 )
+{
+
+}
+
+
+LoadGenerator::LoadGenerator( const Options & opt )
+    : M_opt( opt ),
+      M_rng( opt.seed_ )
+{
+
+}
+
+bool
+LoadGenerator::connect()
+{
+    M_clients.resize( M_opt.players_ + M_opt.coaches_ );
+
+    for ( size_t i = 0; i < M_clients.size(); ++i )
+    {
+        SimClient & c = M_clients[i];
+        c.coach_ = ( static_cast< int >( i ) >= M_opt.players_ );
+
+        if ( ! c.socket_.open()
+             || c.socket_.setNonBlocking() < 0
+             || ! c.socket_.bind( rcss::net::Addr() ) )
+        {
+            std::cerr << "Error opening socket " << i << ": "
+                      << std::strerror( errno ) << std::endl;
+            return false;
+        }
+
+        c.dest_ = rcss::net::Addr( c.coach_ ? M_opt.coach_port_ : M_opt.port_ );
+        if ( ! c.dest_.setHost( M_opt.server_ ) )
+        {
+            std::cerr << "Unknown host: " << M_opt.server_ << std::endl;
+            return false;
+        }
+    }
+
+    // the teams have to exist before their online coaches connect
+    for ( int pass = 0; pass < 2; ++pass )
+    {
+        for ( size_t i = 0; i < M_clients.size(); ++i )
+        {
+            SimClient & c = M_clients[i];
+            if ( c.coach_ != ( pass == 1 ) ) continue;
+
+            const int team = ( c.coach_
+                               ? static_cast< int >( i ) - M_opt.players_
+                               : static_cast< int >( i ) / 11 );
+
+            std::ostringstream os;
+            os << "(init " << M_opt.team_ << team
+               << " (version " << M_opt.version_ << "))";
+            send( c, os.str() );
+        }
+
+        receive( Clock::now() + std::chrono::milliseconds( 500 ) );
+    }
+
+    const long connected = std::count_if( M_clients.begin(), M_clients.end(),
+                                          []( const SimClient & c ) { return c.connected_; } );
+    std::cout << "(connected " << connected << " of " << M_clients.size() << ')' << std::endl;
+    return true;
+}
+
+bool
+LoadGenerator::run()
+{
+    if ( ! connect() )
+    {
+        return false;
+    }
+
+    // the connection phase is not measured
+    M_total = Stats();
+    M_interval = Stats();
+
+    const Clock::time_point start_time = Clock::now();
+    const Clock::time_point end_time
+        = ( M_opt.duration_ > 0.0
+            ? start_time + std::chrono::duration_cast< Clock::duration >
+            ( std::chrono::duration< double >( M_opt.duration_ ) )
+            : Clock::time_point::max() );
+    const Clock::duration report_interval
+        = std::chrono::duration_cast< Clock::duration >
+        ( std::chrono::duration< double >( M_opt.report_interval_ ) );
+
+    Clock::time_point report_time = start_time;
+    Clock::time_point next_report = start_time + report_interval;
+
+    while ( Clock::now() < end_time )
+    {
+        receive( std::min( next_report, end_time ) );
+
+        const Clock::time_point now = Clock::now();
+        if ( now >= next_report )
+        {
+            report( std::cout, M_interval,
+                    std::chrono::duration< double >( now - report_time ).count() );
+            M_interval = Stats();
+            report_time = now;
+            next_report = now + report_interval;
+        }
+    }
+
+    std::cout << "total ";
+    report( std::cout, M_total,
+            std::chrono::duration< double >( Clock::now() - start_time ).count() );
+    return true;
+}
+
+void
+LoadGenerator::receive( const Clock::time_point & until )
+{
+    std::vector< pollfd > fds( M_clients.size() );
+    for ( size_t i = 0; i < M_clients.size(); ++i )
+    {
+        fds[i].fd = M_clients[i].socket_.getFD();
+        fds[i].events = POLLIN;
+        fds[i].revents = 0;
+    }
+
+    Clock::time_point now = Clock::now();
+    while ( now < until )
+    {
+        const Clock::time_point wake = ( M_replies.empty()
+                                         ? until
+                                         : std::min( until, M_replies.top().time_ ) );
+        const long long timeout
+            = std::chrono::duration_cast< std::chrono::milliseconds >( wake - now ).count();
+
+        if ( ::poll( fds.data(), fds.size(),
+                     static_cast< int >( std::max( timeout, 0LL ) ) ) > 0 )
+        {
+            for ( size_t i = 0; i < fds.size(); ++i )
+            {
+                if ( fds[i].revents & POLLIN )
+                {
+                    drain( i );
+                }
+            }
+        }
+
+        now = Clock::now();
+        sendReplies( now );
+    }
+}
+
+void
+LoadGenerator::drain( const size_t idx )
+{
+    SimClient & c = M_clients[idx];
+
+    char buf[8192];
+    rcss::net::Addr from;
+    int len = 0;
+    while ( ( len = c.socket_.recv( buf, sizeof( buf ) - 1, from ) ) > 0 )
+    {
+        buf[len] = '\0';
+
+        // the server answers from the dedicated port of the client
+        c.dest_.setPort( from.getPort() );
+
+        ++M_total.received_;
+        ++M_interval.received_;
+        parseMsg( idx, buf );
+    }
+}
+
+void
+LoadGenerator::parseMsg( const size_t idx,
+                         const char * msg )
+{
+    SimClient & c = M_clients[idx];
+
+    if ( ! std::strncmp( msg, "(sense_body ", 12 ) )
+    {
+        ++M_total.sense_body_;
+        ++M_interval.sense_body_;
+
+        int time = -1;
+        if ( std::sscanf( msg, "(sense_body %d", &time ) == 1 )
+        {
+            if ( c.last_time_ >= 0
+                 && time > c.last_time_ + 1 )
+            {
+                M_total.dropped_ += time - c.last_time_ - 1;
+                M_interval.dropped_ += time - c.last_time_ - 1;
+            }
+            c.last_time_ = std::max( c.last_time_, time );
+        }
+
+        // in synch mode the command is sent on (think)
+        if ( M_total.think_ == 0 )
+        {
+            M_replies.push( Reply{ Clock::now() + M_opt.think_latency_, idx, false } );
+        }
+    }
+    else if ( ! std::strncmp( msg, "(see", 4 ) )
+    {
+        ++M_total.see_;
+        ++M_interval.see_;
+
+        if ( c.coach_
+             && M_total.think_ == 0 )
+        {
+            M_replies.push( Reply{ Clock::now() + M_opt.think_latency_, idx, false } );
+        }
+    }
+    else if ( ! std::strncmp( msg, "(think)", 7 ) )
+    {
+        ++M_total.think_;
+        ++M_interval.think_;
+        M_replies.push( Reply{ Clock::now() + M_opt.think_latency_, idx, true } );
+    }
+    else if ( ! std::strncmp( msg, "(init ", 6 ) )
+    {
+        c.connected_ = true;
+    }
+    else if ( ! std::strncmp( msg, "(error", 6 ) )
+    {
+        ++M_total.errors_;
+        ++M_interval.errors_;
+    }
+}
+
+void
+LoadGenerator::sendReplies( const Clock::time_point & now )
+{
+    while ( ! M_replies.empty()
+            && M_replies.top().time_ <= now )
+    {
+        const Reply reply = M_replies.top();
+        M_replies.pop();
+
+        SimClient & c = M_clients[reply.client_];
+        if ( ! c.connected_ ) continue;
+
+        if ( c.coach_ )
+        {
+            send( c, "(look)" );
+        }
+        else
+        {
+            send( c, policyCommand() );
+        }
+
+        if ( reply.done_ )
+        {
+            send( c, "(done)" );
+        }
+    }
+}
+
+void
+LoadGenerator::send( SimClient & client,
+                     const std::string & msg )
+{
+    if ( client.socket_.send( msg.c_str(), msg.length() + 1, client.dest_ ) == -1 )
+    {
+        if ( errno != ECONNREFUSED )
+        {
+            std::cerr << "Error sending to " << client.dest_ << ": "
+                      << std::strerror( errno ) << std::endl;
+        }
+        return;
+    }
+
+    ++M_total.sent_;
+    ++M_interval.sent_;
+}
+
+std::string
+LoadGenerator::policyCommand()
+{
+    const double total = M_opt.dash_ + M_opt.turn_ + M_opt.kick_
+        + M_opt.say_ + M_opt.change_view_;
+    double r = std::uniform_real_distribution< double >( 0.0, total )( M_rng );
+
+    std::uniform_real_distribution< double > power( 0.0, 100.0 );
+    std::uniform_real_distribution< double > angle( -180.0, 180.0 );
+
+    char buf[64];
+    if ( ( r -= M_opt.dash_ ) < 0.0 )
+    {
+        std::snprintf( buf, sizeof( buf ), "(dash %.1f)", power( M_rng ) );
+    }
+    else if ( ( r -= M_opt.turn_ ) < 0.0 )
+    {
+        std::snprintf( buf, sizeof( buf ), "(turn %.1f)", angle( M_rng ) );
+    }
+    else if ( ( r -= M_opt.kick_ ) < 0.0 )
+    {
+        std::snprintf( buf, sizeof( buf ), "(kick %.1f %.1f)", power( M_rng ), angle( M_rng ) );
+    }
+    else if ( ( r -= M_opt.say_ ) < 0.0 )
+    {
+        std::snprintf( buf, sizeof( buf ), "(say load%u)",
+                       static_cast< unsigned int >( M_rng() % 1000 ) );
+    }
+    else
+    {
+        static const char * widths[] = { "narrow", "normal", "wide" };
+        std::snprintf( buf, sizeof( buf ), "(change_view %s high)", widths[M_rng() % 3] );
+    }
+
+    return buf;
+}
+
+void
+LoadGenerator::report( std::ostream & os,
+                       const Stats & stats,
+                       const double seconds ) const
+{
+    const double rate = ( seconds > 0.0 ? 1.0 / seconds : 0.0 );
+    const unsigned long expected = stats.sense_body_ + stats.dropped_;
+
+    const std::ios_base::fmtflags flags = os.flags();
+    const std::streamsize precision = os.precision();
+
+    os << std::fixed << std::setprecision( 1 )
+       << "(load (seconds " << seconds << ')'
+       << " (received " << stats.received_ << ' ' << stats.received_ * rate << "/s)"
+       << " (sense_body " << stats.sense_body_ << ' ' << stats.sense_body_ * rate << "/s)"
+       << " (see " << stats.see_ << ')'
+       << " (think " << stats.think_ << ')'
+       << " (sent " << stats.sent_ << ' ' << stats.sent_ * rate << "/s)"
+       << " (errors " << stats.errors_ << ')'
+       << " (dropped " << stats.dropped_ << ' '
+       << std::setprecision( 3 )
+       << ( expected > 0 ? 100.0 * stats.dropped_ / expected : 0.0 ) << "%))"
+       << std::endl;
+
+    os.flags( flags );
+    os.precision( precision );
+}
@@ -0,0 +1,148 @@
+// -*-c++-*-
+
+/***************************************************************************
+                              loadgenerator.h
+                  Simulated clients to put load on a server
+                             -------------------
+    begin                : 2026-10-18
+    copyright            : (C) 2026 by The RoboCup Soccer Server
+                           Maintenance Group.
+    email                : sserver-admin@lists.sourceforge.net
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU LGPL as published by the Free Software  *
+ *   Foundation; either version 3 of the License, or (at your option) any  *
+ *   later version.                                                        *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef RCSS_LOADGENERATOR_H
+#define RCSS_LOADGENERATOR_H
+
+#include <rcss/net/udpsocket.hpp>
+
+#include <chrono>
+#include <queue>
+#include <random>
+#include <string>
+#include <vector>
+
+/*!
+  \class LoadGenerator
+  \brief opens many simulated player and online coach connections from
+  one process.
+
+  The players of team i are named "<team><i>", eleven to a team.  Each
+  player answers every sense_body, or every (think) in synch mode, after
+  the think latency with a command drawn from the weighted policy, and
+  a (done) in synch mode.  The online coaches answer their see_global,
+  or (think), with (look).
+  The cycles that a player has not seen a sense_body for are counted as
+  dropped.
+*/
+class LoadGenerator {
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    struct Options {
+        std::string server_;
+        int port_;
+        int coach_port_;
+        int players_;
+        int coaches_;
+        double version_;
+        std::string team_;
+        std::chrono::microseconds think_latency_;
+        double duration_; //!< [s], 0 runs until killed
+        double report_interval_; //!< [s]
+        unsigned int seed_;
+
+        //! weights of dash, turn, kick, say and change_view
+        double dash_;
+        double turn_;
+        double kick_;
+        double say_;
+        double change_view_;
+
+        Options();
+
+        //! parses "dash=50,turn=20,..." into the weights
+        bool parsePolicy( const std::string & policy );
+    };
+
+private:
+
+    struct SimClient {
+        rcss::net::UDPSocket socket_;
+        rcss::net::Addr dest_;
+        bool coach_;
+        bool connected_;
+        int last_time_; //!< the time of the last sense_body
+
+        SimClient()
+            : coach_( false ),
+              connected_( false ),
+              last_time_( -1 )
+          { }
+    };
+
+    struct Reply {
+        Clock::time_point time_;
+        size_t client_;
+        bool done_;
+
+        bool operator<( const Reply & other ) const
+          {
+              // the earliest reply on the top of the priority queue
+              return time_ > other.time_;
+          }
+    };
+
+    struct Stats {
+        unsigned long received_;
+        unsigned long sense_body_;
+        unsigned long see_;
+        unsigned long think_;
+        unsigned long errors_;
+        unsigned long sent_;
+        unsigned long dropped_;
+
+        Stats();
+    };
+
+    Options M_opt;
+    std::vector< SimClient > M_clients;
+    std::priority_queue< Reply > M_replies;
+    std::mt19937 M_rng;
+
+    Stats M_total;
+    Stats M_interval;
+
+public:
+    explicit
+    LoadGenerator( const Options & opt );
+
+    bool run();
+
+private:
+    bool connect();
+
+    void receive( const Clock::time_point & until );
+    void drain( const size_t idx );
+    void parseMsg( const size_t idx,
+                   const char * msg );
+
+    void sendReplies( const Clock::time_point & now );
+    void send( SimClient & client,
+               const std::string & msg );
+    std::string policyCommand();
+
+    void report( std::ostream & os,
+                 const Stats & stats,
+                 const double seconds ) const;
+};
+
+#endif
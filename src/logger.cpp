@@ -77,12 +77,36 @@ struct Logger::Impl
     std::ofstream kaway_log_; //!< file for keepaway log
     std::ofstream hfo_log_;   //!< file for hfo log
 
+    // what the game log has recorded so far, reset for every match
+    bool wrote_final_cycle_;
+    PlayMode playmode_;
+    std::string team_l_name_;
+    std::string team_r_name_;
+    int team_l_score_;
+    int team_r_score_;
+    int team_l_pen_taken_;
+    int team_r_pen_taken_;
+
     Impl()
         : init_observer_(new rcss::InitObserverLogger),
           observer_(new rcss::ObserverLogger),
           game_log_(nullptr),
           text_log_(nullptr)
     {
+        resetGameLogState();
+    }
+
+    void resetGameLogState()
+    {
+        /* TH - 2-NOV-2000 */
+        wrote_final_cycle_ = false;
+        playmode_ = PM_Null;
+        team_l_name_.clear();
+        team_r_name_.clear();
+        team_l_score_ = 0;
+        team_r_score_ = 0;
+        team_l_pen_taken_ = 0;
+        team_r_pen_taken_ = 0;
     }
 
     void flush()
@@ -236,6 +260,9 @@ bool Logger::setSenders(const Stadium &stadium)
 
 bool Logger::open(const Stadium &stadium)
 {
+    // a back to back run opens the logs again for every match
+    M_impl->resetGameLogState();
+
     if (ServerParam::instance().gameLogging())
     {
         if (!openGameLog(stadium))
@@ -805,9 +832,6 @@ void Logger::writeMsgToGameLog(const BoardType board_type,
 
 void Logger::writeGameLog(const Stadium &stadium)
 {
-    /* TH - 2-NOV-2000 */
-    static bool wrote_final_cycle = false;
-
     if (!M_impl->isGameLogOpen())
     {
         return;
@@ -833,7 +857,7 @@ void Logger::writeGameLog(const Stadium &stadium)
         //             break;
         //         }
     }
-    else if (stadium.playmode() == PM_TimeOver && !wrote_final_cycle)
+    else if (stadium.playmode() == PM_TimeOver && !M_impl->wrote_final_cycle_)
     {
         writeGameLogImpl(stadium);
         //         switch ( ServerParam::instance().gameLogVersion() ) {
@@ -852,33 +876,30 @@ void Logger::writeGameLog(const Stadium &stadium)
         //         default:
         //             break;
         //         }
-        wrote_final_cycle = true;
+        M_impl->wrote_final_cycle_ = true;
     }
 }
 
 void Logger::writeGameLogImpl(const Stadium &stadium)
 {
-    static PlayMode pm = PM_Null;
-    static std::string team_l_name, team_r_name;
-    static int team_l_score = 0, team_r_score = 0;
-    static int team_l_pen_taken = 0, team_r_pen_taken = 0;
+    Impl &impl = *M_impl;
 
     // if playmode has changed wirte playmode
-    if (pm != stadium.playmode())
+    if (impl.playmode_ != stadium.playmode())
     {
-        pm = stadium.playmode();
+        impl.playmode_ = stadium.playmode();
         M_impl->init_observer_->sendPlayMode();
     }
 
     // if teams or score has changed, write teams and score
-    if (team_l_score != stadium.teamLeft().point() || team_r_score != stadium.teamRight().point() || team_l_pen_taken != stadium.teamLeft().penaltyTaken() || team_r_pen_taken != stadium.teamRight().penaltyTaken() || stadium.teamLeft().name() != team_l_name || stadium.teamRight().name() != team_r_name)
+    if (impl.team_l_score_ != stadium.teamLeft().point() || impl.team_r_score_ != stadium.teamRight().point() || impl.team_l_pen_taken_ != stadium.teamLeft().penaltyTaken() || impl.team_r_pen_taken_ != stadium.teamRight().penaltyTaken() || stadium.teamLeft().name() != impl.team_l_name_ || stadium.teamRight().name() != impl.team_r_name_)
     {
-        team_l_name = stadium.teamLeft().name();
-        team_r_name = stadium.teamRight().name();
-        team_l_score = stadium.teamLeft().point();
-        team_r_score = stadium.teamRight().point();
-        team_l_pen_taken = stadium.teamLeft().penaltyTaken();
-        team_r_pen_taken = stadium.teamRight().penaltyTaken();
+        impl.team_l_name_ = stadium.teamLeft().name();
+        impl.team_r_name_ = stadium.teamRight().name();
+        impl.team_l_score_ = stadium.teamLeft().point();
+        impl.team_r_score_ = stadium.teamRight().point();
+        impl.team_l_pen_taken_ = stadium.teamLeft().penaltyTaken();
+        impl.team_r_pen_taken_ = stadium.teamRight().penaltyTaken();
 
         M_impl->init_observer_->sendTeam();
     }
@@ -1428,10 +1449,7 @@ void Logger::writeCoachStdAudio(const Stadium &stadium,
 {
     if (M_impl->isGameLogOpen() && ServerParam::instance().recordMessages() && stadium.playmode() != PM_BeforeKickOff && stadium.playmode() != PM_TimeOver)
     {
-        std::ostringstream coach_mess;
-
-        coach_mess << msg.getTimeRecv() << " ";
-        msg.print(coach_mess);
+        const std::string coach_mess = std::to_string(msg.getTimeRecv()) + ' ' + msg.text();
 
         char buf[max_message_length_for_display];
         char format[40];
@@ -1441,7 +1459,7 @@ void Logger::writeCoachStdAudio(const Stadium &stadium,
                  max_message_length_for_display,
                  format,
                  (coach.side() == RIGHT) ? OLCOACH_NAME_R : OLCOACH_NAME_L,
-                 coach_mess.str().c_str());
+                 coach_mess.c_str());
 
         writeMsgToGameLog(MSG_BOARD, buf);
     }
@@ -1559,3 +1577,14 @@ void Logger::writeProfile(const Stadium &stadium,
                            << "\t" << str << ": " << diff << '\n';
     }
 }
+
+void Logger::writeAllocations(const Stadium &stadium,
+                              const unsigned long count)
+{
+    if (M_impl->isTextLogOpen() && ServerParam::instance().profile())
+    {
+        *M_impl->text_log_ << stadium.time()
+                           << ',' << stadium.stoppageTime()
+                           << "\tALLOC: " << count << '\n';
+    }
+}
@@ -154,6 +154,8 @@ public:
                        const std::chrono::system_clock::time_point & start_time,
                        const std::chrono::system_clock::time_point & end_time,
                        const std::string & str );
+    void writeAllocations( const Stadium & stadium,
+                           const unsigned long count );
 
 };
 
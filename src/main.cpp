@@ -29,9 +29,14 @@
 #include "serverparam.h"
 #include "version.h"
 
+#include "commandlog.h"
+#include "replaytimer.h"
 #include "stdtimer.h"
 #include "synctimer.h"
+#include "tournament.h"
+#include "zygote.h"
 
+#include <algorithm>
 #include <memory>
 #include <iostream>
 #include <locale>
@@ -79,6 +84,53 @@ main( int argc, char *argv[] )
         return 1;
     }
 
+    if ( ! ServerParam::instance().tournamentFile().empty() )
+    {
+        rcss::Tournament tournament( std::max( ServerParam::instance().tournamentWorkers(), 0 ) );
+        if ( ! tournament.open( ServerParam::instance().tournamentFile() ) )
+        {
+            ServerParam::instance().clear();
+            return 1;
+        }
+
+        const rcss::Tournament::Result result = tournament.run();
+        if ( result != rcss::Tournament::START_MATCH )
+        {
+            ServerParam::instance().clear();
+            return ( result == rcss::Tournament::FINISHED ? 0 : 1 );
+        }
+    }
+
+    if ( ServerParam::instance().zygotePoolSize() > 0 )
+    {
+        // the children share the parsed parameters and the field
+        if ( ! Std.loadField() )
+        {
+            ServerParam::instance().clear();
+            return 1;
+        }
+
+        rcss::Zygote zygote( ServerParam::instance().zygotePoolSize() );
+        const rcss::Zygote::Result result = zygote.run( std::cin );
+        if ( result != rcss::Zygote::START_MATCH )
+        {
+            ServerParam::instance().clear();
+            return ( result == rcss::Zygote::FINISHED ? 0 : 1 );
+        }
+    }
+
+    if ( ! ServerParam::instance().resimulateFile().empty() )
+    {
+        int seed = 0;
+        if ( ! rcss::CommandLog::openReplay( ServerParam::instance().resimulateFile(), seed ) )
+        {
+            ServerParam::instance().clear();
+            return 1;
+        }
+        // the same seed reproduces the recorded match
+        ServerParam::instance().setRandomSeed( seed );
+    }
+
     if ( ! Std.init() )
     {
         ServerParam::instance().clear();
@@ -86,7 +138,11 @@ main( int argc, char *argv[] )
     }
 
     std::shared_ptr< Timer > timer;
-    if ( ServerParam::instance().synchMode() )
+    if ( rcss::CommandLog::isReplaying() )
+    {
+        timer = std::shared_ptr< Timer >( new ReplayTimer( Std ) );
+    }
+    else if ( ServerParam::instance().synchMode() )
     {
         timer = std::shared_ptr< Timer >( new SyncTimer( Std ) );
     }
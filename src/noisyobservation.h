@@ -0,0 +1,300 @@
+// -*-c++-*-
+
+/***************************************************************************
+                             noisyobservation.h
+            Observation noise models shared by the player sensors
+                             -------------------
+    begin                : 2026-10-18
+    copyright            : (C) 2026 by The RoboCup Soccer Server
+                           Maintenance Group.
+    email                : sserver-admin@lists.sourceforge.net
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU LGPL as published by the Free Software  *
+ *   Foundation; either version 3 of the License, or (at your option) any  *
+ *   later version.                                                        *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef RCSS_NOISYOBSERVATION_H
+#define RCSS_NOISYOBSERVATION_H
+
+#include "player.h"
+#include "heteroplayer.h"
+#include "random.h"
+#include "utility.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace rcss {
+
+/**
+ * @class NoisyObservation
+ * @brief Represents a noisy observation made by an observer player.
+ *
+ * This class provides a base interface for calculating distances, and velocities
+ * for noisy observations. It is meant to be inherited by specific observation classes.
+ */
+class NoisyObservation {
+private:
+    const Player & M_observer;
+
+protected:
+    NoisyObservation() = delete;
+
+    /**
+     * @brief Constructs a NoisyObservation object.
+     *
+     * This constructor initializes a NoisyObservation object with the given player.
+     *
+     * @param player The player object to observe.
+     */
+    explicit
+    NoisyObservation( const Player & player )
+        : M_observer( player )
+      { }
+
+    const Player & observer() const
+      {
+          return M_observer;
+      }
+
+public:
+    virtual
+    ~NoisyObservation() = default;
+
+    /**
+     * Calculates the noisy distance between the observer and the target movable object.
+     *
+     * @param actual_dist The actual distance between the observer and the target movable object.
+     * @param focus_dist The focus distance between the focus point and the target movable object.
+     * @return The calculated noisy distance.
+     */
+    virtual
+    double calcDist( const double actual_dist,
+                     const double focus_dist ) const = 0;
+    /**
+     * Calculates the noisy distance between the observer and the target landmark object.
+     *
+     * @param actual_dist The actual distance between the observer and the target landmark object.
+     * @param focus_dist The focus distance between the focus point and the target landmark object.
+     * @return The calculated noisy distance.
+     */
+    virtual
+    double calcDistLandmark( const double actual_dist,
+                             const double focus_dist ) const = 0;
+
+    /**
+     * Calculates the change in distance and direction based on the object's velocity, position, actual distance, and noisy distance.
+     *
+     * @param obj_vel The velocity of the target object.
+     * @param obj_pos The position of the target object.
+     * @param actual_dist The actual distance between the observer and the target object.
+     * @param noisy_dist The noisy distance between the observer and the target object.
+     * @param dist_chg Pointer to a variable that will store the calculated change in distance.
+     * @param dir_chg Pointer to a variable that will store the calculated change in direction.
+     */
+    virtual
+    void calcVel( const PVector & obj_vel,
+                  const PVector & obj_pos,
+                  const double actual_dist,
+                  const double noisy_dist,
+                  double * dist_chg,
+                  double * dir_chg ) const = 0;
+
+};
+
+/**
+ * @class QuantizeObservation
+ * @brief A class that represents a quantized observation of a player.
+ *
+ * This class is derived from the NoisyObservation class and provides methods for calculating
+ * quantized distances and velocities based on actual distances and positions.
+ */
+class QuantizeObservation
+    : public NoisyObservation {
+private:
+
+protected:
+    QuantizeObservation() = delete;
+
+public:
+    explicit
+    QuantizeObservation( const Player & player )
+        : NoisyObservation( player )
+      { }
+
+    virtual
+    ~QuantizeObservation() = default;
+
+private:
+
+    /**
+     * Calculates the observed distance based on the actual distance, focus distance, and quantization step.
+     *
+     * @param actual_dist The actual distance.
+     * @param focus_dist The focus distance.
+     * @param qstep The quantization step used for quantizing the distances.
+     * @return The observed distance calculated based on the given parameters.
+     */
+    double calcDistImpl( const double actual_dist,
+                         const double focus_dist,
+                         const double qstep ) const
+      {
+          const double quant_dist = std::exp( Quantize( std::log( actual_dist + EPS ), qstep ) );
+          const double quant_focus_dist = std::exp( Quantize( std::log( focus_dist + EPS ), qstep ) );
+          const double observed_dist = std::max( 0.0,
+                                                 actual_dist - ( ( focus_dist - quant_focus_dist ) + ( actual_dist - quant_dist ) ) / 2.0 );
+
+          return Quantize( observed_dist, 0.1 );
+      }
+
+public:
+    double calcDist( const double actual_dist,
+                     const double focus_dist ) const override
+      {
+          return calcDistImpl( actual_dist, focus_dist, observer().distQStep() );
+      }
+
+    double calcDistLandmark( const double actual_dist,
+                             const double focus_dist ) const override
+      {
+          return calcDistImpl( actual_dist, focus_dist, observer().landDistQStep() );
+      }
+
+    void calcVel( const PVector & obj_vel,
+                  const PVector & obj_pos,
+                  const double actual_dist,
+                  const double noisy_dist,
+                  double * dist_chg,
+                  double * dir_chg ) const override
+      {
+          if ( actual_dist != 0.0 )
+          {
+              const PVector vtmp = obj_vel - observer().vel();
+              const PVector etmp = ( obj_pos - observer().pos() ) /= actual_dist;
+
+              *dist_chg = vtmp.x * etmp.x + vtmp.y * etmp.y;
+              //         dir_chg = RAD2DEG * ( vtmp.y * etmp.x
+              //                               - vtmp.x * etmp.y ) / actual_dist;
+              *dir_chg = vtmp.y * etmp.x - vtmp.x * etmp.y;
+              *dir_chg /= actual_dist;
+              *dir_chg *= RAD2DEG;
+
+              *dir_chg = ( *dir_chg == 0.0
+                           ? 0.0
+                           : Quantize( *dir_chg, observer().dirQStep() ) );
+              *dist_chg = noisy_dist * Quantize( *dist_chg / actual_dist, 0.02 );
+          }
+          else
+          {
+              *dir_chg = 0.0;
+              *dist_chg = 0.0;
+          }
+      }
+};
+
+
+/**
+ * @class GaussianObservation
+ * @brief Represents a Gaussian observation model for player observations.
+ *
+ * The GaussianObservation class is a concrete implementation of the NoisyObservation class.
+ * It calculates the noisy distance and velocity changes based on the actual distance and focus distance.
+ * The noise rates are determined by the player's type.
+ */
+class GaussianObservation
+    : public NoisyObservation {
+private:
+
+    GaussianObservation() = delete;
+
+public:
+    explicit
+    GaussianObservation( const Player & player )
+        : NoisyObservation( player )
+      { }
+
+
+    virtual
+    ~GaussianObservation() = default;
+
+private:
+    /**
+     * Calculates the distance with noise based on the actual distance, focus distance,
+     * distance noise rate, and focus distance noise rate.
+     *
+     * @param actual_dist The actual distance.
+     * @param focus_dist The focus distance.
+     * @param dist_noise_rate The distance noise rate.
+     * @param focus_dist_noise_rate The focus distance noise rate.
+     * @return he observed distance calculated based on the given parameters.
+     */
+    double calcDistImpl( const double actual_dist,
+                         const double focus_dist,
+                         const double dist_noise_rate,
+                         const double focus_dist_noise_rate ) const
+      {
+          const double std_dev = actual_dist * dist_noise_rate + focus_dist * focus_dist_noise_rate;
+
+          return std::max( 0.0, ndrand( actual_dist, std_dev ) );
+      }
+
+public:
+    double calcDist( const double actual_dist,
+                     const double focus_dist ) const override
+      {
+          return calcDistImpl( actual_dist,
+                               focus_dist,
+                               observer().playerType()->distNoiseRate(),
+                               observer().playerType()->focusDistNoiseRate() );
+      }
+
+    double calcDistLandmark( const double actual_dist,
+                             const double focus_dist ) const override
+      {
+          return calcDistImpl( actual_dist,
+                               focus_dist,
+                               observer().playerType()->landDistNoiseRate(),
+                               observer().playerType()->landFocusDistNoiseRate() );
+      }
+
+    void calcVel( const PVector & obj_vel,
+                  const PVector & obj_pos,
+                  const double actual_dist,
+                  const double noisy_dist,
+                  double * dist_chg,
+                  double * dir_chg ) const override
+      {
+          if ( actual_dist != 0.0 )
+          {
+              const PVector vtmp = obj_vel - observer().vel();
+              PVector etmp = ( obj_pos - observer().pos() ) /= actual_dist;
+
+              *dist_chg = vtmp.x * etmp.x + vtmp.y * etmp.y;
+              *dir_chg = vtmp.y * etmp.x - vtmp.x * etmp.y;
+              *dir_chg /= actual_dist;
+              *dir_chg *= RAD2DEG;
+
+              *dir_chg = ( *dir_chg == 0.0
+                           ? 0.0
+                           : Quantize( *dir_chg, observer().dirQStep() ) );
+              //*dist_chg += ( noisy_dist - actual_dist );
+              *dist_chg *= ( noisy_dist / actual_dist );
+              *dist_chg = Quantize( *dist_chg, 0.01 );
+          }
+          else
+          {
+              *dir_chg = 0.0;
+              *dist_chg = 0.0;
+          }
+      }
+};
+
+}
+
+#endif
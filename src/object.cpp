@@ -41,6 +41,7 @@
 
 #include "object.h"
 
+#include "checkpoint.h"
 #include "stadium.h"
 #include "param.h"
 #include "player.h"
@@ -401,6 +402,30 @@ MPObject::MPObject( Stadium & stadium,
     //M_weather = &( stadium->weather() );
 }
 
+void
+MPObject::saveState( rcss::CheckpointWriter & writer ) const
+{
+    writer.put( M_pos );
+    writer.put( M_enable );
+    writer.put( M_vel );
+    writer.put( M_accel );
+    writer.put( M_post_collision_pos );
+    writer.put( M_collision_count );
+    writer.put( M_collided );
+}
+
+void
+MPObject::loadState( rcss::CheckpointReader & reader )
+{
+    reader.get( M_pos );
+    reader.get( M_enable );
+    reader.get( M_vel );
+    reader.get( M_accel );
+    reader.get( M_post_collision_pos );
+    reader.get( M_collision_count );
+    reader.get( M_collided );
+}
+
 std::ostream &
 MPObject::print( std::ostream & o ) const
 {
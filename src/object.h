@@ -484,6 +484,11 @@ operator<<( std::ostream & o, const PObject & v )
 
 
 class Stadium;
+
+namespace rcss {
+class CheckpointWriter;
+class CheckpointReader;
+}
 //class Weather;
 
 class MPObject
@@ -599,6 +604,10 @@ public:
       }
     void moveToCollisionPos();
 
+    //! writes the kinematic and collision state for a checkpoint
+    void saveState( rcss::CheckpointWriter & writer ) const;
+    void loadState( rcss::CheckpointReader & reader );
+
     std::ostream & print( std::ostream & o ) const;
 
 
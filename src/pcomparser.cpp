@@ -23,13 +23,32 @@
 #include <config.h>
 #endif
 
-#include <sstream>
-
 #include "pcomparser.h"
 
+#include <cstring>
+
 namespace rcss {
 namespace pcom {
 
+namespace {
+
+/*!
+  \brief reads a message in place.  A string stream would copy every
+  message into a new string.
+*/
+class MessageBuf
+    : public std::streambuf {
+public:
+    explicit
+    MessageBuf( const char * msg )
+      {
+          char * begin = const_cast< char * >( msg );
+          setg( begin, begin, begin + std::strlen( msg ) );
+      }
+};
+
+}
+
 Parser::Parser( Builder & builder )
     : M_param( *this, builder ),
       M_parser( &RCSS_PCOM_parse )
@@ -40,7 +59,8 @@ Parser::Parser( Builder & builder )
 int
 Parser::parse( const char * msg )
 {
-    std::istringstream strm( msg );
+    MessageBuf buf( msg );
+    std::istream strm( &buf );
 
     return ( rcss::Parser::parse( strm ) ? 0 : 1 );
 }
@@ -78,7 +78,9 @@ private:
     virtual
     bool doParse( std::istream & strm )
       {
-          M_param.getLexer().switch_streams( &strm, &std::cerr );
+          // restarting keeps the input buffer of the lexer, while
+          // switch_streams() allocated a new one for every message
+          M_param.getLexer().yyrestart( &strm );
           return M_parser( M_param ) == 0;
       }
 
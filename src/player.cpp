@@ -36,8 +36,11 @@
 #include "serverparam.h"
 #include "playerparam.h"
 #include "utility.h"
+#include "checkpoint.h"
 
 #include "serializer.h"
+#include "serializerplayerbinary.h"
+#include "binaryprotocol.h"
 #include "initsenderplayer.h"
 #include "bodysender.h"
 #include "fullstatesender.h"
@@ -160,6 +163,7 @@ Player::Player( Stadium & stadium,
       M_parser( *this ),
       //
       M_version( 3.0 ),
+      M_binary( false ),
       M_team( team ),
       M_side( team->side() ),
       M_unum( number ),
@@ -304,6 +308,7 @@ Player::init( const double ver,
               const bool goalie )
 {
     M_version = ver;
+    M_binary = false;
     M_goalie = goalie;
 
     setEnable();
@@ -528,6 +533,18 @@ void
 Player::parseMsg( char * msg,
                   const size_t & len )
 {
+    if ( M_binary
+         && len > 0
+         && static_cast< unsigned char >( msg[0] ) == rcss::binary::MAGIC )
+    {
+        // binary commands are not written to the text player log.
+        if ( ! parseBinaryCommand( msg, len ) )
+        {
+            send( "(error illegal_command_form)" );
+        }
+        return;
+    }
+
     char * command = msg;
     if ( command[ len - 1 ] != 0 )
     {
@@ -927,6 +944,135 @@ Player::parseCommand( const char * command )
     return ( count > 0 );
 }
 
+bool
+Player::parseBinaryCommand( const char * msg,
+                            const size_t len )
+{
+    rcss::binary::Reader reader( msg, len );
+    if ( reader.error()
+         || reader.kind() != rcss::binary::COMMAND )
+    {
+        std::cerr << "Error parsing binary command. kind=" << reader.kind() << '\n';
+        return false;
+    }
+
+    rcss::binary::Record rec;
+    while ( reader.next( rec ) )
+    {
+        double a = 0.0, b = 0.0;
+        bool ok = true;
+
+        switch ( rec.tag() ) {
+        case rcss::binary::CMD_DASH:
+            ok = rec.readF32( a );
+            if ( ok && rec.readF32( b ) )
+            {
+                dash( a, b );
+            }
+            else if ( ok )
+            {
+                dash( a );
+            }
+            break;
+        case rcss::binary::CMD_TURN:
+            ok = rec.readF32( a );
+            if ( ok ) turn( a );
+            break;
+        case rcss::binary::CMD_TURN_NECK:
+            ok = rec.readF32( a );
+            if ( ok ) turn_neck( a );
+            break;
+        case rcss::binary::CMD_KICK:
+            ok = rec.readF32( a ) && rec.readF32( b );
+            if ( ok ) kick( a, b );
+            break;
+        case rcss::binary::CMD_LONG_KICK:
+            ok = rec.readF32( a ) && rec.readF32( b );
+            if ( ok ) long_kick( a, b );
+            break;
+        case rcss::binary::CMD_CATCH:
+            ok = rec.readF32( a );
+            if ( ok ) goalieCatch( a );
+            break;
+        case rcss::binary::CMD_MOVE:
+            ok = rec.readF32( a ) && rec.readF32( b );
+            if ( ok ) move( a, b );
+            break;
+        case rcss::binary::CMD_TACKLE: {
+            int foul = 0;
+            ok = rec.readF32( a );
+            if ( ok && rec.readU8( foul ) )
+            {
+                tackle( a, foul != 0 );
+            }
+            else if ( ok )
+            {
+                tackle( a );
+            }
+            break;
+        }
+        case rcss::binary::CMD_CHANGE_FOCUS:
+            ok = rec.readF32( a ) && rec.readF32( b );
+            if ( ok ) change_focus( a, b );
+            break;
+        case rcss::binary::CMD_POINTTO:
+            if ( rec.size() == 0 )
+            {
+                pointto( false, 0.0, 0.0 );
+            }
+            else
+            {
+                ok = rec.readF32( a ) && rec.readF32( b );
+                if ( ok ) pointto( true, a, b );
+            }
+            break;
+        case rcss::binary::CMD_CHANGE_VIEW: {
+            int width = 0, quality = 0;
+            ok = rec.readU8( width ) && width <= rcss::pcom::WIDE;
+            if ( ok && rec.readU8( quality ) )
+            {
+                change_view( static_cast< rcss::pcom::VIEW_WIDTH >( width ),
+                             quality != 0 ? rcss::pcom::HIGH : rcss::pcom::LOW );
+            }
+            else if ( ok )
+            {
+                change_view( static_cast< rcss::pcom::VIEW_WIDTH >( width ) );
+            }
+            break;
+        }
+        case rcss::binary::CMD_SAY: {
+            std::string message;
+            ok = rec.readString( message );
+            if ( ok ) say( message );
+            break;
+        }
+        case rcss::binary::CMD_SENSE_BODY:
+            sense_body();
+            break;
+        case rcss::binary::CMD_SCORE:
+            score();
+            break;
+        case rcss::binary::CMD_DONE:
+            done();
+            break;
+        case rcss::binary::CMD_BYE:
+            bye();
+            break;
+        default:
+            std::cerr << "Unknown binary command. tag=" << rec.tag() << '\n';
+            return false;
+        }
+
+        if ( ! ok )
+        {
+            std::cerr << "Error parsing binary command. tag=" << rec.tag() << '\n';
+            return false;
+        }
+    }
+
+    return ! reader.error();
+}
+
 int
 Player::parseEar( const char * command )
 {
@@ -1716,6 +1862,7 @@ void
 Player::sense_body()
 {
     M_body_observer->sendBody();
+    latency().sensorSent();
 }
 
 void
@@ -1956,6 +2103,7 @@ void
 Player::done()
 {
     M_done_received = true;
+    latency().doneReceived();
 }
 
 void
@@ -2416,6 +2564,7 @@ Player::sendVisual()
     if ( ! M_synch_see )
     {
         M_observer->sendVisual();
+        latency().sensorSent();
     }
 }
 
@@ -2425,6 +2574,7 @@ Player::sendSynchVisual()
     if ( M_synch_see )
     {
         M_observer->sendVisual();
+        latency().sensorSent();
     }
 }
 
@@ -2435,6 +2585,13 @@ Player::sendFullstate()
     M_fullstate_observer->sendFullState();
 }
 
+void
+Player::sendHFOFeatures( const std::vector< float > & features )
+{
+    M_serializer->serializeHFOFeatures( getTransport(), M_stadium.time(), features );
+    getTransport() << std::ends << std::flush;
+}
+
 bool
 Player::setSenders()
 {
@@ -2446,12 +2603,15 @@ Player::setSenders()
         return false;
     }
 
-    const rcss::SerializerPlayer::Ptr ser = ser_cre();
+    const rcss::SerializerPlayer::Ptr ser = ( M_binary
+                                              ? rcss::SerializerPlayerBinary::create()
+                                              : ser_cre() );
     if ( ! ser )
     {
         std::cerr << "No SerializerPlayer v" << version() << std::endl;
         return false;
     }
+    M_serializer = ser;
 
     rcss::BodySenderPlayer::Params body_params( getTransport(),
                                                 *this,
@@ -2523,6 +2683,27 @@ Player::setSenders()
     return true;
 }
 
+bool
+Player::useBinaryProtocol()
+{
+    if ( version() < 18.0 )
+    {
+        std::cerr << "Binary protocol requires version 18 or later. v"
+                  << version() << std::endl;
+        return false;
+    }
+
+    M_binary = true;
+    if ( ! setSenders() )
+    {
+        M_binary = false;
+        setSenders();
+        return false;
+    }
+
+    return true;
+}
+
 void
 Player::turnImpl()
 {
@@ -2604,6 +2785,188 @@ Player::focusPoint() const
                                        normalize_angle( angleBodyCommitted() + angleNeckCommitted() + focusDir() ) );
 }
 
+namespace {
+
+void
+save_leg( rcss::CheckpointWriter & writer,
+          const Leg & leg )
+{
+    writer.put( leg.commandType() );
+    writer.put( leg.kickPower() );
+    writer.put( leg.kickDir() );
+    writer.put( leg.dashPower() );
+    writer.put( leg.dashDir() );
+}
+
+void
+load_leg( rcss::CheckpointReader & reader,
+          Leg & leg )
+{
+    const Leg::CommandType type = reader.get< Leg::CommandType >();
+    const double kick_power = reader.get< double >();
+    const double kick_dir = reader.get< double >();
+    const double dash_power = reader.get< double >();
+    const double dash_dir = reader.get< double >();
+    leg.restore( type, kick_power, kick_dir, dash_power, dash_dir );
+}
+
+}
+
+void
+Player::saveState( rcss::CheckpointWriter & writer ) const
+{
+    MPObject::saveState( writer );
+
+    writer.put( M_player_type_id );
+    writer.put( M_substituted );
+    writer.put( M_kick_rand );
+    writer.put( M_goalie );
+
+    writer.put( M_state );
+    writer.put( M_card_count );
+
+    writer.put( M_high_quality );
+    writer.put( M_visible_angle );
+    writer.put( M_view_width );
+
+    writer.put( M_hear_capacity_from_teammate );
+    writer.put( M_hear_capacity_from_opponent );
+
+    writer.put( M_stamina );
+    writer.put( M_recovery );
+    writer.put( M_effort );
+    writer.put( M_stamina_capacity );
+    writer.put( M_consumed_stamina );
+
+    writer.put( M_angle_body );
+    writer.put( M_angle_body_committed );
+    writer.put( M_angle_neck );
+    writer.put( M_angle_neck_committed );
+    writer.put( M_focus_dist );
+    writer.put( M_focus_dir );
+
+    writer.put( M_ball_collide );
+    writer.put( M_player_collide );
+    writer.put( M_post_collide );
+
+    writer.put( M_command_done );
+    writer.put( M_turn_neck_done );
+    writer.put( M_done_received );
+
+    writer.put( M_goalie_catch_ban );
+    writer.put( M_goalie_moves_since_catch );
+    writer.put( M_kick_cycles );
+    writer.put( M_dash_cycles );
+
+    writer.put( M_kick_count );
+    writer.put( M_dash_count );
+    writer.put( M_turn_count );
+    writer.put( M_catch_count );
+    writer.put( M_move_count );
+    writer.put( M_turn_neck_count );
+    writer.put( M_change_focus_count );
+    writer.put( M_change_view_count );
+    writer.put( M_say_count );
+
+    save_leg( writer, M_left_leg );
+    save_leg( writer, M_right_leg );
+
+    writer.put( M_arm.dest() );
+    writer.put( M_arm.timer() );
+    writer.put( M_arm.getCounter() );
+
+    writer.put( M_attentionto_count );
+    writer.put( M_tackle_cycles );
+    writer.put( M_tackle_count );
+    writer.put( M_foul_cycles );
+    writer.put( M_foul_count );
+
+    writer.put( M_long_kick_power );
+    writer.put( M_long_kick_dir );
+}
+
+void
+Player::loadState( rcss::CheckpointReader & reader )
+{
+    MPObject::loadState( reader );
+
+    const int type = reader.get< int >();
+    if ( ! M_stadium.playerType( type ) )
+    {
+        reader.fail();
+        return;
+    }
+    // the size, decay and speed limits follow the type
+    setPlayerType( type );
+
+    reader.get( M_substituted );
+    reader.get( M_kick_rand );
+    reader.get( M_goalie );
+
+    reader.get( M_state );
+    reader.get( M_card_count );
+
+    reader.get( M_high_quality );
+    reader.get( M_visible_angle );
+    reader.get( M_view_width );
+
+    reader.get( M_hear_capacity_from_teammate );
+    reader.get( M_hear_capacity_from_opponent );
+
+    reader.get( M_stamina );
+    reader.get( M_recovery );
+    reader.get( M_effort );
+    reader.get( M_stamina_capacity );
+    reader.get( M_consumed_stamina );
+
+    reader.get( M_angle_body );
+    reader.get( M_angle_body_committed );
+    reader.get( M_angle_neck );
+    reader.get( M_angle_neck_committed );
+    reader.get( M_focus_dist );
+    reader.get( M_focus_dir );
+
+    reader.get( M_ball_collide );
+    reader.get( M_player_collide );
+    reader.get( M_post_collide );
+
+    reader.get( M_command_done );
+    reader.get( M_turn_neck_done );
+    reader.get( M_done_received );
+
+    reader.get( M_goalie_catch_ban );
+    reader.get( M_goalie_moves_since_catch );
+    reader.get( M_kick_cycles );
+    reader.get( M_dash_cycles );
+
+    reader.get( M_kick_count );
+    reader.get( M_dash_count );
+    reader.get( M_turn_count );
+    reader.get( M_catch_count );
+    reader.get( M_move_count );
+    reader.get( M_turn_neck_count );
+    reader.get( M_change_focus_count );
+    reader.get( M_change_view_count );
+    reader.get( M_say_count );
+
+    load_leg( reader, M_left_leg );
+    load_leg( reader, M_right_leg );
+
+    const rcss::geom::Vector2D arm_dest = reader.get< rcss::geom::Vector2D >();
+    const unsigned int arm_timer = reader.get< unsigned int >();
+    const unsigned int arm_count = reader.get< unsigned int >();
+    M_arm.restore( arm_dest, arm_timer, arm_count );
+
+    reader.get( M_attentionto_count );
+    reader.get( M_tackle_cycles );
+    reader.get( M_tackle_count );
+    reader.get( M_foul_cycles );
+    reader.get( M_foul_count );
+
+    reader.get( M_long_kick_power );
+    reader.get( M_long_kick_dir );
+}
+
 void
 Player::recoverAll()
 {
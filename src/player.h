@@ -31,7 +31,9 @@
 #include "remoteclient.h"
 #include "serverparam.h"
 #include "heteroplayer.h"
+#include <memory>
 #include <string>
+#include <vector>
 
 class Stadium;
 class HeteroPlayer;
@@ -42,6 +44,7 @@ class InitObserverPlayer;
 class ObserverPlayer;
 class BodyObserverPlayer;
 class FullStateObserver;
+class SerializerPlayer;
 }
 
 class Player
@@ -67,6 +70,8 @@ private:
     // client settings
     //
     double M_version; //!< client protocol version
+    std::shared_ptr< rcss::SerializerPlayer > M_serializer;
+    bool M_binary; //!< sensors and commands in the binary protocol
 
     Team * M_team;
     const Side M_side;
@@ -214,6 +219,12 @@ public:
     void initObservationMode();
     bool setSenders();
 
+    /*!
+      \brief switch the sensors to the binary protocol and accept
+      binary commands. requires version 18 or later.
+    */
+    bool useBinaryProtocol();
+
     void setEnable();
     void disable();
     void discard();
@@ -239,11 +250,13 @@ public:
     void sendVisual();
     void sendSynchVisual();
     void sendFullstate(); /* contributed by Artur Merke */
+    void sendHFOFeatures( const std::vector< float > & features );
 
     //
     // client settings
     //
     const double & version() const { return M_version; }
+    bool isBinaryProtocol() const { return M_binary; }
 
     const Team * team() const { return M_team; }
     Side side() const { return M_side; }
@@ -375,6 +388,16 @@ public:
     const double & recovery() const { return M_recovery; }
     const double & effort() const { return M_effort; }
     const double & staminaCapacity() const { return M_stamina_capacity; }
+    void setStamina( const double & stamina )
+      {
+          M_stamina = rcss::bound( 0.0, stamina, ServerParam::instance().staminaMax() );
+      }
+
+    //
+    // checkpoint
+    //
+    void saveState( rcss::CheckpointWriter & writer ) const;
+    void loadState( rcss::CheckpointReader & reader );
 
     //
     // leg
@@ -483,6 +506,8 @@ private:
 
 
     bool parseCommand( const char * command );
+    bool parseBinaryCommand( const char * msg,
+                             const size_t len );
     int parseEar( const char * command );
 
     /** PlayerCommands */
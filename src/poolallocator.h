@@ -0,0 +1,182 @@
+// -*-c++-*-
+
+/***************************************************************************
+                               poolallocator.h
+                 Allocator that recycles the nodes of containers
+                             -------------------
+    begin                : 2026-10-18
+    copyright            : (C) 2026 by The RoboCup Soccer Server
+                           Maintenance Group.
+    email                : sserver-admin@lists.sourceforge.net
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU LGPL as published by the Free Software  *
+ *   Foundation; either version 3 of the License, or (at your option) any  *
+ *   later version.                                                        *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef RCSS_POOLALLOCATOR_H
+#define RCSS_POOLALLOCATOR_H
+
+#include <cstddef>
+#include <new>
+
+namespace rcss {
+
+/*!
+  \class NodePool
+  \brief free lists for the nodes of the containers that are filled
+  and emptied every cycle, e.g. the messages that the listeners keep
+  until the next cycle.
+
+  The pool is owned by the object that owns the containers and must
+  outlive them.  The free nodes are given back to the heap when the pool
+  is destroyed, whichever thread released them.
+*/
+class NodePool {
+private:
+    struct Node {
+        Node * next_;
+    };
+
+    static const std::size_t GRANULARITY = alignof( std::max_align_t );
+    static const std::size_t MAX_NODE_SIZE = 16 * GRANULARITY;
+
+    Node * M_free[MAX_NODE_SIZE / GRANULARITY];
+
+    // not used
+    NodePool( const NodePool & ) = delete;
+    NodePool & operator=( const NodePool & ) = delete;
+
+    static
+    std::size_t index( const std::size_t size )
+      {
+          return ( size + GRANULARITY - 1 ) / GRANULARITY - 1;
+      }
+
+public:
+    NodePool()
+      {
+          for ( Node *& head : M_free )
+          {
+              head = nullptr;
+          }
+      }
+
+    ~NodePool()
+      {
+          for ( Node *& head : M_free )
+          {
+              while ( head )
+              {
+                  Node * n = head;
+                  head = n->next_;
+                  ::operator delete( n );
+              }
+          }
+      }
+
+    void * allocate( const std::size_t size )
+      {
+          if ( size == 0 || size > MAX_NODE_SIZE )
+          {
+              return ::operator new( size );
+          }
+
+          const std::size_t i = index( size );
+          Node * n = M_free[i];
+          if ( n )
+          {
+              M_free[i] = n->next_;
+              return n;
+          }
+
+          return ::operator new( ( i + 1 ) * GRANULARITY );
+      }
+
+    void deallocate( void * p,
+                     const std::size_t size ) noexcept
+      {
+          if ( size == 0 || size > MAX_NODE_SIZE )
+          {
+              ::operator delete( p );
+              return;
+          }
+
+          const std::size_t i = index( size );
+          Node * n = static_cast< Node * >( p );
+          n->next_ = M_free[i];
+          M_free[i] = n;
+      }
+};
+
+
+/*!
+  \class PoolAllocator
+  \brief an allocator for node based containers that takes its single
+  nodes from a NodePool, so a container that is filled and emptied
+  every cycle stops allocating once the largest cycle was seen.
+*/
+template< typename T >
+class PoolAllocator {
+private:
+    NodePool * M_pool;
+
+    template< typename U >
+    friend class PoolAllocator;
+
+public:
+    typedef T value_type;
+
+    explicit
+    PoolAllocator( NodePool & pool ) noexcept
+        : M_pool( &pool )
+      { }
+
+    template< typename U >
+    PoolAllocator( const PoolAllocator< U > & other ) noexcept
+        : M_pool( other.M_pool )
+      { }
+
+    T * allocate( const std::size_t n )
+      {
+          if ( n == 1 )
+          {
+              return static_cast< T * >( M_pool->allocate( sizeof( T ) ) );
+          }
+
+          return static_cast< T * >( ::operator new( n * sizeof( T ) ) );
+      }
+
+    void deallocate( T * p,
+                     const std::size_t n ) noexcept
+      {
+          if ( n == 1 )
+          {
+              M_pool->deallocate( p, sizeof( T ) );
+              return;
+          }
+
+          ::operator delete( p );
+      }
+
+    template< typename U >
+    bool operator==( const PoolAllocator< U > & other ) const noexcept
+      {
+          return M_pool == other.M_pool;
+      }
+
+    template< typename U >
+    bool operator!=( const PoolAllocator< U > & other ) const noexcept
+      {
+          return M_pool != other.M_pool;
+      }
+};
+
+}
+
+#endif
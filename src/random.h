@@ -43,16 +43,57 @@ private:
 
     DefaultRNG() = default;
 
+    //! the engine installed by a Scope in this thread, if any
+    static
+        Engine *&
+        current()
+    {
+        static thread_local Engine * s_current = nullptr;
+        return s_current;
+    }
+
 public:
     static
         // DefaultRNG & instance()
         Engine &
         instance()
     {
+        if ( current() )
+        {
+            return *current();
+        }
+
         static DefaultRNG the_instance;
         return the_instance.M_engine;
     }
 
+    /*!
+      \class Scope
+      \brief makes instance() return \p engine in this thread while
+      the scope lives, so that stadiums stepped in worker threads each
+      draw from their own engine.
+    */
+    class Scope {
+    private:
+        Engine * M_prev;
+
+        Scope( const Scope & ) = delete;
+        Scope & operator=( const Scope & ) = delete;
+
+    public:
+        explicit
+        Scope( Engine & engine )
+            : M_prev( current() )
+        {
+            current() = &engine;
+        }
+
+        ~Scope()
+        {
+            current() = M_prev;
+        }
+    };
+
     static
         // DefaultRNG & instance( const std::mt19937::result_type & value )
         Engine &
@@ -0,0 +1,136 @@
+/* -*-c-*- */
+
+/***************************************************************************
+                                 rcssbatch.h
+            C interface to batches of in-process HFO/keepaway fields
+                             -------------------
+    begin                : 2026-10-18
+    copyright            : (C) 2026 by The RoboCup Soccer Server
+                           Maintenance Group.
+    email                : sserver-admin@lists.sourceforge.net
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU LGPL as published by the Free Software  *
+ *   Foundation; either version 3 of the License, or (at your option) any  *
+ *   later version.                                                        *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef RCSSSERVER_RCSSBATCH_H
+#define RCSSSERVER_RCSSBATCH_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+  A batch owns a number of independent fields (envs) that run the HFO
+  or keepaway referee of the server without any networking, and steps
+  all of them in lockstep.  Every env has the same agents: the offense
+  (or keepers) first, then the defense (or takers), whose first player
+  is the goalie in HFO mode.
+
+  The arrays returned by the accessors stay valid until the batch is
+  destroyed and are rewritten by each rcss_batch_reset() and
+  rcss_batch_step():
+
+    observations  [env][agent][rcss_batch_observation_size()]
+                  the feature vector of rcss::binary::HFOFeature
+    rewards       [env][agent]
+    dones         [env]
+
+  The rewards follow the referee's status messages.  In HFO mode a GOAL
+  gives +1 to the offense and -1 to the defense, CAPTURED_BY_DEFENSE and
+  OUT_OF_BOUNDS the opposite, and OUT_OF_TIME nothing.  In keepaway mode
+  the keepers get +1 and the takers -1 for each cycle of play.
+
+  An env whose episode ended in a step reports done, and continues with
+  the next episode on the following step.  Once HFO_FINISHED was sent
+  (hfo_max_trials or hfo_max_frames), the env stays done.
+*/
+
+typedef struct rcss_batch rcss_batch;
+
+/*! the kind of an action, the first of its RCSS_BATCH_ACTION_SIZE floats */
+enum rcss_batch_action {
+    RCSS_BATCH_NOOP = 0,
+    RCSS_BATCH_DASH = 1, /*!< power, direction */
+    RCSS_BATCH_TURN = 2, /*!< moment */
+    RCSS_BATCH_KICK = 3  /*!< power, direction */
+};
+
+#define RCSS_BATCH_ACTION_SIZE 3
+
+/*!
+  \brief reads the server parameters from the command line options and
+  configuration files, like rcssserver does.  Must be called once before
+  the first batch is created.  hfo or keepaway mode is selected there.
+  \return 0 on success
+*/
+int rcss_batch_init( int argc, const char * const * argv );
+
+/*!
+  \brief creates \p num_envs envs stepped by \p num_threads threads.
+  Env i draws its random numbers from an engine seeded with \p seed + i.
+  \return NULL on error
+*/
+rcss_batch * rcss_batch_create( int num_envs,
+                                int offense,
+                                int defense,
+                                int num_threads,
+                                unsigned int seed );
+
+void rcss_batch_destroy( rcss_batch * batch );
+
+int rcss_batch_num_envs( const rcss_batch * batch );
+int rcss_batch_num_agents( const rcss_batch * batch );
+int rcss_batch_observation_size( void );
+
+/*! \brief starts a new episode in every env */
+void rcss_batch_reset( rcss_batch * batch );
+
+/*!
+  \brief applies \p actions, laid out as [env][agent][RCSS_BATCH_ACTION_SIZE],
+  and simulates one cycle of every env.
+*/
+void rcss_batch_step( rcss_batch * batch,
+                      const float * actions );
+
+const float * rcss_batch_observations( const rcss_batch * batch );
+const float * rcss_batch_rewards( const rcss_batch * batch );
+const unsigned char * rcss_batch_dones( const rcss_batch * batch );
+
+/*!
+  \brief saves the complete state of env \p env, including its random
+  engine, e.g. to branch several rollouts from one state.  The state
+  can be restored into any env of a batch with the same agents.
+  \return the size of the checkpoint, or 0 for an illegal env.  It is
+  copied to \p buffer only if \p size is large enough, so that a call
+  with a NULL buffer queries the size.
+*/
+size_t rcss_batch_checkpoint( rcss_batch * batch,
+                              int env,
+                              void * buffer,
+                              size_t size );
+
+/*!
+  \brief restores a checkpoint into env \p env and rewrites its part
+  of the arrays as rcss_batch_reset() does.  A truncated checkpoint,
+  or one of other agents, is refused and the env is left as it was.
+  \return 0 on success
+*/
+int rcss_batch_restore( rcss_batch * batch,
+                        int env,
+                        const void * buffer,
+                        size_t size );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,329 @@
+// -*-c++-*-
+
+/***************************************************************************
+                               rcssreplay.cpp
+                  Replays the clients of a capture file
+                             -------------------
+    begin                : 2026-10-18
+    copyright            : (C) 2026 by The RoboCup Soccer Server
+                           Maintenance Group.
+    email                : sserver-admin@lists.sourceforge.net
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU LGPL as published by the Free Software  *
+ *   Foundation; either version 3 of the License, or (at your option) any  *
+ *   later version.                                                        *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "capture.h"
+
+#include <rcss/net/udpsocket.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <set>
+#include <string>
+#include <vector>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+#include <poll.h>
+
+/*!
+  \class Replayer
+  \brief sends the inbound datagrams of a capture file to a server,
+  one socket per recorded client, at the recorded pace scaled by the
+  speed (0 is as fast as possible).  The datagrams that were sent to
+  the dedicated socket of a client go to the port that the new server
+  answers that client from.
+*/
+class Replayer {
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    struct ReplayClient {
+        rcss::net::UDPSocket socket_;
+        bool open_;
+        rcss::net::Addr::PortType dedicated_port_;
+
+        ReplayClient()
+            : open_( false ),
+              dedicated_port_( 0 )
+          { }
+    };
+
+    std::string M_server_host;
+    double M_speed;
+    bool M_keep_ports;
+
+    std::vector< ReplayClient > M_clients;
+    std::set< rcss::net::Addr::PortType > M_server_ports; //!< the well known ports
+
+    unsigned long M_sent;
+    unsigned long M_skipped;
+    unsigned long M_received;
+    unsigned long M_received_bytes;
+    unsigned long M_recorded_replies;
+
+public:
+    Replayer( const std::string & server_host,
+              const double speed,
+              const bool keep_ports )
+        : M_server_host( server_host ),
+          M_speed( speed ),
+          M_keep_ports( keep_ports ),
+          M_sent( 0 ),
+          M_skipped( 0 ),
+          M_received( 0 ),
+          M_received_bytes( 0 ),
+          M_recorded_replies( 0 )
+      { }
+
+    bool run( const std::string & path )
+      {
+          rcss::CaptureReader reader;
+          if ( ! reader.open( path ) )
+          {
+              return false;
+          }
+
+          const Clock::time_point start_time = Clock::now();
+
+          rcss::CaptureReader::Record rec;
+          while ( reader.next( rec ) )
+          {
+              if ( rec.direction_ != rcss::Capture::INBOUND )
+              {
+                  ++M_recorded_replies;
+                  continue;
+              }
+
+              if ( rec.port_ != 0 )
+              {
+                  M_server_ports.insert( rec.port_ );
+              }
+
+              ReplayClient * client = getClient( rec.client_, reader.clients()[rec.client_] );
+              if ( ! client )
+              {
+                  return false;
+              }
+
+              if ( M_speed > 0.0 )
+              {
+                  receive( start_time
+                           + std::chrono::nanoseconds( static_cast< long long >( rec.time_ / M_speed ) ) );
+              }
+              else
+              {
+                  receive( Clock::now() );
+              }
+
+              if ( rec.port_ == 0
+                   && client->dedicated_port_ == 0 )
+              {
+                  // the reply to the init may still be on its way
+                  const Clock::time_point until = Clock::now() + std::chrono::seconds( 1 );
+                  while ( client->dedicated_port_ == 0
+                          && Clock::now() < until )
+                  {
+                      receive( std::min( until, Clock::now() + std::chrono::milliseconds( 1 ) ) );
+                  }
+              }
+
+              const rcss::net::Addr::PortType port = ( rec.port_ != 0
+                                                       ? rec.port_
+                                                       : client->dedicated_port_ );
+              if ( port == 0 )
+              {
+                  ++M_skipped;
+                  continue;
+              }
+
+              rcss::net::Addr dest( port );
+              dest.setHost( M_server_host );
+              if ( client->socket_.send( rec.data_.data(), rec.data_.size(), dest ) == -1 )
+              {
+                  std::cerr << "Error sending to " << dest << ": "
+                            << std::strerror( errno ) << std::endl;
+                  ++M_skipped;
+                  continue;
+              }
+              ++M_sent;
+          }
+
+          // the answers to the last messages
+          receive( Clock::now() + std::chrono::seconds( 1 ) );
+
+          const double elapsed
+              = std::chrono::duration_cast< std::chrono::duration< double > >( Clock::now() - start_time ).count();
+
+          std::cout << "clients: " << M_clients.size() << '\n'
+                    << "sent: " << M_sent << " skipped: " << M_skipped << '\n'
+                    << "received: " << M_received << " (" << M_received_bytes << " bytes)"
+                    << " recorded: " << M_recorded_replies << '\n'
+                    << "elapsed: " << elapsed << " s" << std::endl;
+          return true;
+      }
+
+private:
+
+    ReplayClient * getClient( const std::uint16_t id,
+                              const rcss::net::Addr & recorded_addr )
+      {
+          if ( M_clients.size() <= id )
+          {
+              M_clients.resize( id + 1 );
+          }
+
+          ReplayClient & client = M_clients[id];
+          if ( client.open_ )
+          {
+              return &client;
+          }
+
+          if ( ! client.socket_.open()
+               || client.socket_.setNonBlocking() < 0 )
+          {
+              std::cerr << "Error opening socket: "
+                        << std::strerror( errno ) << std::endl;
+              return nullptr;
+          }
+
+          // impersonate the recorded port when it is free on this host
+          if ( ! M_keep_ports
+               || ! client.socket_.bind( rcss::net::Addr( recorded_addr.getPort() ) ) )
+          {
+              if ( ! client.socket_.bind( rcss::net::Addr() ) )
+              {
+                  std::cerr << "Error binding socket: "
+                            << std::strerror( errno ) << std::endl;
+                  return nullptr;
+              }
+          }
+
+          client.open_ = true;
+          return &client;
+      }
+
+    void receive( const Clock::time_point & until )
+      {
+          std::vector< pollfd > fds;
+          std::vector< ReplayClient * > owners;
+          for ( ReplayClient & c : M_clients )
+          {
+              if ( ! c.open_ ) continue;
+
+              pollfd fd;
+              fd.fd = c.socket_.getFD();
+              fd.events = POLLIN;
+              fd.revents = 0;
+              fds.push_back( fd );
+              owners.push_back( &c );
+          }
+
+          do
+          {
+              const long long timeout
+                  = std::chrono::duration_cast< std::chrono::milliseconds >( until - Clock::now() ).count();
+              if ( ::poll( fds.data(), fds.size(),
+                           static_cast< int >( std::max( timeout, 0LL ) ) ) <= 0 )
+              {
+                  continue;
+              }
+
+              for ( size_t i = 0; i < fds.size(); ++i )
+              {
+                  if ( fds[i].revents & POLLIN )
+                  {
+                      drain( *owners[i] );
+                  }
+              }
+          }
+          while ( Clock::now() < until );
+      }
+
+    void drain( ReplayClient & client )
+      {
+          char buf[8192];
+          rcss::net::Addr from;
+          int len = 0;
+          while ( ( len = client.socket_.recv( buf, sizeof( buf ), from ) ) > 0 )
+          {
+              ++M_received;
+              M_received_bytes += len;
+
+              if ( client.dedicated_port_ == 0
+                   && M_server_ports.find( from.getPort() ) == M_server_ports.end() )
+              {
+                  client.dedicated_port_ = from.getPort();
+              }
+          }
+      }
+};
+
+
+int
+main( int argc, char **argv )
+{
+    std::string server = "localhost";
+    double speed = 1.0;
+    bool keep_ports = false;
+    std::string path;
+
+    for ( int i = 1; i < argc; ++i )
+    {
+        if ( std::strcmp( argv[ i ], "-server" ) == 0 )
+        {
+            if ( i + 1 < argc )
+            {
+                server = argv[ i + 1 ];
+                ++i;
+            }
+        }
+        else if ( std::strcmp( argv[ i ], "-speed" ) == 0 )
+        {
+            if ( i + 1 < argc )
+            {
+                speed = std::atof( argv[ i + 1 ] );
+                ++i;
+            }
+        }
+        else if ( std::strcmp( argv[ i ], "-max" ) == 0 )
+        {
+            speed = 0.0;
+        }
+        else if ( std::strcmp( argv[ i ], "-keep_ports" ) == 0 )
+        {
+            keep_ports = true;
+        }
+        else
+        {
+            path = argv[ i ];
+        }
+    }
+
+    if ( path.empty() )
+    {
+        std::cerr << "Usage: " << argv[0]
+                  << " [-server HOST] [-speed N | -max] [-keep_ports] CAPTURE_FILE\n"
+                  << "  -speed N      replays N times faster than recorded (default 1)\n"
+                  << "  -max          replays as fast as possible\n"
+                  << "  -keep_ports   sends from the recorded client ports if they are free"
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    Replayer replayer( server, speed, keep_ports );
+    return ( replayer.run( path ) ? EXIT_SUCCESS : EXIT_FAILURE );
+}
@@ -0,0 +1,646 @@
+// -*-c++-*-
+
+/***************************************************************************
+                               rcssrouter.cpp
+              A router that fronts many matches on one port triple
+                             -------------------
+    begin                : 2026-10-18
+    copyright            : (C) 2026 by The RoboCup Soccer Server
+                           Maintenance Group.
+    email                : sserver-admin@lists.sourceforge.net
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU LGPL as published by the Free Software  *
+ *   Foundation; either version 3 of the License, or (at your option) any  *
+ *   later version.                                                        *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <rcss/net/udpsocket.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+enum Channel {
+    PLAYER = 0,
+    OFFLINE_COACH = 1,
+    ONLINE_COACH = 2,
+    CHANNELS = 3,
+};
+
+/*!
+  \brief a match behind the router.  Its ports are the player port and
+  the two next ones, as in the default server configuration.
+*/
+struct Match {
+    std::string name_;
+    rcss::net::Addr addr_[CHANNELS];
+    std::vector< std::string > teams_; //!< the teams assigned so far, at most two
+    unsigned long sessions_;
+
+    Match()
+        : sessions_( 0 )
+      { }
+};
+
+struct Session;
+
+/*!
+  \brief what an epoll event refers to: a well known port, or the front
+  or back socket of a session.
+*/
+struct Endpoint {
+    enum Type { LISTEN, FRONT, BACK } type_;
+    Channel channel_;
+    Session * session_;
+};
+
+/*!
+  \brief the two sockets that relay one client.  The front socket is
+  the dedicated port the client sees, the back socket talks to the
+  match, which answers it from its own dedicated socket.
+*/
+struct Session {
+    size_t match_;
+    rcss::net::Addr client_;
+    rcss::net::UDPSocket front_;
+    rcss::net::UDPSocket back_;
+    Endpoint front_endpoint_;
+    Endpoint back_endpoint_;
+    rcss::net::Addr match_dest_; //!< the well known port until the match answers
+    bool dedicated_;
+    std::chrono::steady_clock::time_point last_time_;
+};
+
+std::uint64_t
+addr_key( const rcss::net::Addr & addr )
+{
+    return ( static_cast< std::uint64_t >( addr.getHost() ) << 16 ) | addr.getPort();
+}
+
+/*!
+  \brief raises the soft limit of open files to the hard limit.  Each
+  client takes two sockets, so the usual soft limit of 1024 would stop
+  the router at about 500 clients.
+*/
+void
+raise_file_limit()
+{
+#ifdef __linux__
+    struct rlimit lim;
+    if ( ::getrlimit( RLIMIT_NOFILE, &lim ) != 0 )
+    {
+        std::cerr << "Error getting the open file limit: "
+                  << std::strerror( errno ) << std::endl;
+        return;
+    }
+
+    if ( lim.rlim_cur < lim.rlim_max )
+    {
+        const rlim_t soft = lim.rlim_cur;
+        lim.rlim_cur = lim.rlim_max;
+        if ( ::setrlimit( RLIMIT_NOFILE, &lim ) != 0 )
+        {
+            std::cerr << "Error raising the open file limit: "
+                      << std::strerror( errno ) << std::endl;
+            lim.rlim_cur = soft;
+        }
+    }
+
+    std::cout << "Open file limit: " << lim.rlim_cur << std::endl;
+#endif
+}
+
+volatile std::sig_atomic_t g_quit = 0;
+
+void
+sig_exit_handle( int )
+{
+    g_quit = 1;
+}
+
+}
+
+/*!
+  \class Router
+  \brief listens on one player/coach/online coach port triple and relays
+  every client to the match its handshake is assigned to.
+
+  A handshake may start with "(match NAME)" to choose the match
+  explicitly.  Otherwise a team name goes to the match it was assigned
+  to before, or to the first match with a free team slot, and monitors
+  and trainers go to the first match.  All sockets are served by one
+  epoll loop, so relaying a datagram takes no lock.
+
+  The router relays for the whole session instead of handing the client
+  off.  A client talks to the address that answered its init, and only
+  the match can answer from its dedicated socket, so a handoff needs a
+  redirect that the existing clients do not understand.  The relay keeps
+  them unchanged at the cost of two sockets per client and one extra
+  hop per datagram, see raise_file_limit().
+*/
+class Router {
+private:
+    rcss::net::UDPSocket M_listen[CHANNELS];
+    Endpoint M_listen_endpoints[CHANNELS];
+    std::vector< Match > M_matches;
+    std::unordered_map< std::uint64_t, std::unique_ptr< Session > > M_sessions[CHANNELS];
+    std::unordered_map< std::string, size_t > M_team_matches;
+
+    int M_epoll_fd;
+    std::chrono::seconds M_idle_timeout;
+
+    rcss::net::Addr M_from; //!< the source of the last datagram received
+
+    unsigned long M_relayed;
+    unsigned long M_rejected;
+
+public:
+    explicit
+    Router( const int idle_timeout )
+        : M_epoll_fd( -1 ),
+          M_idle_timeout( idle_timeout ),
+          M_relayed( 0 ),
+          M_rejected( 0 )
+      { }
+
+    ~Router()
+      {
+#ifdef __linux__
+          if ( M_epoll_fd >= 0 )
+          {
+              ::close( M_epoll_fd );
+          }
+#endif
+      }
+
+    //! NAME:HOST:PORT[:TEAM[,TEAM]]
+    bool addMatch( const std::string & spec )
+      {
+          std::vector< std::string > fields;
+          std::istringstream is( spec );
+          std::string field;
+          while ( std::getline( is, field, ':' ) )
+          {
+              fields.push_back( field );
+          }
+
+          if ( fields.size() < 3 || fields.size() > 4
+               || fields[0].empty() )
+          {
+              std::cerr << "Illegal match: " << spec << std::endl;
+              return false;
+          }
+
+          Match m;
+          m.name_ = fields[0];
+          const int port = std::atoi( fields[2].c_str() );
+          for ( int c = 0; c < CHANNELS; ++c )
+          {
+              m.addr_[c] = rcss::net::Addr( static_cast< rcss::net::Addr::PortType >( port + c ) );
+              if ( port <= 0
+                   || ! m.addr_[c].setHost( fields[1] ) )
+              {
+                  std::cerr << "Illegal match address: " << spec << std::endl;
+                  return false;
+              }
+          }
+
+          if ( fields.size() == 4 )
+          {
+              std::istringstream teams( fields[3] );
+              std::string team;
+              while ( std::getline( teams, team, ',' ) )
+              {
+                  if ( m.teams_.size() >= 2 )
+                  {
+                      std::cerr << "A match has two teams: " << spec << std::endl;
+                      return false;
+                  }
+                  M_team_matches[team] = M_matches.size();
+                  m.teams_.push_back( team );
+              }
+          }
+
+          M_matches.push_back( m );
+          return true;
+      }
+
+    bool open( const int port )
+      {
+#ifdef __linux__
+          if ( M_matches.empty() )
+          {
+              std::cerr << "No match to route to" << std::endl;
+              return false;
+          }
+
+          M_epoll_fd = ::epoll_create1( 0 );
+          if ( M_epoll_fd < 0 )
+          {
+              std::cerr << "Error creating epoll: " << std::strerror( errno ) << std::endl;
+              return false;
+          }
+
+          for ( int c = 0; c < CHANNELS; ++c )
+          {
+              if ( ! M_listen[c].open()
+                   || ! M_listen[c].bind( rcss::net::Addr( static_cast< rcss::net::Addr::PortType >( port + c ) ) )
+                   || M_listen[c].setNonBlocking() < 0 )
+              {
+                  std::cerr << "Error binding port " << port + c << ": "
+                            << std::strerror( errno ) << std::endl;
+                  return false;
+              }
+
+              M_listen_endpoints[c] = Endpoint{ Endpoint::LISTEN, static_cast< Channel >( c ), nullptr };
+              if ( ! watch( M_listen[c].getFD(), &M_listen_endpoints[c] ) )
+              {
+                  return false;
+              }
+          }
+          return true;
+#else
+          (void)port;
+          std::cerr << "rcssrouter needs epoll, which is only available on Linux" << std::endl;
+          return false;
+#endif
+      }
+
+    void run()
+      {
+#ifdef __linux__
+          const int MAX_EVENTS = 256;
+          epoll_event events[MAX_EVENTS];
+          std::chrono::steady_clock::time_point next_expire = std::chrono::steady_clock::now() + M_idle_timeout;
+
+          while ( ! g_quit )
+          {
+              const int n = ::epoll_wait( M_epoll_fd, events, MAX_EVENTS, 1000 );
+              if ( n < 0 && errno != EINTR )
+              {
+                  std::cerr << "Error waiting for events: " << std::strerror( errno ) << std::endl;
+                  break;
+              }
+
+              for ( int i = 0; i < n; ++i )
+              {
+                  Endpoint * e = static_cast< Endpoint * >( events[i].data.ptr );
+                  switch ( e->type_ ) {
+                  case Endpoint::LISTEN:
+                      recvListen( e->channel_ );
+                      break;
+                  case Endpoint::FRONT:
+                      recvFront( *e->session_ );
+                      break;
+                  case Endpoint::BACK:
+                      recvBack( *e->session_ );
+                      break;
+                  }
+              }
+
+              const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+              if ( now >= next_expire )
+              {
+                  expireSessions( now );
+                  next_expire = now + M_idle_timeout;
+              }
+          }
+
+          size_t sessions = 0;
+          for ( int c = 0; c < CHANNELS; ++c )
+          {
+              sessions += M_sessions[c].size();
+          }
+          std::cout << "(router (sessions " << sessions << ") (relayed " << M_relayed
+                    << ") (rejected " << M_rejected << "))" << std::endl;
+          for ( const Match & m : M_matches )
+          {
+              std::cout << "(match " << m.name_ << " (sessions " << m.sessions_ << ')';
+              for ( const std::string & t : m.teams_ )
+              {
+                  std::cout << ' ' << t;
+              }
+              std::cout << ')' << std::endl;
+          }
+#endif
+      }
+
+private:
+
+#ifdef __linux__
+    bool watch( const int fd,
+                Endpoint * endpoint )
+      {
+          epoll_event ev;
+          std::memset( &ev, 0, sizeof( ev ) );
+          ev.events = EPOLLIN;
+          ev.data.ptr = endpoint;
+          if ( ::epoll_ctl( M_epoll_fd, EPOLL_CTL_ADD, fd, &ev ) != 0 )
+          {
+              std::cerr << "Error watching a socket: " << std::strerror( errno ) << std::endl;
+              return false;
+          }
+          return true;
+      }
+#endif
+
+    //! the match of a handshake, or -1.  \p msg is advanced past a (match NAME) prefix.
+    int route( const Channel channel,
+               const char * & msg )
+      {
+          char name[128];
+          int n = 0;
+          if ( std::sscanf( msg, " ( match %127[^ ()] ) %n", name, &n ) == 1
+               && n > 0 )
+          {
+              msg += n;
+              for ( size_t i = 0; i < M_matches.size(); ++i )
+              {
+                  if ( M_matches[i].name_ == name )
+                  {
+                      return static_cast< int >( i );
+                  }
+              }
+              return -1;
+          }
+
+          char team[128];
+          if ( channel == OFFLINE_COACH
+               || ( std::sscanf( msg, " ( init %127[^ ()]", team ) != 1
+                    && std::sscanf( msg, " ( reconnect %127[^ ()]", team ) != 1 )
+               || ! std::strncmp( msg, "(dispinit", 9 ) )
+          {
+              // monitors and trainers without a token
+              return 0;
+          }
+
+          std::unordered_map< std::string, size_t >::const_iterator it = M_team_matches.find( team );
+          if ( it != M_team_matches.end() )
+          {
+              return static_cast< int >( it->second );
+          }
+
+          for ( size_t i = 0; i < M_matches.size(); ++i )
+          {
+              if ( M_matches[i].teams_.size() < 2 )
+              {
+                  M_matches[i].teams_.push_back( team );
+                  M_team_matches[team] = i;
+                  std::cout << "Team " << team << " assigned to match "
+                            << M_matches[i].name_ << std::endl;
+                  return static_cast< int >( i );
+              }
+          }
+          return -1;
+      }
+
+    void recvListen( const Channel channel )
+      {
+          char buf[8192];
+          rcss::net::Addr & from = M_from;
+          int len = 0;
+          while ( ( len = M_listen[channel].recv( buf, sizeof( buf ) - 1, from ) ) > 0 )
+          {
+              buf[len] = '\0';
+
+              std::unordered_map< std::uint64_t, std::unique_ptr< Session > >::iterator
+                  it = M_sessions[channel].find( addr_key( from ) );
+              if ( it != M_sessions[channel].end() )
+              {
+                  // an undedicated message of a known client
+                  Session & s = *it->second;
+                  s.back_.send( buf, len, M_matches[s.match_].addr_[channel] );
+                  s.last_time_ = std::chrono::steady_clock::now();
+                  ++M_relayed;
+                  continue;
+              }
+
+              const char * msg = buf;
+              const int match = route( channel, msg );
+              if ( match < 0 )
+              {
+                  const char err[] = "(error no_match_for_client)";
+                  M_listen[channel].send( err, sizeof( err ), from );
+                  ++M_rejected;
+                  continue;
+              }
+
+              Session * s = openSession( channel, from, match );
+              if ( ! s )
+              {
+                  ++M_rejected;
+                  continue;
+              }
+
+              s->back_.send( msg, len - ( msg - buf ), s->match_dest_ );
+              ++M_relayed;
+          }
+      }
+
+    Session * openSession( const Channel channel,
+                           const rcss::net::Addr & client,
+                           const size_t match )
+      {
+#ifdef __linux__
+          std::unique_ptr< Session > s( new Session );
+          s->match_ = match;
+          s->client_ = client;
+          s->front_endpoint_ = Endpoint{ Endpoint::FRONT, channel, s.get() };
+          s->back_endpoint_ = Endpoint{ Endpoint::BACK, channel, s.get() };
+          s->match_dest_ = M_matches[match].addr_[channel];
+          s->dedicated_ = false;
+          s->last_time_ = std::chrono::steady_clock::now();
+
+          if ( ! s->front_.open()
+               || ! s->back_.open()
+               || ! s->front_.bind( rcss::net::Addr() )
+               || ! s->back_.bind( rcss::net::Addr() )
+               || s->front_.setNonBlocking() < 0
+               || s->back_.setNonBlocking() < 0 )
+          {
+              std::cerr << "Error opening the sockets of " << client << ": "
+                        << std::strerror( errno ) << std::endl;
+              return nullptr;
+          }
+
+          Session * ptr = s.get();
+          if ( ! watch( s->front_.getFD(), &s->front_endpoint_ )
+               || ! watch( s->back_.getFD(), &s->back_endpoint_ ) )
+          {
+              return nullptr;
+          }
+
+          ++M_matches[match].sessions_;
+          M_sessions[channel][addr_key( client )] = std::move( s );
+          return ptr;
+#else
+          (void)channel; (void)client; (void)match;
+          return nullptr;
+#endif
+      }
+
+    void recvFront( Session & s )
+      {
+          char buf[8192];
+          rcss::net::Addr & from = M_from;
+          int len = 0;
+          while ( ( len = s.front_.recv( buf, sizeof( buf ), from ) ) > 0 )
+          {
+              s.back_.send( buf, len, s.match_dest_ );
+              s.last_time_ = std::chrono::steady_clock::now();
+              ++M_relayed;
+          }
+      }
+
+    void recvBack( Session & s )
+      {
+          char buf[8192];
+          rcss::net::Addr & from = M_from;
+          int len = 0;
+          while ( ( len = s.back_.recv( buf, sizeof( buf ), from ) ) > 0 )
+          {
+              if ( ! s.dedicated_ )
+              {
+                  // the first answer comes from the dedicated socket of the client
+                  s.match_dest_ = from;
+                  s.dedicated_ = true;
+              }
+              s.front_.send( buf, len, s.client_ );
+              s.last_time_ = std::chrono::steady_clock::now();
+              ++M_relayed;
+          }
+      }
+
+    void expireSessions( const std::chrono::steady_clock::time_point & now )
+      {
+#ifdef __linux__
+          for ( int c = 0; c < CHANNELS; ++c )
+          {
+              for ( std::unordered_map< std::uint64_t, std::unique_ptr< Session > >::iterator
+                        it = M_sessions[c].begin();
+                    it != M_sessions[c].end(); )
+              {
+                  if ( now - it->second->last_time_ > M_idle_timeout )
+                  {
+                      // the events of this round are handled already, so
+                      // no pending event refers to the erased endpoints
+                      epoll_event ev;
+                      ::epoll_ctl( M_epoll_fd, EPOLL_CTL_DEL, it->second->front_.getFD(), &ev );
+                      ::epoll_ctl( M_epoll_fd, EPOLL_CTL_DEL, it->second->back_.getFD(), &ev );
+                      it = M_sessions[c].erase( it );
+                  }
+                  else
+                  {
+                      ++it;
+                  }
+              }
+          }
+#else
+          (void)now;
+#endif
+      }
+};
+
+
+int
+main( int argc, char **argv )
+{
+    if ( std::signal( SIGINT, &sig_exit_handle ) == SIG_ERR
+         || std::signal( SIGTERM, &sig_exit_handle ) == SIG_ERR )
+    {
+        std::cerr << __FILE__ << ": " << __LINE__
+                  << ": could not set signal handler: "
+                  << std::strerror( errno ) << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    int port = 6000;
+    int idle_timeout = 60;
+    std::vector< std::string > matches;
+
+    for ( int i = 1; i < argc; ++i )
+    {
+        if ( std::strcmp( argv[ i ], "-port" ) == 0 )
+        {
+            if ( i + 1 < argc )
+            {
+                port = std::atoi( argv[ i + 1 ] );
+                ++i;
+            }
+        }
+        else if ( std::strcmp( argv[ i ], "-match" ) == 0 )
+        {
+            if ( i + 1 < argc )
+            {
+                matches.push_back( argv[ i + 1 ] );
+                ++i;
+            }
+        }
+        else if ( std::strcmp( argv[ i ], "-timeout" ) == 0 )
+        {
+            if ( i + 1 < argc )
+            {
+                idle_timeout = std::max( 1, std::atoi( argv[ i + 1 ] ) );
+                ++i;
+            }
+        }
+        else
+        {
+            std::cerr << "Usage: " << argv[0]
+                      << " [-port PORT] [-timeout SEC] -match NAME:HOST:PORT[:TEAM[,TEAM]] ...\n"
+                      << "  -port PORT     the player port, PORT+1 and PORT+2 are the coach ports\n"
+                      << "  -timeout SEC   closes the clients idle for SEC seconds (default 60)\n"
+                      << "  -match ...     a match whose player port is PORT, optionally with its teams\n"
+                      << "A client may choose a match by sending \"(match NAME)\" before its init."
+                      << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    raise_file_limit();
+
+    Router router( idle_timeout );
+    for ( const std::string & m : matches )
+    {
+        if ( ! router.addMatch( m ) )
+        {
+            return EXIT_FAILURE;
+        }
+    }
+
+    if ( ! router.open( port ) )
+    {
+        return EXIT_FAILURE;
+    }
+
+    router.run();
+    return EXIT_SUCCESS;
+}
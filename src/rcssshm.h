@@ -0,0 +1,338 @@
+/* -*-c-*- */
+
+/***************************************************************************
+                                  rcssshm.h
+          Shared memory message queues between server and clients
+                             -------------------
+    begin                : 2026-10-18
+    copyright            : (C) 2026 by The RoboCup Soccer Server
+                           Maintenance Group.
+    email                : sserver-admin@lists.sourceforge.net
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU LGPL as published by the Free Software  *
+ *   Foundation; either version 3 of the License, or (at your option) any  *
+ *   later version.                                                        *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef RCSSSERVER_RCSSSHM_H
+#define RCSSSERVER_RCSSSHM_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+  The shared memory transport of a player, used by the server and by
+  clients that run on the same host.  The header has no library to link
+  with, a client only needs -lrt on older systems.
+
+  A client asks for the transport by adding "(shm NAME)" to its init or
+  reconnect command, which it still sends over UDP.  The server creates
+  the segment "/NAME" before it replies, and the client attaches to it
+  with rcss_shm_attach() once it has sent the command.  From then on
+  every message, the reply to the init command included, is exchanged
+  through the segment:
+
+    rcss_shm_segment * seg = rcss_shm_attach( "player1" );
+    rcss_shm_send( &seg->to_server, "(move -10 0)", 13 );
+    while ( rcss_shm_wait( &seg->to_client, 1000 ) > 0 )
+    {
+        size_t len;
+        char * msg;
+        while ( ( msg = rcss_shm_front( &seg->to_client, &len ) ) )
+        {
+            handle( msg, len );
+            rcss_shm_pop( &seg->to_client );
+        }
+    }
+
+  "rcssclient -shm NAME" uses the segment in the same way.
+
+  Each queue has a single producer and a single consumer.  A message is
+  stored as a 32 bit length followed by its bytes and at least one byte
+  of padding up to a multiple of 4 bytes.  A message never wraps around
+  the end of the data area.  The producer writes RCSS_SHM_WRAP as the
+  length instead and continues at the start.  So the consumer can parse
+  a message in place, and write a terminator behind it.  The producer
+  can serialize straight into the queue with rcss_shm_reserve() and
+  rcss_shm_commit().
+
+  head and tail count the bytes written and read since the segment was
+  created.  The consumer may sleep on seq with a futex after setting
+  waiters, and the producer increments seq after each message and wakes
+  the consumer only if waiters is set.  The server never sleeps on a
+  queue, it polls the client queue in its receive loop.
+*/
+
+#define RCSS_SHM_MAGIC 0x72637373u /* "rcss" */
+#define RCSS_SHM_QUEUE_SIZE ( 64 * 1024 )
+#define RCSS_SHM_WRAP 0xffffffffu
+
+typedef struct rcss_shm_queue {
+    uint64_t head; /*!< bytes written by the producer */
+    uint64_t tail; /*!< bytes read by the consumer */
+    uint32_t seq; /*!< futex word */
+    uint32_t waiters; /*!< non zero while the consumer sleeps */
+    char data[RCSS_SHM_QUEUE_SIZE];
+} rcss_shm_queue;
+
+typedef struct rcss_shm_segment {
+    uint32_t magic; /*!< set when the segment is ready */
+    uint32_t queue_size;
+    rcss_shm_queue to_client;
+    rcss_shm_queue to_server;
+} rcss_shm_segment;
+
+/*! the bytes taken by a message of \p len bytes */
+static inline
+size_t
+rcss_shm_record_size( size_t len )
+{
+    return sizeof( uint32_t ) + ( ( len + 1 + 3 ) & ~(size_t)3 );
+}
+
+/*!
+  \brief reserves the space for a message of up to \p len bytes.
+  \return where the message is to be written, or NULL if the queue does
+  not have enough space.  The message is dropped in that case, as a
+  datagram would be.
+*/
+static inline
+char *
+rcss_shm_reserve( rcss_shm_queue * q,
+                  size_t len )
+{
+    const size_t record = rcss_shm_record_size( len );
+    uint64_t head = __atomic_load_n( &q->head, __ATOMIC_RELAXED );
+    const uint64_t tail = __atomic_load_n( &q->tail, __ATOMIC_ACQUIRE );
+    size_t offset = (size_t)( head % RCSS_SHM_QUEUE_SIZE );
+    const size_t rest = RCSS_SHM_QUEUE_SIZE - offset;
+
+    if ( record > rest )
+    {
+        if ( head + rest + record - tail > RCSS_SHM_QUEUE_SIZE )
+        {
+            return NULL;
+        }
+
+        /* records are aligned, so the marker always fits */
+        const uint32_t wrap = RCSS_SHM_WRAP;
+        memcpy( q->data + offset, &wrap, sizeof( wrap ) );
+        head += rest;
+        __atomic_store_n( &q->head, head, __ATOMIC_RELEASE );
+        offset = 0;
+    }
+    else if ( head + record - tail > RCSS_SHM_QUEUE_SIZE )
+    {
+        return NULL;
+    }
+
+    return q->data + offset + sizeof( uint32_t );
+}
+
+/*!
+  \brief publishes a message of \p len bytes written at \p msg, which
+  was returned by rcss_shm_reserve() for at least \p len bytes.
+*/
+static inline
+void
+rcss_shm_commit( rcss_shm_queue * q,
+                 char * msg,
+                 size_t len )
+{
+    const uint32_t size = (uint32_t)len;
+    memcpy( msg - sizeof( size ), &size, sizeof( size ) );
+
+    const uint64_t head = __atomic_load_n( &q->head, __ATOMIC_RELAXED );
+    __atomic_store_n( &q->head, head + rcss_shm_record_size( len ), __ATOMIC_RELEASE );
+
+    __atomic_fetch_add( &q->seq, 1, __ATOMIC_SEQ_CST );
+#ifdef __linux__
+    if ( __atomic_load_n( &q->waiters, __ATOMIC_SEQ_CST ) != 0 )
+    {
+        syscall( SYS_futex, &q->seq, FUTEX_WAKE, 1, NULL, NULL, 0 );
+    }
+#endif
+}
+
+/*!
+  \brief copies a message into the queue.
+  \return 0 on success, -1 if the queue does not have enough space.
+*/
+static inline
+int
+rcss_shm_send( rcss_shm_queue * q,
+               const char * msg,
+               size_t len )
+{
+    char * buf = rcss_shm_reserve( q, len );
+    if ( ! buf )
+    {
+        return -1;
+    }
+
+    memcpy( buf, msg, len );
+    rcss_shm_commit( q, buf, len );
+    return 0;
+}
+
+/*!
+  \brief gets the oldest message in place.  It stays valid until
+  rcss_shm_pop() is called, and the byte behind it may be overwritten,
+  e.g. by a terminator.
+  \return the message, or NULL if the queue is empty.  A broken queue
+  is emptied.
+*/
+static inline
+char *
+rcss_shm_front( rcss_shm_queue * q,
+                size_t * len )
+{
+    uint64_t tail = __atomic_load_n( &q->tail, __ATOMIC_RELAXED );
+    const uint64_t head = __atomic_load_n( &q->head, __ATOMIC_ACQUIRE );
+
+    while ( head - tail >= sizeof( uint32_t ) )
+    {
+        const size_t offset = (size_t)( tail % RCSS_SHM_QUEUE_SIZE );
+        uint32_t size = 0;
+        memcpy( &size, q->data + offset, sizeof( size ) );
+
+        if ( size == RCSS_SHM_WRAP )
+        {
+            tail += RCSS_SHM_QUEUE_SIZE - offset;
+            __atomic_store_n( &q->tail, tail, __ATOMIC_RELEASE );
+            continue;
+        }
+
+        const size_t record = rcss_shm_record_size( size );
+        if ( head - tail < record
+             || offset + record > RCSS_SHM_QUEUE_SIZE )
+        {
+            __atomic_store_n( &q->tail, head, __ATOMIC_RELEASE );
+            return NULL;
+        }
+
+        *len = size;
+        return q->data + offset + sizeof( uint32_t );
+    }
+
+    return NULL;
+}
+
+/*! \brief releases the message returned by rcss_shm_front(). */
+static inline
+void
+rcss_shm_pop( rcss_shm_queue * q )
+{
+    const uint64_t tail = __atomic_load_n( &q->tail, __ATOMIC_RELAXED );
+    uint32_t size = 0;
+    memcpy( &size, q->data + tail % RCSS_SHM_QUEUE_SIZE, sizeof( size ) );
+    __atomic_store_n( &q->tail, tail + rcss_shm_record_size( size ), __ATOMIC_RELEASE );
+}
+
+#ifdef __linux__
+
+/*!
+  \brief sleeps until the queue has a message.
+  \return 1 if it has one, 0 on timeout.  A negative \p timeout_ms
+  waits without a limit.
+*/
+static inline
+int
+rcss_shm_wait( rcss_shm_queue * q,
+               int timeout_ms )
+{
+    const uint32_t seq = __atomic_load_n( &q->seq, __ATOMIC_SEQ_CST );
+    if ( __atomic_load_n( &q->head, __ATOMIC_ACQUIRE )
+         != __atomic_load_n( &q->tail, __ATOMIC_RELAXED ) )
+    {
+        return 1;
+    }
+
+    struct timespec ts;
+    ts.tv_sec = timeout_ms / 1000;
+    ts.tv_nsec = ( timeout_ms % 1000 ) * 1000000L;
+
+    __atomic_store_n( &q->waiters, 1, __ATOMIC_SEQ_CST );
+    syscall( SYS_futex, &q->seq, FUTEX_WAIT, seq,
+             timeout_ms < 0 ? NULL : &ts, NULL, 0 );
+    __atomic_store_n( &q->waiters, 0, __ATOMIC_SEQ_CST );
+
+    return __atomic_load_n( &q->head, __ATOMIC_ACQUIRE )
+        != __atomic_load_n( &q->tail, __ATOMIC_RELAXED );
+}
+
+/*!
+  \brief maps the segment "/NAME" created by the server.
+  \return NULL if it does not exist or is not ready yet.
+*/
+static inline
+rcss_shm_segment *
+rcss_shm_attach( const char * name )
+{
+    char path[128];
+    if ( strlen( name ) + 2 > sizeof( path ) )
+    {
+        return NULL;
+    }
+    path[0] = '/';
+    strcpy( path + 1, name );
+
+    const int fd = shm_open( path, O_RDWR, 0 );
+    if ( fd == -1 )
+    {
+        return NULL;
+    }
+
+    void * addr = mmap( NULL, sizeof( rcss_shm_segment ),
+                        PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+    close( fd );
+    if ( addr == MAP_FAILED )
+    {
+        return NULL;
+    }
+
+    rcss_shm_segment * seg = (rcss_shm_segment *)addr;
+    if ( __atomic_load_n( &seg->magic, __ATOMIC_ACQUIRE ) != RCSS_SHM_MAGIC
+         || seg->queue_size != RCSS_SHM_QUEUE_SIZE )
+    {
+        munmap( addr, sizeof( rcss_shm_segment ) );
+        return NULL;
+    }
+
+    return seg;
+}
+
+static inline
+void
+rcss_shm_detach( rcss_shm_segment * seg )
+{
+    munmap( seg, sizeof( rcss_shm_segment ) );
+}
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
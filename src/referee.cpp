@@ -25,6 +25,7 @@
 
 #include "referee.h"
 
+#include "checkpoint.h"
 #include "logger.h"
 #include "stadium.h"
 #include "player.h"
@@ -426,8 +427,6 @@ void TimeRef::analyse()
         return;
     }
 
-    static int s_half_time_count = 0;
-
     const PlayMode pm = M_stadium.playmode();
     if (pm == PM_BeforeKickOff || pm == PM_TimeOver || pm == PM_AfterGoal_Right || pm == PM_AfterGoal_Left || pm == PM_OffSide_Right || pm == PM_OffSide_Left || pm == PM_Illegal_Defense_Left || pm == PM_Illegal_Defense_Right || pm == PM_Foul_Charge_Right || pm == PM_Foul_Charge_Left || pm == PM_Foul_Push_Right || pm == PM_Foul_Push_Left || pm == PM_Back_Pass_Right || pm == PM_Back_Pass_Left || pm == PM_Free_Kick_Fault_Right || pm == PM_Free_Kick_Fault_Left || pm == PM_CatchFault_Right || pm == PM_CatchFault_Left)
     {
@@ -459,7 +458,7 @@ void TimeRef::analyse()
         // overtime
         else if (M_stadium.time() >= normal_time)
         {
-            int extra_count = (s_half_time_count + 1) - param.nrNormalHalfs();
+            int extra_count = (M_half_time_count + 1) - param.nrNormalHalfs();
 
             if (!M_stadium.teamLeft().enabled() || !M_stadium.teamRight().enabled())
             {
@@ -489,12 +488,12 @@ void TimeRef::analyse()
                 // otherwise, the game is go into the overtime.
                 else
                 {
-                    ++s_half_time_count;
+                    ++M_half_time_count;
                     M_stadium.sendRefereeAudio("time_extended");
-                    Side kick_off_side = (s_half_time_count % 2 == 0
+                    Side kick_off_side = (M_half_time_count % 2 == 0
                                               ? LEFT
                                               : RIGHT);
-                    M_stadium.callHalfTime(kick_off_side, s_half_time_count);
+                    M_stadium.callHalfTime(kick_off_side, M_half_time_count);
                     placePlayersInTheirField();
                 }
 
@@ -502,14 +501,14 @@ void TimeRef::analyse()
             }
         }
         // if not in overtime, check whether halfTime() cycles have been passed
-        else if (M_stadium.time() >= param.halfTime() * (s_half_time_count + 1))
+        else if (M_stadium.time() >= param.halfTime() * (M_half_time_count + 1))
         {
-            ++s_half_time_count;
-            Side kick_off_side = (s_half_time_count % 2 == 0
+            ++M_half_time_count;
+            Side kick_off_side = (M_half_time_count % 2 == 0
                                       ? LEFT
                                       : RIGHT);
             M_stadium.sendRefereeAudio("half_time");
-            M_stadium.callHalfTime(kick_off_side, s_half_time_count);
+            M_stadium.callHalfTime(kick_off_side, M_half_time_count);
             placePlayersInTheirField();
             return;
         }
@@ -525,6 +524,16 @@ void TimeRef::analyse()
     //     }
 }
 
+void TimeRef::saveState(rcss::CheckpointWriter &writer) const
+{
+    writer.put(M_half_time_count);
+}
+
+void TimeRef::loadState(rcss::CheckpointReader &reader)
+{
+    reader.get(M_half_time_count);
+}
+
 void Referee::placePlayersInTheirField()
 {
     static const RArea fld_l(PVector(-ServerParam::PITCH_LENGTH / 4, 0.0),
@@ -846,6 +855,18 @@ void BallStuckRef::analyse()
     }
 }
 
+void BallStuckRef::saveState(rcss::CheckpointWriter &writer) const
+{
+    writer.put(M_last_ball_pos);
+    writer.put(M_counter);
+}
+
+void BallStuckRef::loadState(rcss::CheckpointReader &reader)
+{
+    reader.get(M_last_ball_pos);
+    reader.get(M_counter);
+}
+
 //**********
 // OffsideRef
 //**********
@@ -1006,6 +1027,45 @@ void OffsideRef::playModeChange(PlayMode pm)
     }
 }
 
+void OffsideRef::newEpisode()
+{
+    M_offside_candidates.clear();
+}
+
+void OffsideRef::saveState(rcss::CheckpointWriter &writer) const
+{
+    writer.put(M_last_kick_time);
+    writer.put(M_last_kick_stoppage_time);
+    writer.put(M_last_kick_accel_r);
+    writer.put(M_last_kicker_side);
+    writer.put(static_cast<int>(M_offside_candidates.size()));
+    for (const Candidate &c : M_offside_candidates)
+    {
+        writer.putPlayer(c.player_);
+        writer.put(c.pos_);
+    }
+    writer.put(M_offside_pos);
+    writer.put(M_after_offside_time);
+}
+
+void OffsideRef::loadState(rcss::CheckpointReader &reader)
+{
+    reader.get(M_last_kick_time);
+    reader.get(M_last_kick_stoppage_time);
+    reader.get(M_last_kick_accel_r);
+    reader.get(M_last_kicker_side);
+    M_offside_candidates.clear();
+    const int size = reader.get<int>();
+    for (int i = 0; i < size && reader.ok(); ++i)
+    {
+        const Player *player = reader.getPlayer();
+        const PVector pos = reader.get<PVector>();
+        M_offside_candidates.emplace_back(player, pos.x, pos.y);
+    }
+    reader.get(M_offside_pos);
+    reader.get(M_after_offside_time);
+}
+
 void OffsideRef::setOffsideMark(const Player &kicker,
                                 const double accel_r)
 {
@@ -1428,6 +1488,24 @@ void IllegalDefenseRef::playModeChange(PlayMode pm)
     }
 }
 
+void IllegalDefenseRef::saveState(rcss::CheckpointWriter &writer) const
+{
+    writer.put(M_left_illegal_counter);
+    writer.put(M_right_illegal_counter);
+    writer.put(M_last_kicker_side);
+    writer.put(M_last_kick_time);
+    writer.put(M_after_illegal_defense_time);
+}
+
+void IllegalDefenseRef::loadState(rcss::CheckpointReader &reader)
+{
+    reader.get(M_left_illegal_counter);
+    reader.get(M_right_illegal_counter);
+    reader.get(M_last_kicker_side);
+    reader.get(M_last_kick_time);
+    reader.get(M_after_illegal_defense_time);
+}
+
 PVector IllegalDefenseRef::calculateFreeKickPositon(Side side)
 {
     PVector pos(-41.5, 0.0);
@@ -1755,6 +1833,29 @@ void FreeKickRef::playModeChange(PlayMode pm)
     }
 }
 
+void FreeKickRef::newEpisode()
+{
+    M_kick_taken = false;
+}
+
+void FreeKickRef::saveState(rcss::CheckpointWriter &writer) const
+{
+    writer.put(M_timer);
+    writer.put(M_kick_taken);
+    writer.put(M_goal_kick_count);
+    writer.put(M_kick_taker_dashes);
+    writer.put(M_after_free_kick_fault_time);
+}
+
+void FreeKickRef::loadState(rcss::CheckpointReader &reader)
+{
+    reader.get(M_timer);
+    reader.get(M_kick_taken);
+    reader.get(M_goal_kick_count);
+    reader.get(M_kick_taker_dashes);
+    reader.get(M_after_free_kick_fault_time);
+}
+
 void FreeKickRef::callFreeKickFault(Side side, PVector pos)
 {
     pos = truncateToPitch(pos);
@@ -2067,6 +2168,31 @@ void TouchRef::playModeChange(PlayMode pm)
     }
 }
 
+void TouchRef::newEpisode()
+{
+    M_last_touched = nullptr;
+    M_last_indirect_kicker = nullptr;
+    M_indirect_mode = false;
+}
+
+void TouchRef::saveState(rcss::CheckpointWriter &writer) const
+{
+    writer.put(M_last_touched_time);
+    writer.put(M_last_touched_accel_r);
+    writer.put(M_indirect_mode);
+    writer.put(M_after_goal_time);
+    writer.put(M_prev_ball_pos);
+}
+
+void TouchRef::loadState(rcss::CheckpointReader &reader)
+{
+    reader.get(M_last_touched_time);
+    reader.get(M_last_touched_accel_r);
+    reader.get(M_indirect_mode);
+    reader.get(M_after_goal_time);
+    reader.get(M_prev_ball_pos);
+}
+
 bool TouchRef::checkGoal()
 {
     if (M_stadium.playmode() == PM_AfterGoal_Left || M_stadium.playmode() == PM_AfterGoal_Right || M_stadium.playmode() == PM_TimeOver)
@@ -2414,6 +2540,32 @@ void CatchRef::playModeChange(PlayMode pmode)
     }
 }
 
+void CatchRef::newEpisode()
+{
+    M_before_last_back_passer = nullptr;
+    M_last_back_passer = nullptr;
+}
+
+void CatchRef::saveState(rcss::CheckpointWriter &writer) const
+{
+    writer.put(M_last_back_passer_time);
+    writer.put(M_last_back_passer_accel_r);
+    writer.put(M_team_l_touched);
+    writer.put(M_team_r_touched);
+    writer.put(M_after_back_pass_time);
+    writer.put(M_after_catch_fault_time);
+}
+
+void CatchRef::loadState(rcss::CheckpointReader &reader)
+{
+    reader.get(M_last_back_passer_time);
+    reader.get(M_last_back_passer_accel_r);
+    reader.get(M_team_l_touched);
+    reader.get(M_team_r_touched);
+    reader.get(M_after_back_pass_time);
+    reader.get(M_after_catch_fault_time);
+}
+
 void CatchRef::callBackPass(const Side side)
 {
     PVector pos = truncateToPitch(M_stadium.ball().pos());
@@ -2612,6 +2764,16 @@ void FoulRef::playModeChange(PlayMode pm)
     }
 }
 
+void FoulRef::saveState(rcss::CheckpointWriter &writer) const
+{
+    writer.put(M_after_foul_time);
+}
+
+void FoulRef::loadState(rcss::CheckpointReader &reader)
+{
+    reader.get(M_after_foul_time);
+}
+
 //************
 // KeepawayRef
 //************
@@ -2622,7 +2784,8 @@ KeepawayRef::KeepawayRef(Stadium &stadium)
       M_keepers(0),
       M_takers(0),
       M_time(0),
-      M_take_time(0)
+      M_take_time(0),
+      M_start_time(std::time(nullptr))
 {
 }
 
@@ -2633,21 +2796,19 @@ void KeepawayRef::analyse()
         return;
     }
 
-    static time_t s_start_time = std::time(nullptr);
-
     if (M_stadium.playmode() == PM_PlayOn)
     {
         if (!ballInKeepawayArea())
         {
             logEpisode("o");
-            M_stadium.sendRefereeAudio(trainingMsg);
-            resetField();
+            prepareField();
+            M_stadium.resetEpisode(M_start, trainingMsg);
         }
         else if (M_take_time >= TURNOVER_TIME)
         {
             logEpisode("t");
-            M_stadium.sendRefereeAudio(trainingMsg);
-            resetField();
+            prepareField();
+            M_stadium.resetEpisode(M_start, trainingMsg);
         }
         else
         {
@@ -2683,7 +2844,7 @@ void KeepawayRef::analyse()
     }
     else if (ServerParam::instance().kawayStart() >= 0)
     {
-        if (difftime(std::time(nullptr), s_start_time) > ServerParam::instance().kawayStart())
+        if (difftime(std::time(nullptr), M_start_time) > ServerParam::instance().kawayStart())
         {
             M_stadium.changePlayMode(PM_PlayOn);
         }
@@ -2719,6 +2880,35 @@ void KeepawayRef::playModeChange(PlayMode pm)
     }
 }
 
+void KeepawayRef::saveState(rcss::CheckpointWriter &writer) const
+{
+    writer.put(M_episode);
+    writer.put(M_time);
+    writer.put(M_take_time);
+}
+
+void KeepawayRef::loadState(rcss::CheckpointReader &reader)
+{
+    reader.get(M_episode);
+    reader.get(M_time);
+    reader.get(M_take_time);
+}
+
+bool KeepawayRef::restartEpisode()
+{
+    if (!ServerParam::instance().keepAwayMode() || M_episode == 0)
+    {
+        return false;
+    }
+
+    ++M_episode;
+    M_time = M_stadium.time();
+    M_take_time = 0;
+    prepareField();
+    M_stadium.resetEpisode(M_start, trainingMsg);
+    return true;
+}
+
 bool KeepawayRef::ballInKeepawayArea()
 {
     PVector ball_pos = M_stadium.ball().pos();
@@ -2754,6 +2944,14 @@ void HFORef::logEpisode(const char *end_cond)
 
 void KeepawayRef::resetField()
 {
+    prepareField();
+    M_stadium.placeEpisodeStart(M_start);
+}
+
+void KeepawayRef::prepareField()
+{
+    M_start.players_.clear();
+
     int keeper_pos = irand(M_keepers);
     // int keeper_pos = boost::uniform_smallint<>( 0, M_keepers - 1 )( rcss::random::DefaultRNG::instance() );
 
@@ -2785,7 +2983,7 @@ void KeepawayRef::resetField()
                 break;
             }
 
-            p->place(PVector(x, y));
+            M_start.players_.emplace_back(p, PVector(x, y));
 
             keeper_pos = (keeper_pos + 1) % M_keepers;
         }
@@ -2794,14 +2992,12 @@ void KeepawayRef::resetField()
             x = -ServerParam::instance().keepAwayLength() * 0.5 + drand(0, 3);
             y = ServerParam::instance().keepAwayWidth() * 0.5 - drand(0, 3);
 
-            p->place(PVector(x, y));
+            M_start.players_.emplace_back(p, PVector(x, y));
         }
     }
 
-    M_stadium.placeBall(NEUTRAL,
-                        PVector(-ServerParam::instance().keepAwayLength() * 0.5 + 4.0,
-                                -ServerParam::instance().keepAwayWidth() * 0.5 + 4.0));
-    M_stadium.recoveryPlayers();
+    M_start.ball_ = PVector(-ServerParam::instance().keepAwayLength() * 0.5 + 4.0,
+                            -ServerParam::instance().keepAwayWidth() * 0.5 + 4.0);
 
     M_take_time = 0;
 }
@@ -2822,6 +3018,7 @@ HFORef::HFORef(Stadium &stadium)
       M_prev_ball_pos(0.0, 0.0),
       M_untouched_time(0),
       M_episode_over_time(-1),
+      M_seed(-1),
       M_rng()
 {
     // Generate vector of offsets used when resetting the field.
@@ -2855,12 +3052,12 @@ void HFORef::analyse()
     {
         if (M_stadium.time() - M_episode_over_time >= 1)
         {
-            M_stadium.changePlayMode(PM_BeforeKickOff);
-            M_stadium.changePlayMode(PM_PlayOn);
             M_episode_over_time = -1;
+            M_episode++;
+            prepareField();
             char possessionMsg[32];
             sprintf(possessionMsg, "%s-%c%d", inGameMsg, M_holder_side, M_holder_unum);
-            M_stadium.sendRefereeAudio(possessionMsg);
+            M_stadium.resetEpisode(M_start, possessionMsg);
         }
         return;
     }
@@ -2964,7 +3161,12 @@ void HFORef::playModeChange(PlayMode pm)
             if (M_episode == 0)
             {
                 // Seed the RNG needed to reset the field
-                if (ServerParam::instance().randomSeed() >= 0)
+                if (M_seed >= 0)
+                {
+                    std::cout << "HFORef using seed: " << M_seed << std::endl;
+                    M_rng.seed(M_seed);
+                }
+                else if (ServerParam::instance().randomSeed() >= 0)
                 {
                     int seed = ServerParam::instance().randomSeed();
                     std::cout << "HFORef using seed: " << seed << std::endl;
@@ -3002,6 +3204,67 @@ void HFORef::playModeChange(PlayMode pm)
     }
 }
 
+bool HFORef::restartEpisode()
+{
+    if (!ServerParam::instance().hfoMode() || M_episode == 0)
+    {
+        return false;
+    }
+
+    M_episode_over_time = -1;
+    M_episode++;
+    M_time = M_stadium.time();
+    M_take_time = 0;
+    M_untouched_time = 0;
+    M_holder_side = 'U';
+    M_holder_unum = -1;
+    prepareField();
+    char possessionMsg[32];
+    sprintf(possessionMsg, "%s-%c%d", inGameMsg, M_holder_side, M_holder_unum);
+    M_stadium.resetEpisode(M_start, possessionMsg);
+    M_prev_ball_pos = M_stadium.ball().pos();
+    return true;
+}
+
+void HFORef::saveState(rcss::CheckpointWriter &writer) const
+{
+    writer.put(M_episode);
+    writer.put(M_time);
+    writer.put(M_take_time);
+    writer.put(M_holder_unum);
+    writer.put(M_holder_side);
+    writer.put(M_prev_ball_pos);
+    writer.put(M_untouched_time);
+    writer.put(M_episode_over_time);
+    writer.put(M_rng);
+    writer.put(static_cast<int>(M_offsets.size()));
+    for (const std::pair<int, int> &offset : M_offsets)
+    {
+        writer.put(offset.first);
+        writer.put(offset.second);
+    }
+}
+
+void HFORef::loadState(rcss::CheckpointReader &reader)
+{
+    reader.get(M_episode);
+    reader.get(M_time);
+    reader.get(M_take_time);
+    reader.get(M_holder_unum);
+    reader.get(M_holder_side);
+    reader.get(M_prev_ball_pos);
+    reader.get(M_untouched_time);
+    reader.get(M_episode_over_time);
+    reader.get(M_rng);
+    M_offsets.clear();
+    const int size = reader.get<int>();
+    for (int i = 0; i < size && reader.ok(); ++i)
+    {
+        const int x = reader.get<int>();
+        M_offsets.push_back(std::make_pair(x, reader.get<int>()));
+    }
+}
+
 bool HFORef::inHFOArea(const PVector &pos)
 {
     return (pos.x >= 0 &&
@@ -3138,6 +3401,14 @@ bool HFORef::inHFOArea(const PVector &pos)
 
 void HFORef::resetField()
 {
+    prepareField();
+    M_stadium.placeEpisodeStart(M_start);
+}
+
+void HFORef::prepareField()
+{
+    M_start.players_.clear();
+
     double pitch_length = ServerParam::instance().PITCH_LENGTH;
     double half_pitch_length = 0.5 * pitch_length;
     double pitch_width = ServerParam::instance().PITCH_WIDTH;
@@ -3157,8 +3428,8 @@ void HFORef::resetField()
     boost::random::uniform_real_distribution<> dist_ball_y(min_ball_y / 2.0 * pitch_width, max_ball_y / 2.0 * pitch_width);
     double ball_y = dist_ball_y(M_rng);
 
-    M_stadium.placeBall(NEUTRAL, PVector(ball_x, ball_y));
-    M_prev_ball_pos = M_stadium.ball().pos();
+    M_start.ball_ = PVector(ball_x, ball_y);
+    M_prev_ball_pos = M_start.ball_;
 
     // Replace variate_generator with a lambda for random_shuffle
     boost::random::uniform_int_distribution<> dist_shuffle(0, M_offsets.size() - 1);
@@ -3203,7 +3474,7 @@ void HFORef::resetField()
         {
             if (offense_pos_on_ball == offense_pos)
             {
-                (*p)->place(PVector(ball_x - .1, ball_y));
+                M_start.players_.emplace_back(*p, PVector(ball_x - .1, ball_y));
                 offense_pos++;
                 continue;
             }
@@ -3215,7 +3486,7 @@ void HFORef::resetField()
 
             x = std::min(std::max(x, -.1), half_pitch_length);
             y = std::min(std::max(y, -.4 * pitch_width), .4 * pitch_width);
-            (*p)->place(PVector(x, y));
+            M_start.players_.emplace_back(*p, PVector(x, y));
 
             offense_pos++;
         }
@@ -3234,11 +3505,10 @@ void HFORef::resetField()
                 x = dist_right_x(M_rng);
                 y = dist_right_y(M_rng);
             }
-            (*p)->place(PVector(x, y));
+            M_start.players_.emplace_back(*p, PVector(x, y));
         }
     }
 
-    M_stadium.recoveryPlayers();
     M_take_time = 0;
     M_untouched_time = 0;
     M_holder_side = 'U';
@@ -3258,7 +3528,8 @@ PenaltyRef::PenaltyRef(Stadium &stadium)
       M_cur_pen_taker(NEUTRAL),
       M_last_taker(nullptr),
       M_prev_ball_pos(0.0, 0.0),
-      M_timeover(false)
+      M_timeover(false),
+      M_first_time(true)
 {
 }
 
@@ -3277,12 +3548,10 @@ void PenaltyRef::analyse()
 
 void PenaltyRef::startPenaltyShootout()
 {
-    static bool first_time = true;
-
     const ServerParam &param = ServerParam::instance();
 
     // if normal and extra time are over -> start the penalty procedure or quit
-    if (first_time && param.penaltyShootOuts() && M_stadium.playmode() != PM_BeforeKickOff && M_stadium.teamLeft().point() == M_stadium.teamRight().point() && ((param.halfTime() < 0 && param.nrNormalHalfs() + param.nrExtraHalfs() == 0) || (param.halfTime() >= 0 && (M_stadium.time() >= (param.halfTime() * param.nrNormalHalfs() + param.extraHalfTime() * param.nrExtraHalfs())))))
+    if (M_first_time && param.penaltyShootOuts() && M_stadium.playmode() != PM_BeforeKickOff && M_stadium.teamLeft().point() == M_stadium.teamRight().point() && ((param.halfTime() < 0 && param.nrNormalHalfs() + param.nrExtraHalfs() == 0) || (param.halfTime() >= 0 && (M_stadium.time() >= (param.halfTime() * param.nrNormalHalfs() + param.extraHalfTime() * param.nrExtraHalfs())))))
     {
         if (drand(0, 1) < 0.5) // choose random side of the playfield
         {
@@ -3314,7 +3583,7 @@ void PenaltyRef::startPenaltyShootout()
         }
 
         penalty_init();
-        first_time = false;
+        M_first_time = false;
     }
 }
 
@@ -3725,6 +3994,57 @@ void PenaltyRef::playModeChange(PlayMode pm)
     }
 }
 
+namespace {
+
+void save_takers(rcss::CheckpointWriter &writer,
+                 const std::set<int> &takers)
+{
+    writer.put(static_cast<int>(takers.size()));
+    for (const int unum : takers)
+    {
+        writer.put(unum);
+    }
+}
+
+void load_takers(rcss::CheckpointReader &reader,
+                 std::set<int> &takers)
+{
+    takers.clear();
+    const int size = reader.get<int>();
+    for (int i = 0; i < size && reader.ok(); ++i)
+    {
+        takers.insert(reader.get<int>());
+    }
+}
+
+}
+
+void PenaltyRef::saveState(rcss::CheckpointWriter &writer) const
+{
+    writer.put(M_timer);
+    writer.put(M_pen_nr_taken);
+    writer.put(M_pen_side);
+    writer.put(M_cur_pen_taker);
+    save_takers(writer, M_sLeftPenTaken);
+    save_takers(writer, M_sRightPenTaken);
+    writer.put(M_prev_ball_pos);
+    writer.put(M_timeover);
+    writer.put(M_first_time);
+}
+
+void PenaltyRef::loadState(rcss::CheckpointReader &reader)
+{
+    reader.get(M_timer);
+    reader.get(M_pen_nr_taken);
+    reader.get(M_pen_side);
+    reader.get(M_cur_pen_taker);
+    load_takers(reader, M_sLeftPenTaken);
+    load_takers(reader, M_sRightPenTaken);
+    reader.get(M_prev_ball_pos);
+    reader.get(M_timeover);
+    reader.get(M_first_time);
+}
+
 void PenaltyRef::penalty_init()
 {
     if (M_bDebug)
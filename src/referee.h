@@ -30,7 +30,9 @@
 #include "object.h"
 
 #include <set>
+#include <utility>
 #include <vector>
+#include <ctime>
 
 // #include <random>
 // #include <ctime>
@@ -41,6 +43,23 @@ class Stadium;
 class Player;
 class Team;
 
+namespace rcss {
+class CheckpointWriter;
+class CheckpointReader;
+}
+
+/*!
+  \struct EpisodeStart
+  \brief the start configuration of a training episode. HFORef and
+  KeepawayRef prepare it and Stadium::resetEpisode() writes it in one
+  pass.
+*/
+struct EpisodeStart
+{
+  PVector ball_;
+  std::vector<std::pair<Player *, PVector>> players_;
+};
+
 class Referee
 {
 private:
@@ -83,6 +102,35 @@ public:
 
   virtual void playModeChange(PlayMode) = 0;
 
+  //! a training episode restarted without a play mode change
+  virtual void newEpisode()
+  {
+  }
+
+  //! the internal state, see Stadium::saveCheckpoint()
+  virtual void saveState(rcss::CheckpointWriter &) const
+  {
+  }
+
+  virtual void loadState(rcss::CheckpointReader &)
+  {
+  }
+
+  //! overrides server::random_seed for referees that have their own engine
+  virtual void setRandomSeed(const int)
+  {
+  }
+
+  /*!
+    \brief abandons the current training episode and starts the next one,
+    see Stadium::restartEpisode().  It returns false if the referee runs
+    no episodes or its first episode was not started by play_on yet.
+  */
+  virtual bool restartEpisode()
+  {
+    return false;
+  }
+
   //
   //
   //
@@ -274,9 +322,12 @@ class TimeRef
     : public Referee
 {
 private:
+  int M_half_time_count;
+
 public:
   explicit TimeRef(Stadium &stadium)
-      : Referee(stadium)
+      : Referee(stadium),
+        M_half_time_count(0)
   {
   }
 
@@ -317,6 +368,9 @@ public:
   void playModeChange(PlayMode)
   {
   }
+
+  void saveState(rcss::CheckpointWriter &writer) const override;
+  void loadState(rcss::CheckpointReader &reader) override;
 };
 
 /*--------------------------------------------------------*/
@@ -373,6 +427,9 @@ public:
   void playModeChange(PlayMode) override
   {
   }
+
+  void saveState(rcss::CheckpointWriter &writer) const override;
+  void loadState(rcss::CheckpointReader &reader) override;
 };
 
 /*--------------------------------------------------------*/
@@ -448,6 +505,11 @@ public:
 
   void playModeChange(PlayMode pm) override;
 
+  void newEpisode() override;
+
+  void saveState(rcss::CheckpointWriter &writer) const override;
+  void loadState(rcss::CheckpointReader &reader) override;
+
 private:
   void checkIntentionalAction(const Player &kicker);
   void setOffsideMark(const Player &kicker,
@@ -513,6 +575,9 @@ public:
 
   void playModeChange(PlayMode pm) override;
 
+  void saveState(rcss::CheckpointWriter &writer) const override;
+  void loadState(rcss::CheckpointReader &reader) override;
+
 private:
   PVector calculateFreeKickPositon(Side side);
 };
@@ -580,6 +645,11 @@ public:
 
   void playModeChange(PlayMode pm) override;
 
+  void newEpisode() override;
+
+  void saveState(rcss::CheckpointWriter &writer) const override;
+  void loadState(rcss::CheckpointReader &reader) override;
+
 private:
   void callFreeKickFault(Side side, PVector pos);
 
@@ -662,6 +732,11 @@ public:
 
   void playModeChange(PlayMode pm) override;
 
+  void newEpisode() override;
+
+  void saveState(rcss::CheckpointWriter &writer) const override;
+  void loadState(rcss::CheckpointReader &reader) override;
+
 private:
   void analyseImpl();
 
@@ -751,6 +826,11 @@ public:
 
   void playModeChange(PlayMode pmode) override;
 
+  void newEpisode() override;
+
+  void saveState(rcss::CheckpointWriter &writer) const override;
+  void loadState(rcss::CheckpointReader &reader) override;
+
 private:
   void callBackPass(const Side side);
 
@@ -813,6 +893,9 @@ public:
 
   void playModeChange(PlayMode pm) override;
 
+  void saveState(rcss::CheckpointWriter &writer) const override;
+  void loadState(rcss::CheckpointReader &reader) override;
+
 private:
   void callFoul(const Player &tackler);
   void callYellowCard(const Player &tackler);
@@ -831,6 +914,8 @@ private:
   int M_keepers, M_takers;
   int M_time;
   int M_take_time;
+  time_t M_start_time;
+  EpisodeStart M_start;
 
 public:
   KeepawayRef(Stadium &stadium);
@@ -875,6 +960,11 @@ public:
 
   void playModeChange(PlayMode pm) override;
 
+  void saveState(rcss::CheckpointWriter &writer) const override;
+  void loadState(rcss::CheckpointReader &reader) override;
+
+  bool restartEpisode() override;
+
 private:
   bool ballInKeepawayArea();
 
@@ -883,6 +973,8 @@ private:
   void logEpisode(const char *endCond);
 
   void resetField();
+
+  void prepareField();
 };
 
 /*--------------------------------------------------------*/
@@ -907,9 +999,11 @@ private:
   PVector M_prev_ball_pos;
   int M_untouched_time;
   int M_episode_over_time;
+  int M_seed; //!< set by setRandomSeed(), negative if not given
   // std::mt19937 M_rng;
   boost::mt19937 M_rng;
   std::vector<std::pair<int, int>> M_offsets;
+  EpisodeStart M_start;
 
 public:
   HFORef(Stadium &stadium);
@@ -954,6 +1048,16 @@ public:
 
   void playModeChange(PlayMode pm) override;
 
+  void saveState(rcss::CheckpointWriter &writer) const override;
+  void loadState(rcss::CheckpointReader &reader) override;
+
+  void setRandomSeed(const int seed) override
+  {
+    M_seed = seed;
+  }
+
+  bool restartEpisode() override;
+
 private:
   bool inHFOArea(const PVector &pos);
 
@@ -962,6 +1066,8 @@ private:
   void logEpisode(const char *endCond);
 
   void resetField();
+
+  void prepareField();
 };
 
 /*--------------------------------------------------------*/
@@ -983,6 +1089,7 @@ private:
   PVector M_prev_ball_pos;
 
   bool M_timeover;
+  bool M_first_time;
 
 public:
   PenaltyRef(Stadium &stadium);
@@ -1019,6 +1126,9 @@ public:
 
   void playModeChange(PlayMode pm) override;
 
+  void saveState(rcss::CheckpointWriter &writer) const override;
+  void loadState(rcss::CheckpointReader &reader) override;
+
 private:
   void startPenaltyShootout();
 
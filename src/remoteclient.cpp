@@ -25,25 +25,60 @@
 
 #include "remoteclient.h"
 
+#include "capture.h"
+#include "commandlog.h"
 #include "param.h"
+#include "shmring.h"
 //#include "rcssexceptions.h"
 
 #include <rcss/net/socketstreambuf.hpp>
 #include <rcss/gzip/gzstream.hpp>
 
+#include <algorithm>
 #include <cerrno>
 #include <cstring>
 
+namespace {
+
+/*!
+  \brief the transport of the clients in a re-simulation, which
+  serializes the messages and drops them.
+*/
+class NullStreamBuf
+    : public std::streambuf {
+protected:
+    int overflow( int c ) override
+      {
+          return traits_type::not_eof( c );
+      }
+
+    std::streamsize xsputn( const char *,
+                            std::streamsize n ) override
+      {
+          return n;
+      }
+};
+
+NullStreamBuf g_null_buf;
+
+}
+
 
 RemoteClient::RemoteClient()
     : M_socket()
     , M_socket_buf( nullptr )
+    , M_shm_ring( nullptr )
+    , M_shm_buf( nullptr )
+    , M_shm_parsed( nullptr )
     , M_gz_buf( nullptr )
     , M_transport( nullptr )
     , M_comp_level( -1 )
     , M_enforce_dedicated_port( false )
+    , M_replay_connected( false )
 {
-    open();
+    // the socket is opened by connect().  until then, e.g. for the
+    // players simulated in process, the messages are dropped.
+    M_transport = new std::ostream( &g_null_buf );
 }
 
 
@@ -70,6 +105,7 @@ void
 RemoteClient::close()
 {
     M_socket.close();
+    M_replay_connected = false;
 
     if ( M_transport )
     {
@@ -89,12 +125,63 @@ RemoteClient::close()
         M_socket_buf = nullptr;
     }
 
+    closeSharedMemory();
+
     setEnforceDedicatedPort( false );
 }
 
+void
+RemoteClient::closeSharedMemory()
+{
+    if ( M_shm_buf )
+    {
+        if ( M_transport )
+        {
+            if ( M_gz_buf )
+            {
+                // the compression buffer writes to the shared memory
+                M_transport->rdbuf( M_socket_buf );
+                delete M_gz_buf;
+                M_gz_buf = nullptr;
+                M_comp_level = -1;
+            }
+            else if ( M_transport->rdbuf() == M_shm_buf )
+            {
+                M_transport->rdbuf( M_socket_buf );
+            }
+        }
+
+        delete M_shm_buf;
+        M_shm_buf = nullptr;
+    }
+
+    if ( M_shm_ring )
+    {
+        // a message of the segment may be parsed in place, see recv()
+        if ( M_shm_ring != M_shm_parsed )
+        {
+            delete M_shm_ring;
+        }
+        M_shm_ring = nullptr;
+    }
+}
+
 bool
 RemoteClient::connect( const rcss::net::Addr & dest )
 {
+    if ( rcss::CommandLog::isReplaying() )
+    {
+        M_replay_dest = dest;
+        M_replay_connected = true;
+        return true;
+    }
+
+    if ( ! M_socket.isOpen()
+         && open() != 0 )
+    {
+        return false;
+    }
+
     if ( ! M_socket.connect( dest ) )
     {
         std::cerr << __FILE__ << ": " << __LINE__
@@ -108,6 +195,15 @@ RemoteClient::connect( const rcss::net::Addr & dest )
 int
 RemoteClient::open()
 {
+    if ( rcss::CommandLog::isReplaying() )
+    {
+        if ( ! M_transport )
+        {
+            M_transport = new std::ostream( &g_null_buf );
+        }
+        return 0;
+    }
+
     if ( M_socket.open() )
     {
         if ( M_socket.setNonBlocking() < 0 )
@@ -128,18 +224,73 @@ RemoteClient::open()
         return -1;
     }
 
-    M_socket_buf = new rcss::net::SocketStreamBuf( M_socket );
-    M_transport = new std::ostream( M_socket_buf );
+    if ( ! M_socket_buf )
+    {
+        M_socket_buf = new rcss::net::SocketStreamBuf( M_socket );
+    }
+
+    if ( M_transport )
+    {
+        // the senders keep a reference to the transport
+        M_transport->rdbuf( M_socket_buf );
+    }
+    else
+    {
+        M_transport = new std::ostream( M_socket_buf );
+    }
     //M_transport->setLevel( M_comp_level );
     return 0;
 }
 
+bool
+RemoteClient::openSharedMemory( const std::string & name )
+{
+    if ( ! M_socket.isConnected()
+         || ! M_transport
+         || M_shm_ring )
+    {
+        return false;
+    }
+
+    M_shm_ring = new rcss::ShmRing();
+    if ( ! M_shm_ring->create( name ) )
+    {
+        delete M_shm_ring;
+        M_shm_ring = nullptr;
+        return false;
+    }
+
+    M_shm_buf = new rcss::ShmRingStreamBuf( *M_shm_ring );
+    M_transport->flush();
+    M_transport->rdbuf( M_gz_buf ? static_cast< std::streambuf * >( M_gz_buf ) : M_shm_buf );
+    return true;
+}
+
 int
 RemoteClient::send( const char * msg,
                     const size_t & len )
 {
+    if ( M_replay_connected )
+    {
+        if ( rcss::CommandLog::nextDisconnect( M_replay_dest ) )
+        {
+            close();
+        }
+        else
+        {
+            M_transport->write( msg, len );
+            M_transport->flush();
+        }
+        return len;
+    }
+
     if ( M_socket.isConnected() )
     {
+        if ( rcss::Capture::isOpen() )
+        {
+            rcss::Capture::record( rcss::Capture::OUTBOUND, M_socket.getDest(), 0, msg, len );
+        }
+
         M_transport->write( msg, len );
         M_transport->flush();
         if ( ! M_transport->good() )
@@ -151,6 +302,7 @@ RemoteClient::send( const char * msg,
                           << strerror( errno ) << std::endl
                           << "msg = [" << msg << "]\n";
             }
+            rcss::CommandLog::recordDisconnect( M_socket.getDest() );
             close();
         }
 
@@ -162,10 +314,66 @@ RemoteClient::send( const char * msg,
 int
 RemoteClient::recv()
 {
+    if ( M_replay_connected )
+    {
+        // one extra byte for the terminator added by the parsers
+        char buffer[ MaxMesg + 1 ];
+
+        if ( rcss::CommandLog::nextDisconnect( M_replay_dest ) )
+        {
+            close();
+            return -1;
+        }
+
+        rcss::net::Addr from;
+        const int ret = rcss::CommandLog::nextMessage( rcss::CommandLog::DEDICATED,
+                                                       &M_replay_dest, from,
+                                                       buffer, MaxMesg );
+        if ( ret > 0 )
+        {
+            processMsg( buffer, ret );
+        }
+        return ret;
+    }
+
+    if ( M_shm_ring )
+    {
+        // the message is parsed in place. the padding behind it takes
+        // the terminator added by the parsers.
+        size_t len = 0;
+        char * msg = M_shm_ring->front( len );
+        if ( ! msg )
+        {
+            return -1;
+        }
+        len = std::min< size_t >( len, MaxMesg );
+
+        if ( rcss::CommandLog::isRecording() )
+        {
+            rcss::CommandLog::recordMessage( rcss::CommandLog::DEDICATED,
+                                             M_socket.getDest(), msg, len );
+        }
+
+        // the segment is kept mapped if the message closes the client
+        M_shm_parsed = M_shm_ring;
+        processMsg( msg, len );
+        if ( M_shm_ring == M_shm_parsed )
+        {
+            M_shm_ring->pop();
+        }
+        else
+        {
+            delete M_shm_parsed;
+        }
+        M_shm_parsed = nullptr;
+
+        return static_cast< int >( len );
+    }
+
     if ( M_socket.isConnected() )
     {
-        char buffer[ MaxMesg ];
-        std::memset( &buffer, 0, sizeof( char ) * MaxMesg );
+        // one extra byte for the terminator added by the parsers
+        char buffer[ MaxMesg + 1 ];
 
         size_t len = MaxMesg;
         int ret = M_socket.recv( buffer, len );
@@ -178,10 +386,21 @@ RemoteClient::recv()
                           << ": Error receiving from socket: "
                           << strerror( errno ) << std::endl;
             }
+            rcss::CommandLog::recordDisconnect( M_socket.getDest() );
             close();
         }
         else if ( ret > 0 )
         {
+            if ( rcss::Capture::isOpen() )
+            {
+                rcss::Capture::record( rcss::Capture::INBOUND, M_socket.getDest(), 0, buffer, ret );
+            }
+            if ( rcss::CommandLog::isRecording() )
+            {
+                rcss::CommandLog::recordMessage( rcss::CommandLog::DEDICATED,
+                                                 M_socket.getDest(), buffer, ret );
+            }
+
             processMsg( buffer, ret );
         }
         return ret;
@@ -208,6 +427,8 @@ void
 RemoteClient::processMsg( char * msg,
                           const size_t & len )
 {
+    M_latency.commandReceived();
+
 #ifdef HAVE_LIBZ
     if ( M_comp_level >= 0 )
     {
@@ -233,15 +454,27 @@ RemoteClient::setCompressionLevel( const int level )
 #ifdef HAVE_LIBZ
     //M_transport->setLevel( level );
 
+    if ( M_replay_connected )
+    {
+        // nothing is sent, only the received messages are decompressed
+        return M_comp_level = level;
+    }
+
     if ( level >= 0 )
     {
         if ( ! M_gz_buf )
         {
-            M_gz_buf = new rcss::gz::gzstreambuf( *M_socket_buf );
+            M_gz_buf = ( M_shm_buf
+                         ? new rcss::gz::gzstreambuf( *M_shm_buf )
+                         : new rcss::gz::gzstreambuf( *M_socket_buf ) );
         }
         M_gz_buf->setLevel( level );
         M_transport->rdbuf( M_gz_buf );
     }
+    else if ( M_shm_buf )
+    {
+        M_transport->rdbuf( M_shm_buf );
+    }
     else
     {
         M_transport->rdbuf( M_socket_buf );
@@ -22,10 +22,13 @@
 #ifndef RCSS_REMOTECLIENT_H
 #define RCSS_REMOTECLIENT_H
 
+#include "clientlatency.h"
 #include "compress.h"
 
 #include <rcss/net/udpsocket.hpp>
 
+#include <string>
+
 namespace rcss {
 namespace net {
 class SocketStreamBuf;
@@ -33,6 +36,8 @@ class SocketStreamBuf;
 namespace gz {
 class gzstreambuf;
 }
+class ShmRing;
+class ShmRingStreamBuf;
 }
 
 
@@ -41,6 +46,9 @@ class RemoteClient {
 private:
     rcss::net::UDPSocket M_socket;
     rcss::net::SocketStreamBuf * M_socket_buf;
+    rcss::ShmRing * M_shm_ring;
+    rcss::ShmRingStreamBuf * M_shm_buf;
+    rcss::ShmRing * M_shm_parsed; //!< the segment of the message being parsed
     rcss::gz::gzstreambuf * M_gz_buf;
     std::ostream * M_transport;
     int M_comp_level;
@@ -52,6 +60,12 @@ private:
 
     bool M_enforce_dedicated_port;
 
+    //! the client of a re-simulated command log, which has no socket
+    rcss::net::Addr M_replay_dest;
+    bool M_replay_connected;
+
+    rcss::ClientLatency M_latency;
+
 public:
     RemoteClient();
 
@@ -71,6 +85,16 @@ public:
     void undedicatedRecv( char * msg,
                           const size_t & len );
 
+    rcss::ClientLatency & latency()
+      {
+          return M_latency;
+      }
+
+    const rcss::ClientLatency & latency() const
+      {
+          return M_latency;
+      }
+
 protected:
     void processMsg( char * msg,
                      const size_t & len );
@@ -95,16 +119,29 @@ protected:
 public:
     bool connected() const
       {
-          return M_socket.isConnected();
+          return M_replay_connected || M_socket.isConnected();
       }
 
     bool connect( const rcss::net::Addr & dest );
 
     int open();
 
+    /*!
+      \brief move the message exchange from the UDP socket to a new
+      shared memory segment. The client must be connected.
+      \param name segment name without the leading slash
+      \return true if the segment has been created.
+    */
+    bool openSharedMemory( const std::string & name );
+
+    //! move the message exchange back to the UDP socket
+    void closeSharedMemory();
+
     rcss::net::Addr getDest() const
       {
-          return M_socket.getDest();
+          return ( M_replay_connected
+                   ? M_replay_dest
+                   : M_socket.getDest() );
       }
 
 };
@@ -0,0 +1,81 @@
+// -*-c++-*-
+
+/***************************************************************************
+                               replaytimer.cpp
+              The timer of the offline re-simulation of a command log
+                             -------------------
+    begin                : 2026-10-18
+    copyright            : (C) 2026 by The RoboCup Soccer Server
+                           Maintenance Group.
+    email                : sserver-admin@lists.sourceforge.net
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU LGPL as published by the Free Software  *
+ *   Foundation; either version 3 of the License, or (at your option) any  *
+ *   later version.                                                        *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "replaytimer.h"
+
+#include "commandlog.h"
+#include "timeable.h"
+
+#include <chrono>
+#include <iostream>
+
+void
+ReplayTimer::run()
+{
+    const std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+    unsigned long steps = 0;
+
+    rcss::CommandLog::Callback cb;
+    while ( getTimeableRef().alive()
+            && rcss::CommandLog::nextCallback( cb ) )
+    {
+        switch ( cb ) {
+        case rcss::CommandLog::RECV_FROM_CLIENTS:
+            getTimeableRef().recvFromClients();
+            break;
+        case rcss::CommandLog::NEW_SIMULATOR_STEP:
+            getTimeableRef().newSimulatorStep();
+            ++steps;
+            break;
+        case rcss::CommandLog::SEND_SENSE_BODY:
+            getTimeableRef().sendSenseBody();
+            break;
+        case rcss::CommandLog::SEND_VISUALS:
+            getTimeableRef().sendVisuals();
+            break;
+        case rcss::CommandLog::SEND_SYNCH_VISUALS:
+            getTimeableRef().sendSynchVisuals();
+            break;
+        case rcss::CommandLog::SEND_COACH_MESSAGES:
+            getTimeableRef().sendCoachMessages();
+            break;
+        case rcss::CommandLog::SEND_THINK:
+            getTimeableRef().sendThink();
+            break;
+        }
+    }
+
+    const double elapsed
+        = std::chrono::duration_cast< std::chrono::duration< double > >
+        ( std::chrono::steady_clock::now() - start_time ).count();
+
+    std::cout << "(resimulation (steps " << steps << ')'
+              << " (seconds " << elapsed << ')'
+              << " (steps_per_second " << ( elapsed > 0.0 ? steps / elapsed : 0.0 ) << ')'
+              << " (skipped_records " << rcss::CommandLog::skippedRecords() << "))"
+              << std::endl;
+
+    getTimeableRef().quit();
+}
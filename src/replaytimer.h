@@ -0,0 +1,42 @@
+// -*-c++-*-
+
+/***************************************************************************
+                                replaytimer.h
+              The timer of the offline re-simulation of a command log
+                             -------------------
+    begin                : 2026-10-18
+    copyright            : (C) 2026 by The RoboCup Soccer Server
+                           Maintenance Group.
+    email                : sserver-admin@lists.sourceforge.net
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU LGPL as published by the Free Software  *
+ *   Foundation; either version 3 of the License, or (at your option) any  *
+ *   later version.                                                        *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef REPLAYTIMER_H
+#define REPLAYTIMER_H
+
+#include "timer.h"
+
+/** This is a subclass of the timer class. The run method calls the
+    callbacks in the order of the command log opened with
+    rcss::CommandLog::openReplay, without sleeping, until the log ends. */
+class ReplayTimer
+    : public Timer
+{
+public:
+    explicit
+    ReplayTimer( Timeable &timeable )
+        : Timer( timeable )
+    { }
+
+    void run() override;
+};
+
+#endif
@@ -28,6 +28,7 @@
 
 #include <memory>
 #include <iostream>
+#include <vector>
 
 class Ball;
 class PVector;
@@ -340,6 +341,7 @@ public:
     void serializeVisualEnd( std::ostream & ) const
       { }
 
+    virtual
     void serializeVisualObject( std::ostream & strm,
                                 const std::string & name,
                                 const int dir ) const
@@ -347,6 +349,7 @@ public:
           strm << " (" << name << ' ' << dir << ')';
       }
 
+    virtual
     void serializeVisualObject( std::ostream & strm,
                                 const std::string & name,
                                 const double & dist,
@@ -355,6 +358,7 @@ public:
           strm << " (" << name << ' ' << dist << ' ' << dir << ')';
       }
 
+    virtual
     void serializeVisualObject( std::ostream & strm,
                                 const std::string & name,
                                 const double & dist,
@@ -367,6 +371,7 @@ public:
                << ')';
       }
 
+    virtual
     void serializeVisualObject( std::ostream & strm,
                                 const std::string & name,
                                 const double & dist,
@@ -381,6 +386,7 @@ public:
                << ')';
       }
 
+    virtual
     void serializeVisualObject( std::ostream & strm,
                                 const std::string & name,
                                 const double & dist,
@@ -634,6 +640,12 @@ public:
     void serializeFSPlayerEnd( std::ostream & ) const
       { }
 
+    virtual
+    void serializeHFOFeatures( std::ostream &,
+                               const int /* time */,
+                               const std::vector< float > & ) const
+      { }
+
     virtual
     void serializeInit( std::ostream &,
                         const char *,
@@ -68,7 +68,7 @@ SerializerCoachStdv1::serializeCoachStdAudio( std::ostream & strm,
                                               const rcss::clang::Msg & msg ) const
 {
     strm << "(hear " << name << ' ' << time
-         << ' ' << msg << ')';
+         << ' ' << msg.text() << ')';
 }
 
 void
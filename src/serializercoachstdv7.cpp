@@ -59,7 +59,7 @@ SerializerCoachStdv7::serializeCoachStdAudio( std::ostream & strm,
                                               const rcss::clang::Msg & msg ) const
 {
     strm << "(hear " << time << ' ' << name
-         << " \"" << msg << "\")";
+         << " \"" << msg.text() << "\")";
 }
 
 void
@@ -0,0 +1,754 @@
+// -*-c++-*-
+
+/***************************************************************************
+                         serializerplayerbinary.cpp
+              Class for serializing data to binary protocol players
+                             -------------------
+    begin                : 2026-10-18
+    copyright            : (C) 2026 by The RoboCup Soccer Server
+                           Maintenance Group.
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU LGPL as published by the Free Software  *
+ *   Foundation; either version 3 of the License, or (at your option) any  *
+ *   later version.                                                        *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "serializerplayerbinary.h"
+
+#include "binaryprotocol.h"
+#include "player.h"
+
+#include <rcss/clang/clangmsg.h>
+
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+
+namespace rcss {
+
+namespace {
+
+// keeps a record with two strings below the 16 bit record length
+const std::size_t MAX_STRING = 0x7fff;
+
+std::size_t
+string_size( const std::size_t len )
+{
+    return 2 + std::min( len, MAX_STRING );
+}
+
+void
+put_u8( std::ostream & strm,
+        const int v )
+{
+    strm.put( static_cast< char >( v ) );
+}
+
+void
+put_i32( std::ostream & strm,
+         const int v )
+{
+    char buf[4];
+    binary::put_u32( buf, static_cast< std::uint32_t >( v ) );
+    strm.write( buf, 4 );
+}
+
+void
+put_f32( std::ostream & strm,
+         const double & v )
+{
+    char buf[4];
+    binary::put_f32( buf, static_cast< float >( v ) );
+    strm.write( buf, 4 );
+}
+
+void
+put_string( std::ostream & strm,
+            const char * s,
+            const std::size_t len )
+{
+    const std::size_t n = std::min( len, MAX_STRING );
+    char buf[2];
+    binary::put_u16( buf, static_cast< std::uint16_t >( n ) );
+    strm.write( buf, 2 );
+    strm.write( s, n );
+}
+
+void
+put_header( std::ostream & strm,
+            const binary::Kind kind,
+            const int time )
+{
+    put_u8( strm, binary::MAGIC );
+    put_u8( strm, kind );
+    put_i32( strm, time );
+}
+
+void
+put_record( std::ostream & strm,
+            const int tag,
+            const std::size_t len )
+{
+    char buf[3];
+    buf[0] = static_cast< char >( tag );
+    binary::put_u16( buf + 1, static_cast< std::uint16_t >( len ) );
+    strm.write( buf, 3 );
+}
+
+void
+put_string_record( std::ostream & strm,
+                   const int tag,
+                   const char * s )
+{
+    const std::size_t len = std::strlen( s );
+    put_record( strm, tag, string_size( len ) );
+    put_string( strm, s, len );
+}
+
+void
+put_reals( std::ostream & strm,
+           const int tag,
+           std::initializer_list< double > values )
+{
+    put_record( strm, tag, 4 * values.size() );
+    for ( double v : values )
+    {
+        put_f32( strm, v );
+    }
+}
+
+void
+put_ints( std::ostream & strm,
+          const int tag,
+          std::initializer_list< int > values )
+{
+    put_record( strm, tag, 4 * values.size() );
+    for ( int v : values )
+    {
+        put_i32( strm, v );
+    }
+}
+
+void
+put_visual( std::ostream & strm,
+            const std::string & name,
+            const int fields,
+            std::initializer_list< double > values )
+{
+    put_record( strm, binary::OBJECT,
+                string_size( name.size() ) + 1 + 4 * values.size() );
+    put_string( strm, name.data(), name.size() );
+    put_u8( strm, fields );
+    for ( double v : values )
+    {
+        put_f32( strm, v );
+    }
+}
+
+void
+put_visual_player( std::ostream & strm,
+                   const Player & player,
+                   const std::string & name,
+                   const int fields,
+                   std::initializer_list< double > values )
+{
+    put_record( strm, binary::PLAYER,
+                string_size( name.size() ) + 2 + 4 * values.size() );
+    put_string( strm, name.data(), name.size() );
+    put_u8( strm, fields );
+    put_u8( strm,
+            ( player.isTackling() ? binary::STATE_TACKLE
+              : player.kicked() ? binary::STATE_KICK
+              : 0 ) );
+    for ( double v : values )
+    {
+        put_f32( strm, v );
+    }
+}
+
+void
+put_view_mode( std::ostream & strm,
+               const char * qual,
+               const char * width )
+{
+    const std::size_t qual_len = std::strlen( qual );
+    const std::size_t width_len = std::strlen( width );
+    put_record( strm, binary::VIEW_MODE,
+                string_size( qual_len ) + string_size( width_len ) );
+    put_string( strm, qual, qual_len );
+    put_string( strm, width, width_len );
+}
+
+}
+
+
+SerializerPlayerBinary::SerializerPlayerBinary( const SerializerCommon::Ptr common )
+    : SerializerPlayerStdv18( common )
+{
+
+}
+
+SerializerPlayerBinary::~SerializerPlayerBinary()
+{
+
+}
+
+void
+SerializerPlayerBinary::serializeRefereeAudio( std::ostream & strm,
+                                               const int time,
+                                               const char * msg ) const
+{
+    put_header( strm, binary::HEAR, time );
+    put_string_record( strm, binary::HEAR_REFEREE, msg );
+}
+
+void
+SerializerPlayerBinary::serializeCoachAudio( std::ostream & strm,
+                                             const int time,
+                                             const std::string & name,
+                                             const char * msg ) const
+{
+    const std::size_t len = std::strlen( msg );
+    put_header( strm, binary::HEAR, time );
+    put_record( strm, binary::HEAR_COACH,
+                string_size( name.size() ) + string_size( len ) );
+    put_string( strm, name.data(), name.size() );
+    put_string( strm, msg, len );
+}
+
+void
+SerializerPlayerBinary::serializeCoachStdAudio( std::ostream & strm,
+                                                const int time,
+                                                const std::string & name,
+                                                const rcss::clang::Msg & msg ) const
+{
+    serializeCoachAudio( strm, time, name, msg.text().c_str() );
+}
+
+void
+SerializerPlayerBinary::serializeSelfAudio( std::ostream & strm,
+                                            const int time,
+                                            const char * msg ) const
+{
+    put_header( strm, binary::HEAR, time );
+    put_string_record( strm, binary::HEAR_SELF, msg );
+}
+
+void
+SerializerPlayerBinary::serializePlayerAudio( std::ostream & strm,
+                                              const int time,
+                                              const double & dir,
+                                              const char * msg ) const
+{
+    const std::size_t len = std::strlen( msg );
+    put_header( strm, binary::HEAR, time );
+    put_record( strm, binary::HEAR_PLAYER, 4 + string_size( len ) );
+    put_f32( strm, dir );
+    put_string( strm, msg, len );
+}
+
+void
+SerializerPlayerBinary::serializeAllyAudioFull( std::ostream & strm,
+                                                const int time,
+                                                const double & dir,
+                                                const int unum,
+                                                const char * msg ) const
+{
+    const std::size_t len = std::strlen( msg );
+    put_header( strm, binary::HEAR, time );
+    put_record( strm, binary::HEAR_ALLY, 8 + string_size( len ) );
+    put_f32( strm, dir );
+    put_i32( strm, unum );
+    put_string( strm, msg, len );
+}
+
+void
+SerializerPlayerBinary::serializeOppAudioFull( std::ostream & strm,
+                                               const int time,
+                                               const double & dir,
+                                               const char * msg ) const
+{
+    const std::size_t len = std::strlen( msg );
+    put_header( strm, binary::HEAR, time );
+    put_record( strm, binary::HEAR_OPP, 4 + string_size( len ) );
+    put_f32( strm, dir );
+    put_string( strm, msg, len );
+}
+
+void
+SerializerPlayerBinary::serializeAllyAudioShort( std::ostream & strm,
+                                                 const int time,
+                                                 const int unum ) const
+{
+    put_header( strm, binary::HEAR, time );
+    put_ints( strm, binary::HEAR_ALLY_SHORT, { unum } );
+}
+
+void
+SerializerPlayerBinary::serializeOppAudioShort( std::ostream & strm,
+                                                const int time ) const
+{
+    put_header( strm, binary::HEAR, time );
+    put_record( strm, binary::HEAR_OPP_SHORT, 0 );
+}
+
+
+void
+SerializerPlayerBinary::serializeVisualBegin( std::ostream & strm,
+                                              const int time ) const
+{
+    put_header( strm, binary::SEE, time );
+}
+
+void
+SerializerPlayerBinary::serializeVisualEnd( std::ostream & ) const
+{
+    // the message is closed by the END byte.
+}
+
+void
+SerializerPlayerBinary::serializeVisualObject( std::ostream & strm,
+                                               const std::string & name,
+                                               const int dir ) const
+{
+    put_visual( strm, name, binary::FIELD_DIR, { double( dir ) } );
+}
+
+void
+SerializerPlayerBinary::serializeVisualObject( std::ostream & strm,
+                                               const std::string & name,
+                                               const double & dist,
+                                               const int dir ) const
+{
+    put_visual( strm, name,
+                binary::FIELD_DIST | binary::FIELD_DIR,
+                { dist, double( dir ) } );
+}
+
+void
+SerializerPlayerBinary::serializeVisualObject( std::ostream & strm,
+                                               const std::string & name,
+                                               const double & dist,
+                                               const int dir,
+                                               const double & dist_chg,
+                                               const double & dir_chg ) const
+{
+    put_visual( strm, name,
+                binary::FIELD_DIST | binary::FIELD_DIR | binary::FIELD_CHANGE,
+                { dist, double( dir ), dist_chg, dir_chg } );
+}
+
+void
+SerializerPlayerBinary::serializeVisualObject( std::ostream & strm,
+                                               const std::string & name,
+                                               const double & dist,
+                                               const int dir,
+                                               const double & dist_chg,
+                                               const double & dir_chg,
+                                               const int body_dir ) const
+{
+    put_visual( strm, name,
+                binary::FIELD_DIST | binary::FIELD_DIR | binary::FIELD_CHANGE
+                | binary::FIELD_BODY,
+                { dist, double( dir ), dist_chg, dir_chg, double( body_dir ) } );
+}
+
+void
+SerializerPlayerBinary::serializeVisualObject( std::ostream & strm,
+                                               const std::string & name,
+                                               const double & dist,
+                                               const int dir,
+                                               const double & dist_chg,
+                                               const double & dir_chg,
+                                               const int body_dir,
+                                               const int head_dir ) const
+{
+    put_visual( strm, name,
+                binary::FIELD_DIST | binary::FIELD_DIR | binary::FIELD_CHANGE
+                | binary::FIELD_BODY | binary::FIELD_HEAD,
+                { dist, double( dir ), dist_chg, dir_chg,
+                  double( body_dir ), double( head_dir ) } );
+}
+
+void
+SerializerPlayerBinary::serializeVisualPlayer( std::ostream & strm,
+                                               const Player & player,
+                                               const std::string & name,
+                                               const double & dist,
+                                               const int dir ) const
+{
+    put_visual_player( strm, player, name,
+                       binary::FIELD_DIST | binary::FIELD_DIR,
+                       { dist, double( dir ) } );
+}
+
+void
+SerializerPlayerBinary::serializeVisualPlayer( std::ostream & strm,
+                                               const Player & player,
+                                               const std::string & name,
+                                               const double & dist,
+                                               const int dir,
+                                               const int point_dir ) const
+{
+    put_visual_player( strm, player, name,
+                       binary::FIELD_DIST | binary::FIELD_DIR | binary::FIELD_POINT,
+                       { dist, double( dir ), double( point_dir ) } );
+}
+
+void
+SerializerPlayerBinary::serializeVisualPlayer( std::ostream & strm,
+                                               const Player & player,
+                                               const std::string & name,
+                                               const double & dist,
+                                               const int dir,
+                                               const double & dist_chg,
+                                               const double & dir_chg,
+                                               const int body_dir,
+                                               const int head_dir ) const
+{
+    put_visual_player( strm, player, name,
+                       binary::FIELD_DIST | binary::FIELD_DIR | binary::FIELD_CHANGE
+                       | binary::FIELD_BODY | binary::FIELD_HEAD,
+                       { dist, double( dir ), dist_chg, dir_chg,
+                         double( body_dir ), double( head_dir ) } );
+}
+
+void
+SerializerPlayerBinary::serializeVisualPlayer( std::ostream & strm,
+                                               const Player & player,
+                                               const std::string & name,
+                                               const double & dist,
+                                               const int dir,
+                                               const double & dist_chg,
+                                               const double & dir_chg,
+                                               const int body_dir,
+                                               const int head_dir,
+                                               const int point_dir ) const
+{
+    put_visual_player( strm, player, name,
+                       binary::FIELD_DIST | binary::FIELD_DIR | binary::FIELD_CHANGE
+                       | binary::FIELD_BODY | binary::FIELD_HEAD | binary::FIELD_POINT,
+                       { dist, double( dir ), dist_chg, dir_chg,
+                         double( body_dir ), double( head_dir ), double( point_dir ) } );
+}
+
+
+void
+SerializerPlayerBinary::serializeBodyBegin( std::ostream & strm,
+                                            const int time ) const
+{
+    put_header( strm, binary::SENSE_BODY, time );
+}
+
+void
+SerializerPlayerBinary::serializeBodyEnd( std::ostream & ) const
+{
+
+}
+
+void
+SerializerPlayerBinary::serializeBodyViewMode( std::ostream & strm,
+                                               const char * qual,
+                                               const char * width ) const
+{
+    put_view_mode( strm, qual, width );
+}
+
+void
+SerializerPlayerBinary::serializeBodyStamina( std::ostream & strm,
+                                              const double & stamina,
+                                              const double & effort,
+                                              const double & stamina_capacity ) const
+{
+    put_reals( strm, binary::STAMINA, { stamina, effort, stamina_capacity } );
+}
+
+void
+SerializerPlayerBinary::serializeBodyVelocity( std::ostream & strm,
+                                               const double & mag ) const
+{
+    put_reals( strm, binary::SPEED, { mag } );
+}
+
+void
+SerializerPlayerBinary::serializeBodyVelocity( std::ostream & strm,
+                                               const double & mag,
+                                               const int head ) const
+{
+    put_reals( strm, binary::SPEED, { mag, double( head ) } );
+}
+
+void
+SerializerPlayerBinary::serializeBodyCounts( std::ostream & strm,
+                                             const Player & self ) const
+{
+    put_ints( strm, binary::BODY_COUNTS,
+              { self.kickCount(),
+                self.dashCount(),
+                self.turnCount(),
+                self.sayCount(),
+                self.turnNeckCount(),
+                self.catchCount(),
+                self.moveCount(),
+                self.changeViewCount(),
+                self.changeFocusCount() } );
+}
+
+void
+SerializerPlayerBinary::serializeNeckAngle( std::ostream & strm,
+                                            const int ang ) const
+{
+    put_reals( strm, binary::HEAD_ANGLE, { double( ang ) } );
+}
+
+void
+SerializerPlayerBinary::serializeArm( std::ostream & strm,
+                                      const int movable_cycles,
+                                      const int expires_cycles,
+                                      const double & dist,
+                                      const int head,
+                                      const int count ) const
+{
+    put_record( strm, binary::ARM, 4 * 5 );
+    put_i32( strm, movable_cycles );
+    put_i32( strm, expires_cycles );
+    put_f32( strm, dist );
+    put_f32( strm, head );
+    put_i32( strm, count );
+}
+
+void
+SerializerPlayerBinary::serializeFocus( std::ostream & strm,
+                                        const char * name,
+                                        const int count ) const
+{
+    serializeFocus( strm, name, -1, count );
+}
+
+void
+SerializerPlayerBinary::serializeFocus( std::ostream & strm,
+                                        const char * team,
+                                        const int unum,
+                                        const int count ) const
+{
+    const std::size_t len = std::strlen( team );
+    put_record( strm, binary::FOCUS, string_size( len ) + 8 );
+    put_string( strm, team, len );
+    put_i32( strm, unum );
+    put_i32( strm, count );
+}
+
+void
+SerializerPlayerBinary::serializeTackle( std::ostream & strm,
+                                         const int cycles,
+                                         const int count ) const
+{
+    put_ints( strm, binary::TACKLE, { cycles, count } );
+}
+
+void
+SerializerPlayerBinary::serializeCollision( std::ostream & strm,
+                                            const bool ball_collide,
+                                            const bool player_collide,
+                                            const bool post_collide ) const
+{
+    put_record( strm, binary::COLLISION, 1 );
+    put_u8( strm,
+            ( ball_collide ? binary::COLLIDE_BALL : 0 )
+            | ( player_collide ? binary::COLLIDE_PLAYER : 0 )
+            | ( post_collide ? binary::COLLIDE_POST : 0 ) );
+}
+
+void
+SerializerPlayerBinary::serializeFoul( std::ostream & strm,
+                                       const Player & self ) const
+{
+    put_record( strm, binary::FOUL, 5 );
+    put_i32( strm, self.foulCycles() );
+    put_u8( strm,
+            ( self.hasRedCard() ? 2
+              : self.hasYellowCard() ? 1
+              : 0 ) );
+}
+
+void
+SerializerPlayerBinary::serializeFocusPoint( std::ostream & strm,
+                                             const Player & self ) const
+{
+    put_reals( strm, binary::FOCUS_POINT,
+               { self.focusDist(), Rad2Deg( self.focusDir() ) } );
+}
+
+
+void
+SerializerPlayerBinary::serializeFSBegin( std::ostream & strm,
+                                          const int time ) const
+{
+    put_header( strm, binary::FULLSTATE, time );
+}
+
+void
+SerializerPlayerBinary::serializeFSEnd( std::ostream & ) const
+{
+
+}
+
+void
+SerializerPlayerBinary::serializeFSPlayMode( std::ostream & strm,
+                                             const char * mode ) const
+{
+    put_string_record( strm, binary::PLAY_MODE, mode );
+}
+
+void
+SerializerPlayerBinary::serializeFSViewMode( std::ostream & strm,
+                                             const char * qual,
+                                             const char * width ) const
+{
+    put_view_mode( strm, qual, width );
+}
+
+void
+SerializerPlayerBinary::serializeFSCounts( std::ostream & strm,
+                                           const Player & self ) const
+{
+    put_ints( strm, binary::FS_COUNTS,
+              { self.kickCount(),
+                self.dashCount(),
+                self.turnCount(),
+                self.catchCount(),
+                self.moveCount(),
+                self.turnNeckCount(),
+                self.changeViewCount(),
+                self.sayCount(),
+                self.changeFocusCount() } );
+}
+
+void
+SerializerPlayerBinary::serializeFSScore( std::ostream & strm,
+                                          const int left,
+                                          const int right ) const
+{
+    put_ints( strm, binary::SCORE, { left, right } );
+}
+
+void
+SerializerPlayerBinary::serializeFSBall( std::ostream & strm,
+                                         const double & x,
+                                         const double & y,
+                                         const double & vel_x,
+                                         const double & vel_y ) const
+{
+    put_reals( strm, binary::BALL, { x, y, vel_x, vel_y } );
+}
+
+void
+SerializerPlayerBinary::serializeFSPlayerBegin( std::ostream & strm,
+                                                const char side,
+                                                const int unum,
+                                                const bool goalie,
+                                                const int type,
+                                                const double & x,
+                                                const double & y,
+                                                const double & vel_x,
+                                                const double & vel_y,
+                                                const double & body_dir,
+                                                const double & neck_dir ) const
+{
+    put_record( strm, binary::FS_PLAYER, 1 + 4 + 1 + 4 + 4 * 6 );
+    put_u8( strm, side );
+    put_i32( strm, unum );
+    put_u8( strm, goalie ? 1 : 0 );
+    put_i32( strm, type );
+    put_f32( strm, x );
+    put_f32( strm, y );
+    put_f32( strm, vel_x );
+    put_f32( strm, vel_y );
+    put_f32( strm, body_dir );
+    put_f32( strm, neck_dir );
+}
+
+void
+SerializerPlayerBinary::serializeFSPlayerFocus( std::ostream & strm,
+                                                const Player & p ) const
+{
+    put_reals( strm, binary::FS_PLAYER_FOCUS,
+               { p.focusDist(), Rad2Deg( p.focusDir() ) } );
+}
+
+void
+SerializerPlayerBinary::serializeFSPlayerArm( std::ostream & strm,
+                                              const double & mag,
+                                              const double & head ) const
+{
+    put_reals( strm, binary::FS_PLAYER_ARM, { mag, head } );
+}
+
+void
+SerializerPlayerBinary::serializeFSPlayerStamina( std::ostream & strm,
+                                                  const double & stamina,
+                                                  const double & effort,
+                                                  const double & recovery,
+                                                  const double & stamina_capacity ) const
+{
+    put_reals( strm, binary::FS_PLAYER_STAMINA,
+               { stamina, effort, recovery, stamina_capacity } );
+}
+
+void
+SerializerPlayerBinary::serializeFSPlayerState( std::ostream & strm,
+                                                const Player & player ) const
+{
+    put_record( strm, binary::FS_PLAYER_STATE, 1 );
+    put_u8( strm,
+            ( player.isTackling() ? binary::STATE_TACKLE : 0 )
+            | ( player.kicked() ? binary::STATE_KICK : 0 )
+            | ( player.foulCycles() > 0 ? binary::STATE_FOUL : 0 )
+            | ( player.hasYellowCard() ? binary::STATE_YELLOW_CARD : 0 )
+            | ( player.hasRedCard() ? binary::STATE_RED_CARD : 0 ) );
+}
+
+void
+SerializerPlayerBinary::serializeFSPlayerEnd( std::ostream & ) const
+{
+
+}
+
+void
+SerializerPlayerBinary::serializeHFOFeatures( std::ostream & strm,
+                                              const int time,
+                                              const std::vector< float > & features ) const
+{
+    put_header( strm, binary::FEATURES, time );
+    put_record( strm, binary::FEATURE_VECTOR, 4 * features.size() );
+    for ( float v : features )
+    {
+        put_f32( strm, v );
+    }
+}
+
+
+const
+SerializerPlayer::Ptr
+SerializerPlayerBinary::create()
+{
+    SerializerCommon::Creator cre;
+    if ( ! SerializerCommon::factory().getCreator( cre, 18 ) )
+    {
+        return SerializerPlayer::Ptr();
+    }
+
+    SerializerPlayer::Ptr ptr( new SerializerPlayerBinary( cre() ) );
+    return ptr;
+}
+
+}
@@ -0,0 +1,302 @@
+// -*-c++-*-
+
+/***************************************************************************
+                          serializerplayerbinary.h
+              Class for serializing data to binary protocol players
+                             -------------------
+    begin                : 2026-10-18
+    copyright            : (C) 2026 by The RoboCup Soccer Server
+                           Maintenance Group.
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU LGPL as published by the Free Software  *
+ *   Foundation; either version 3 of the License, or (at your option) any  *
+ *   later version.                                                        *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef SERIALIZERPLAYERBINARY_H
+#define SERIALIZERPLAYERBINARY_H
+
+#include "serializerplayerstdv18.h"
+
+namespace rcss {
+
+/*!
+  \class SerializerPlayerBinary
+  \brief writes the sensor messages in the format of binaryprotocol.h.
+  Everything else is inherited from the v18 text serializer.
+*/
+class SerializerPlayerBinary
+    : public SerializerPlayerStdv18 {
+protected:
+    SerializerPlayerBinary( const SerializerCommon::Ptr common );
+
+public:
+    virtual
+    ~SerializerPlayerBinary() override;
+
+    static
+    const
+    SerializerPlayer::Ptr create();
+
+    //
+    // hear
+    //
+
+    virtual
+    void serializeRefereeAudio( std::ostream & strm,
+                                const int time,
+                                const char * msg ) const override;
+    virtual
+    void serializeCoachAudio( std::ostream & strm,
+                              const int time,
+                              const std::string & name,
+                              const char * msg ) const override;
+    virtual
+    void serializeCoachStdAudio( std::ostream & strm,
+                                 const int time,
+                                 const std::string & name,
+                                 const clang::Msg & msg ) const override;
+    virtual
+    void serializeSelfAudio( std::ostream & strm,
+                             const int time,
+                             const char * msg ) const override;
+    virtual
+    void serializePlayerAudio( std::ostream & strm,
+                               const int time,
+                               const double & dir,
+                               const char * msg ) const override;
+    virtual
+    void serializeAllyAudioFull( std::ostream & strm,
+                                 const int time,
+                                 const double & dir,
+                                 const int unum,
+                                 const char * msg ) const override;
+    virtual
+    void serializeOppAudioFull( std::ostream & strm,
+                                const int time,
+                                const double & dir,
+                                const char * msg ) const override;
+    virtual
+    void serializeAllyAudioShort( std::ostream & strm,
+                                  const int time,
+                                  const int unum ) const override;
+    virtual
+    void serializeOppAudioShort( std::ostream & strm,
+                                 const int time ) const override;
+
+    //
+    // see
+    //
+
+    virtual
+    void serializeVisualBegin( std::ostream & strm,
+                               const int time ) const override;
+    virtual
+    void serializeVisualEnd( std::ostream & strm ) const override;
+
+    virtual
+    void serializeVisualObject( std::ostream & strm,
+                                const std::string & name,
+                                const int dir ) const override;
+    virtual
+    void serializeVisualObject( std::ostream & strm,
+                                const std::string & name,
+                                const double & dist,
+                                const int dir ) const override;
+    virtual
+    void serializeVisualObject( std::ostream & strm,
+                                const std::string & name,
+                                const double & dist,
+                                const int dir,
+                                const double & dist_chg,
+                                const double & dir_chg ) const override;
+    virtual
+    void serializeVisualObject( std::ostream & strm,
+                                const std::string & name,
+                                const double & dist,
+                                const int dir,
+                                const double & dist_chg,
+                                const double & dir_chg,
+                                const int body_dir ) const override;
+    virtual
+    void serializeVisualObject( std::ostream & strm,
+                                const std::string & name,
+                                const double & dist,
+                                const int dir,
+                                const double & dist_chg,
+                                const double & dir_chg,
+                                const int body_dir,
+                                const int head_dir ) const override;
+
+    virtual
+    void serializeVisualPlayer( std::ostream & strm,
+                                const Player & player,
+                                const std::string & name,
+                                const double & dist,
+                                const int dir ) const override;
+    virtual
+    void serializeVisualPlayer( std::ostream & strm,
+                                const Player & player,
+                                const std::string & name,
+                                const double & dist,
+                                const int dir,
+                                const int point_dir ) const override;
+    virtual
+    void serializeVisualPlayer( std::ostream & strm,
+                                const Player & player,
+                                const std::string & name,
+                                const double & dist,
+                                const int dir,
+                                const double & dist_chg,
+                                const double & dir_chg,
+                                const int body_dir,
+                                const int head_dir ) const override;
+    virtual
+    void serializeVisualPlayer( std::ostream & strm,
+                                const Player & player,
+                                const std::string & name,
+                                const double & dist,
+                                const int dir,
+                                const double & dist_chg,
+                                const double & dir_chg,
+                                const int body_dir,
+                                const int head_dir,
+                                const int point_dir ) const override;
+
+    //
+    // sense_body
+    //
+
+    virtual
+    void serializeBodyBegin( std::ostream & strm,
+                             const int time ) const override;
+    virtual
+    void serializeBodyEnd( std::ostream & strm ) const override;
+    virtual
+    void serializeBodyViewMode( std::ostream & strm,
+                                const char * qual,
+                                const char * width ) const override;
+    virtual
+    void serializeBodyStamina( std::ostream & strm,
+                               const double & stamina,
+                               const double & effort,
+                               const double & stamina_capacity ) const override;
+    virtual
+    void serializeBodyVelocity( std::ostream & strm,
+                                const double & mag ) const override;
+    virtual
+    void serializeBodyVelocity( std::ostream & strm,
+                                const double & mag,
+                                const int head ) const override;
+    virtual
+    void serializeBodyCounts( std::ostream & strm,
+                              const Player & self ) const override;
+    virtual
+    void serializeNeckAngle( std::ostream & strm,
+                             const int ang ) const override;
+    virtual
+    void serializeArm( std::ostream & strm,
+                       const int movable_cycles,
+                       const int expires_cycles,
+                       const double & dist,
+                       const int head,
+                       const int count ) const override;
+    virtual
+    void serializeFocus( std::ostream & strm,
+                         const char * name,
+                         const int count ) const override;
+    virtual
+    void serializeFocus( std::ostream & strm,
+                         const char * team,
+                         const int unum,
+                         const int count ) const override;
+    virtual
+    void serializeTackle( std::ostream & strm,
+                          const int cycles,
+                          const int count ) const override;
+    virtual
+    void serializeCollision( std::ostream & strm,
+                             const bool ball_collide,
+                             const bool player_collide,
+                             const bool post_collide ) const override;
+    virtual
+    void serializeFoul( std::ostream & strm,
+                        const Player & self ) const override;
+    virtual
+    void serializeFocusPoint( std::ostream & strm,
+                              const Player & self ) const override;
+
+    //
+    // fullstate
+    //
+
+    virtual
+    void serializeFSBegin( std::ostream & strm,
+                           const int time ) const override;
+    virtual
+    void serializeFSEnd( std::ostream & strm ) const override;
+    virtual
+    void serializeFSPlayMode( std::ostream & strm,
+                              const char * mode ) const override;
+    virtual
+    void serializeFSViewMode( std::ostream & strm,
+                              const char * qual,
+                              const char * width ) const override;
+    virtual
+    void serializeFSCounts( std::ostream & strm,
+                            const Player & self ) const override;
+    virtual
+    void serializeFSScore( std::ostream & strm,
+                           const int left,
+                           const int right ) const override;
+    virtual
+    void serializeFSBall( std::ostream & strm,
+                          const double & x,
+                          const double & y,
+                          const double & vel_x,
+                          const double & vel_y ) const override;
+    virtual
+    void serializeFSPlayerBegin( std::ostream & strm,
+                                 const char side,
+                                 const int unum,
+                                 const bool goalie,
+                                 const int type,
+                                 const double & x,
+                                 const double & y,
+                                 const double & vel_x,
+                                 const double & vel_y,
+                                 const double & body_dir,
+                                 const double & neck_dir ) const override;
+    virtual
+    void serializeFSPlayerFocus( std::ostream & strm,
+                                 const Player & p ) const override;
+    virtual
+    void serializeFSPlayerArm( std::ostream & strm,
+                               const double & mag,
+                               const double & head ) const override;
+    virtual
+    void serializeFSPlayerStamina( std::ostream & strm,
+                                   const double & stamina,
+                                   const double & effort,
+                                   const double & recovery,
+                                   const double & stamina_capacity ) const override;
+    virtual
+    void serializeFSPlayerState( std::ostream & strm,
+                                 const Player & player ) const override;
+    virtual
+    void serializeFSPlayerEnd( std::ostream & strm ) const override;
+
+    virtual
+    void serializeHFOFeatures( std::ostream & strm,
+                               const int time,
+                               const std::vector< float > & features ) const override;
+};
+
+}
+
+#endif
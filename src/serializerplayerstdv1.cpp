@@ -71,7 +71,7 @@ SerializerPlayerStdv1::serializeCoachStdAudio( std::ostream & strm,
                                                const rcss::clang::Msg & msg ) const
 {
     strm << "(hear " << time << ' '
-         << name << ' ' << msg << ')';
+         << name << ' ' << msg.text() << ')';
 }
 
 void
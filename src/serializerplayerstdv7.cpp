@@ -59,7 +59,7 @@ SerializerPlayerStdv7::serializeCoachStdAudio( std::ostream & strm,
                                                const rcss::clang::Msg & msg ) const
 {
     strm << "(hear " << time << ' '
-         << name << ' ' << msg << ')';
+         << name << ' ' << msg.text() << ')';
 }
 
 void
@@ -393,6 +393,9 @@ namespace
     constexpr double FOCUS_DIST_NOISE_RATE = 0.0125;
     constexpr double LAND_DIST_NOISE_RATE = 0.00125;
     constexpr double LAND_FOCUS_DIST_NOISE_RATE = 0.00125;
+
+    // server options
+    constexpr int MONITOR_BROADCAST_PORT = 6100;
 }
 
 // XXX
@@ -880,6 +883,8 @@ void ServerParam::addParams()
     addParam("hfo_max_ball_pos_x", M_hfo_max_ball_pos_x, "", 9);
     addParam("hfo_min_ball_pos_y", M_hfo_min_ball_pos_y, "", 9);
     addParam("hfo_max_ball_pos_y", M_hfo_max_ball_pos_y, "", 9);
+    addParam("hfo_features", M_hfo_features,
+             "If on, binary protocol players receive a feature vector every cycle in HFO mode", 999);
 
     //// 
 
@@ -982,8 +987,42 @@ void ServerParam::addParams()
     addParam("land_dist_noise_rate", M_land_dist_noise_rate, "", 19);
     addParam("land_focus_dist_noise_rate", M_land_focus_dist_noise_rate, "", 19);
 
+    // server options
+    addParam("monitor_broadcast_host", M_monitor_broadcast_host,
+             "If not empty, every monitor frame is sent once to this multicast group (or relay host)", 999);
+    addParam("monitor_broadcast_port", M_monitor_broadcast_port, "", 999);
+    addParam("monitor_broadcast_version", M_monitor_broadcast_version,
+             "The monitor protocol version of the broadcast frames", 999);
+    addParam("monitor_broadcast_init_step", M_monitor_broadcast_init_step,
+             "The number of cycles between the init messages repeated for spectators that joined late", 999);
+    addParam("checkpoint_file", M_checkpoint_file,
+             "If not empty, the simulation state is saved to this file every checkpoint_step cycles"
+             " and by the trainer command (checkpoint file)", 999);
+    addParam("checkpoint_step", M_checkpoint_step, "", 999);
+    addParam("trace_file", M_trace_file,
+             "If not empty, a timeline of the server cycles is written to this file in the trace event format at shutdown", 999);
+    addParam("capture_file", M_capture_file,
+             "If not empty, every datagram exchanged with the clients is recorded to this file", 999);
+    addParam("command_log_file", M_command_log_file,
+             "If not empty, the callbacks and client messages are recorded to this file for an offline re-simulation", 999);
+    addParam("resimulate_file", M_resimulate_file,
+             "If not empty, the command log in this file is re-simulated without sockets and timers", 999);
+    addParam("timer_cpu", M_timer_cpu,
+             "If not negative, the standard timer is pinned to this CPU", 999);
+    addParam("timer_realtime_priority", M_timer_realtime_priority,
+             "If positive, the standard timer runs with this SCHED_FIFO priority", 999);
+    addParam("match_count", M_match_count,
+             "The number of matches played back to back in auto mode before the server exits, 0 for no limit", 999);
+    addParam("zygote_pool_size", M_zygote_pool_size,
+             "If positive, the server forks this many prepared servers and starts one for each line of match parameters read from the standard input", 999);
+    addParam("tournament_file", M_tournament_file,
+             "If not empty, the server plays a round robin of the team start commands listed in this file, one per line", 999);
+    addParam("tournament_workers", M_tournament_workers,
+             "The number of tournament matches played in parallel, 0 for one per CPU", 999);
+    addParam("random_seed", M_random_seed,
+             "The seed of the simulator, or -1 to seed it with the start time", 999);
+
     // XXX
-    // addParam( "random_seed", M_random_seed, "", 999 );
     // addParam( "long_kick_power_factor", M_long_kick_power_factor, "", 999 );
     // addParam( "long_kick_delay", M_long_kick_delay, "", 999 );
 }
@@ -1189,6 +1228,12 @@ void ServerParam::clear()
     M_builder.reset();
 }
 
+bool ServerParam::parseLine(const std::string &params)
+{
+    std::istringstream strm(params);
+    return M_conf_parser->parse(strm, "match parameters");
+}
+
 void ServerParam::setDefaults()
 {
     /* set default parameter */
@@ -1268,6 +1313,7 @@ void ServerParam::setDefaults()
     M_hfo_max_trials = -1;
     M_hfo_max_frames = -1;
     M_hfo_offense_on_ball = false;
+    M_hfo_features = false;
 
     M_corner_kick_margin = CORNER_KICK_MARGIN;
     M_offside_active_area_size = OFFSIDE_ACTIVE_AREA_SIZE;
@@ -1496,6 +1542,24 @@ void ServerParam::setDefaults()
     M_focus_dist_noise_rate = FOCUS_DIST_NOISE_RATE;
     M_land_dist_noise_rate = LAND_DIST_NOISE_RATE;
     M_land_focus_dist_noise_rate = LAND_FOCUS_DIST_NOISE_RATE;
+
+    // server options
+    M_monitor_broadcast_host = "";
+    M_monitor_broadcast_port = MONITOR_BROADCAST_PORT;
+    M_monitor_broadcast_version = 5;
+    M_monitor_broadcast_init_step = 100;
+    M_checkpoint_file = "";
+    M_checkpoint_step = 0;
+    M_trace_file = "";
+    M_capture_file = "";
+    M_command_log_file = "";
+    M_resimulate_file = "";
+    M_timer_cpu = -1;
+    M_timer_realtime_priority = 0;
+    M_match_count = 1;
+    M_zygote_pool_size = 0;
+    M_tournament_file = "";
+    M_tournament_workers = 0;
     //     std::string module_dir = S_MODULE_DIR;
     //     for ( std::string::size_type pos = module_dir.find( "//" );
     //           pos != std::string::npos;
@@ -84,6 +84,9 @@ public:
 
     void clear();
 
+    //! applies "server::name=value ..." after init, e.g. the match parameters of a zygote child
+    bool parseLine(const std::string &params);
+
 private:
     void convertOldConf(const std::string &new_conf);
 
@@ -430,6 +433,7 @@ private:
     double M_hfo_max_ball_pos_x; /* Governs the initialization x-position of ball */
     double M_hfo_min_ball_pos_y; /* Governs the initialization y-position of ball */
     double M_hfo_max_ball_pos_y; /* Governs the initialization y-position of ball */
+    bool M_hfo_features; /* Send feature vectors to binary protocol players */
 
 
     int M_port;                        /* port number */
@@ -653,6 +657,24 @@ private:
     double M_land_dist_noise_rate;
     double M_land_focus_dist_noise_rate;
 
+    // server options
+    std::string M_monitor_broadcast_host; //!< multicast group (or relay host) for spectator monitors
+    int M_monitor_broadcast_port;
+    int M_monitor_broadcast_version;
+    int M_monitor_broadcast_init_step; //!< cycle interval to repeat the init messages
+    std::string M_checkpoint_file; //!< file for the periodic checkpoints and the trainer's (checkpoint file)
+    int M_checkpoint_step; //!< cycle interval of the checkpoints, 0 disables them
+    std::string M_trace_file; //!< trace event output, empty disables the tracing
+    std::string M_capture_file; //!< capture of the client datagrams, empty disables it
+    std::string M_command_log_file; //!< command log for a re-simulation, empty disables it
+    std::string M_resimulate_file; //!< command log to re-simulate instead of running a match
+    int M_timer_cpu; //!< CPU of the standard timer, -1 leaves it unpinned
+    int M_timer_realtime_priority; //!< SCHED_FIFO priority of the standard timer, 0 disables it
+    int M_match_count; //!< matches played by one server in auto mode, 0 for no limit
+    int M_zygote_pool_size; //!< idle servers forked by the zygote, 0 disables the zygote
+    std::string M_tournament_file; //!< team start commands of a round robin, empty disables it
+    int M_tournament_workers; //!< parallel tournament matches, 0 for one per CPU
+
 private:
     // setters & getters
 
@@ -800,6 +822,7 @@ public:
     double hfoMaxBallX() const { return M_hfo_max_ball_pos_x; }
     double hfoMinBallY() const { return M_hfo_min_ball_pos_y; }
     double hfoMaxBallY() const { return M_hfo_max_ball_pos_y; }
+    bool hfoFeatures() const { return M_hfo_features; }
 
 
     double cornerKickMargin() const { return M_corner_kick_margin; }
@@ -1034,6 +1057,24 @@ public:
     double focusDistNoiseRate() const { return M_focus_dist_noise_rate; }
     double landDistNoiseRate() const { return M_land_dist_noise_rate; }
     double landFocusDistNoiseRate() const { return M_land_focus_dist_noise_rate; }
+
+    // server options
+    const std::string &monitorBroadcastHost() const { return M_monitor_broadcast_host; }
+    int monitorBroadcastPort() const { return M_monitor_broadcast_port; }
+    int monitorBroadcastVersion() const { return M_monitor_broadcast_version; }
+    int monitorBroadcastInitStep() const { return M_monitor_broadcast_init_step; }
+    const std::string &checkpointFile() const { return M_checkpoint_file; }
+    int checkpointStep() const { return M_checkpoint_step; }
+    const std::string &traceFile() const { return M_trace_file; }
+    const std::string &captureFile() const { return M_capture_file; }
+    const std::string &commandLogFile() const { return M_command_log_file; }
+    const std::string &resimulateFile() const { return M_resimulate_file; }
+    int timerCpu() const { return M_timer_cpu; }
+    int timerRealtimePriority() const { return M_timer_realtime_priority; }
+    int matchCount() const { return M_match_count; }
+    int zygotePoolSize() const { return M_zygote_pool_size; }
+    const std::string &tournamentFile() const { return M_tournament_file; }
+    int tournamentWorkers() const { return M_tournament_workers; }
 };
 
 #endif
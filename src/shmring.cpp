@@ -0,0 +1,270 @@
+// -*-c++-*-
+
+/***************************************************************************
+                                 shmring.cpp
+              Shared memory message queues for co-located clients
+                             -------------------
+    begin                : 2026-10-18
+    copyright            : (C) 2026 by The RoboCup Soccer Server
+                           Maintenance Group.
+    email                : sserver-admin@lists.sourceforge.net
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU LGPL as published by the Free Software  *
+ *   Foundation; either version 3 of the License, or (at your option) any  *
+ *   later version.                                                        *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "shmring.h"
+
+#include <iostream>
+#include <cerrno>
+#include <cstring>
+
+#if defined(HAVE_SYS_MMAN_H) && defined(__linux__)
+#define RCSS_HAVE_SHMRING 1
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace rcss {
+
+static_assert( __atomic_always_lock_free( sizeof( std::uint64_t ), 0 ),
+               "shared memory queues need lock free 64 bit atomics" );
+
+ShmRing::ShmRing()
+    : M_fd( -1 ),
+      M_segment( nullptr )
+{
+
+}
+
+ShmRing::~ShmRing()
+{
+    close();
+}
+
+bool
+ShmRing::create( const std::string & name )
+{
+#ifdef RCSS_HAVE_SHMRING
+    close();
+
+    M_name = "/" + name;
+    M_fd = shm_open( M_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600 );
+    if ( M_fd == -1 )
+    {
+        std::cerr << __FILE__ << ": " << __LINE__
+                  << ": Error creating shared memory " << M_name << ": "
+                  << std::strerror( errno ) << std::endl;
+        M_name.clear();
+        return false;
+    }
+
+    if ( ftruncate( M_fd, sizeof( rcss_shm_segment ) ) == -1 )
+    {
+        std::cerr << __FILE__ << ": " << __LINE__
+                  << ": Error sizing shared memory " << M_name << ": "
+                  << std::strerror( errno ) << std::endl;
+        close();
+        return false;
+    }
+
+    void * addr = mmap( nullptr, sizeof( rcss_shm_segment ),
+                        PROT_READ | PROT_WRITE, MAP_SHARED,
+                        M_fd, 0 );
+    if ( addr == MAP_FAILED )
+    {
+        std::cerr << __FILE__ << ": " << __LINE__
+                  << ": Error mapping shared memory " << M_name << ": "
+                  << std::strerror( errno ) << std::endl;
+        close();
+        return false;
+    }
+
+    // ftruncate has zero filled the segment, so the queues are empty.
+    // The magic number is published last.
+    M_segment = static_cast< rcss_shm_segment * >( addr );
+    M_segment->queue_size = RCSS_SHM_QUEUE_SIZE;
+    __atomic_store_n( &M_segment->magic, RCSS_SHM_MAGIC, __ATOMIC_RELEASE );
+
+    return true;
+#else
+    std::cerr << __FILE__ << ": " << __LINE__
+              << ": Shared memory transport is not supported on this platform. ["
+              << name << "]" << std::endl;
+    return false;
+#endif
+}
+
+void
+ShmRing::close()
+{
+#ifdef RCSS_HAVE_SHMRING
+    if ( M_segment )
+    {
+        munmap( M_segment, sizeof( rcss_shm_segment ) );
+        M_segment = nullptr;
+    }
+
+    if ( M_fd != -1 )
+    {
+        ::close( M_fd );
+        M_fd = -1;
+    }
+
+    if ( ! M_name.empty() )
+    {
+        shm_unlink( M_name.c_str() );
+        M_name.clear();
+    }
+#endif
+}
+
+char *
+ShmRing::reserve( const std::size_t len )
+{
+    if ( ! M_segment )
+    {
+        return nullptr;
+    }
+
+    return rcss_shm_reserve( &M_segment->to_client, len );
+}
+
+void
+ShmRing::commit( char * msg,
+                 const std::size_t len )
+{
+    rcss_shm_commit( &M_segment->to_client, msg, len );
+}
+
+bool
+ShmRing::push( const char * msg,
+               const std::size_t len )
+{
+    if ( ! M_segment )
+    {
+        return false;
+    }
+
+    return rcss_shm_send( &M_segment->to_client, msg, len ) == 0;
+}
+
+char *
+ShmRing::front( std::size_t & len )
+{
+    if ( ! M_segment )
+    {
+        return nullptr;
+    }
+
+    return rcss_shm_front( &M_segment->to_server, &len );
+}
+
+void
+ShmRing::pop()
+{
+    rcss_shm_pop( &M_segment->to_server );
+}
+
+
+ShmRingStreamBuf::ShmRingStreamBuf( ShmRing & ring )
+    : std::streambuf(),
+      M_ring( ring )
+{
+    setp( nullptr, nullptr );
+}
+
+void
+ShmRingStreamBuf::begin()
+{
+    if ( ! pbase()
+         && M_buf.empty() )
+    {
+        char * p = M_ring.reserve( RESERVE_SIZE );
+        if ( p )
+        {
+            setp( p, p + RESERVE_SIZE );
+        }
+    }
+}
+
+void
+ShmRingStreamBuf::spill()
+{
+    if ( pbase() )
+    {
+        M_buf.append( pbase(), pptr() - pbase() );
+        setp( nullptr, nullptr );
+    }
+}
+
+ShmRingStreamBuf::int_type
+ShmRingStreamBuf::overflow( int_type c )
+{
+    if ( traits_type::eq_int_type( c, traits_type::eof() ) )
+    {
+        return traits_type::not_eof( c );
+    }
+
+    begin();
+    if ( pptr() != epptr() )
+    {
+        *pptr() = traits_type::to_char_type( c );
+        pbump( 1 );
+        return c;
+    }
+
+    spill();
+    M_buf.push_back( traits_type::to_char_type( c ) );
+    return c;
+}
+
+std::streamsize
+ShmRingStreamBuf::xsputn( const char_type * s,
+                          std::streamsize n )
+{
+    begin();
+    if ( epptr() - pptr() >= n )
+    {
+        std::memcpy( pptr(), s, n );
+        pbump( static_cast< int >( n ) );
+        return n;
+    }
+
+    spill();
+    M_buf.append( s, n );
+    return n;
+}
+
+int
+ShmRingStreamBuf::sync()
+{
+    if ( pbase() )
+    {
+        if ( pptr() != pbase() )
+        {
+            M_ring.commit( pbase(), pptr() - pbase() );
+        }
+        setp( nullptr, nullptr );
+    }
+    else if ( ! M_buf.empty() )
+    {
+        M_ring.push( M_buf.data(), M_buf.size() );
+        M_buf.clear();
+    }
+    return 0;
+}
+
+}
@@ -0,0 +1,150 @@
+// -*-c++-*-
+
+/***************************************************************************
+                                  shmring.h
+              Shared memory message queues for co-located clients
+                             -------------------
+    begin                : 2026-10-18
+    copyright            : (C) 2026 by The RoboCup Soccer Server
+                           Maintenance Group.
+    email                : sserver-admin@lists.sourceforge.net
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU LGPL as published by the Free Software  *
+ *   Foundation; either version 3 of the License, or (at your option) any  *
+ *   later version.                                                        *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef RCSS_SHMRING_H
+#define RCSS_SHMRING_H
+
+#include "rcssshm.h"
+
+#include <cstddef>
+#include <streambuf>
+#include <string>
+
+namespace rcss {
+
+/*!
+  \class ShmRing
+  \brief the server side of a shared memory segment of a player, see
+  rcssshm.h for the protocol.
+
+  The server produces the client queue and consumes the server queue.
+  The messages to the client are serialized straight into the queue by
+  ShmRingStreamBuf, and the client's commands are parsed in place.
+*/
+class ShmRing {
+private:
+
+    std::string M_name;
+    int M_fd;
+    rcss_shm_segment * M_segment;
+
+    // not used
+    ShmRing( const ShmRing & ) = delete;
+    ShmRing & operator=( const ShmRing & ) = delete;
+
+public:
+
+    ShmRing();
+    ~ShmRing();
+
+    /*!
+      \brief create and map a new segment.
+      \param name segment name without the leading slash
+      \return true if the segment has been created.
+    */
+    bool create( const std::string & name );
+
+    bool isOpen() const
+      {
+          return M_segment != nullptr;
+      }
+
+    /*!
+      \brief reserve the space for a message of up to \p len bytes in
+      the client queue.
+      \return where to write the message, or nullptr if the queue does
+      not have enough space.
+    */
+    char * reserve( const std::size_t len );
+
+    //! publish a message written to the space returned by reserve()
+    void commit( char * msg,
+                 const std::size_t len );
+
+    /*!
+      \brief copy a message to the client queue.
+      \return false if the queue does not have enough space. The
+      message is dropped in that case, as a datagram would be.
+    */
+    bool push( const char * msg,
+               const std::size_t len );
+
+    /*!
+      \brief get the oldest message of the server queue in place.  The
+      byte behind it may be overwritten by a terminator.
+      \return the message, or nullptr if the queue is empty.
+    */
+    char * front( std::size_t & len );
+
+    //! release the message returned by front()
+    void pop();
+
+private:
+
+    void close();
+};
+
+
+/*!
+  \class ShmRingStreamBuf
+  \brief a stream buffer that sends one message to a ShmRing on each
+  flush, in the same way as SocketStreamBuf sends one datagram.
+
+  The message is written into space reserved in the queue.  Only a
+  message that does not fit into the reservation is collected in a
+  buffer and copied at the flush.
+*/
+class ShmRingStreamBuf
+    : public std::streambuf {
+private:
+
+    //! the space reserved for each message, the largest usual message
+    static const std::size_t RESERVE_SIZE = 8192;
+
+    ShmRing & M_ring;
+    std::string M_buf; //!< a message that did not fit into the reservation
+
+public:
+
+    explicit
+    ShmRingStreamBuf( ShmRing & ring );
+
+protected:
+
+    int_type overflow( int_type c = traits_type::eof() ) override;
+
+    std::streamsize xsputn( const char_type * s,
+                            std::streamsize n ) override;
+
+    int sync() override;
+
+private:
+
+    //! reserves the space for a new message, if none was started yet
+    void begin();
+
+    //! moves the message from the queue to the buffer
+    void spill();
+};
+
+}
+
+#endif
@@ -25,8 +25,13 @@
 
 #include "stadium.h"
 
+#include "allocstat.h"
 #include "audio.h"
+#include "capture.h"
+#include "checkpoint.h"
 #include "coach.h"
+#include "dispsender.h"
+#include "fullstatesender.h"
 #include "landmarkreader.h"
 #include "logger.h"
 #include "monitor.h"
@@ -34,19 +39,24 @@
 #include "param.h"
 #include "player.h"
 #include "heteroplayer.h"
+#include "hfofeatures.h"
+#include "initsender.h"
 #include "random.h"
 #include "referee.h"
 #include "resultsaver.hpp"
 #include "serverparam.h"
 #include "playerparam.h"
 #include "team.h"
+#include "trace.h"
 #include "types.h"
 #include "utility.h"
+#include "visualsendercoach.h"
 #include "xpmholder.h"
 
 #include <rcss/clang/clangmsg.h>
 
 #include <sstream>
+#include <fstream>
 #include <vector>
 #include <string>
 #include <iostream>
@@ -56,14 +66,26 @@
 
 #include <cmath>
 #include <cstdio>
+#include <cstring>
 #include <cstdlib>
 #include <csignal>
 #include <cctype>
 #include <cerrno>
+#include <cstdint>
+#include <sys/wait.h>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
 
 
 Stadium::Stadium()
     : M_alive( true ),
+      M_local( false ),
+      M_finalized( false ),
+      M_field_loaded( false ),
+      M_broadcast_monitor( nullptr ),
+      M_broadcast_count( 0 ),
       M_ball( nullptr ),
       M_players( MAX_PLAYER*2, static_cast< Player * >( 0 ) ),
       M_coach( nullptr ),
@@ -78,21 +100,11 @@ Stadium::Stadium()
       M_last_playon_start( 0 ),
       M_game_over_wait( 0 ),
       M_left_child( 0 ),
-      M_right_child( 0 )
+      M_right_child( 0 ),
+      M_matches_played( 0 ),
+      M_allocations( rcss::allocation_count() )
 {
-    // !!! registration order is very important !!!
-    // TODO: fix dependencies among referees.
-    M_referees.push_back( new HFORef( *this ) );
-    M_referees.push_back( new TimeRef( *this ) );
-    M_referees.push_back( new BallStuckRef( *this ) );
-    M_referees.push_back( new OffsideRef( *this ) );
-    M_referees.push_back( new FreeKickRef( *this ) );
-    M_referees.push_back( new TouchRef( *this ) );
-    M_referees.push_back( new CatchRef( *this ) );
-    M_referees.push_back( new FoulRef( *this ) );
-    M_referees.push_back( new IllegalDefenseRef( *this ) );
-    M_referees.push_back( new KeepawayRef( *this ) );
-    M_referees.push_back( new PenaltyRef( *this ) );
+    createReferees();
 
     M_movable_objects.reserve( MAX_PLAYER*2 + 1 );
 }
@@ -170,6 +182,36 @@ Stadium::~Stadium()
 
 
 
+void
+Stadium::createReferees()
+{
+    // !!! registration order is very important !!!
+    // TODO: fix dependencies among referees.
+    M_referees.push_back( new HFORef( *this ) );
+    M_referees.push_back( new TimeRef( *this ) );
+    M_referees.push_back( new BallStuckRef( *this ) );
+    M_referees.push_back( new OffsideRef( *this ) );
+    M_referees.push_back( new FreeKickRef( *this ) );
+    M_referees.push_back( new TouchRef( *this ) );
+    M_referees.push_back( new CatchRef( *this ) );
+    M_referees.push_back( new FoulRef( *this ) );
+    M_referees.push_back( new IllegalDefenseRef( *this ) );
+    M_referees.push_back( new KeepawayRef( *this ) );
+    M_referees.push_back( new PenaltyRef( *this ) );
+}
+
+namespace {
+
+void
+seed_random( const int seed )
+{
+    srand( seed );
+    srandom( seed );
+    DefaultRNG::seed( seed );
+}
+
+}
+
 /*
  *===================================================================
  *Part: Create Stadium Window
@@ -184,42 +226,43 @@ Stadium::init()
     {
         int seed = ServerParam::instance().randomSeed();
         std::cout << "Using given Simulator Random Seed: " << seed << std::endl;
-        srand( seed );
-        srandom( seed );
-        DefaultRNG::seed( seed );
+        seed_random( seed );
     }
     else
     {
         int seed = static_cast< int >( M_start_time );
         std::cout << "Simulator Random Seed: " << seed << std::endl;
         ServerParam::instance().setRandomSeed( seed );
-        srand( seed );
-        srandom( seed );
-        DefaultRNG::seed( seed );
+        seed_random( seed );
     }
 
     //std::cout << "Simulator Random Seed: " << ServerParam::instance().randomSeed() << std::endl;
 
     M_game_over_wait = ServerParam::instance().gameOverWait();
 
+    if ( ! ServerParam::instance().traceFile().empty() )
+    {
+        rcss::Trace::enable();
+    }
+
+    if ( ! ServerParam::instance().commandLogFile().empty()
+         && ! rcss::CommandLog::isReplaying()
+         && ! rcss::CommandLog::openRecord( ServerParam::instance().commandLogFile(),
+                                            ServerParam::instance().randomSeed() ) )
+    {
+        return false;
+    }
+
+    if ( ! ServerParam::instance().captureFile().empty()
+         && ! rcss::Capture::open( ServerParam::instance().captureFile() ) )
+    {
+        return false;
+    }
+
     // we create the result savers now, so that if there are any
     // errors creating them, it will be reported before
     // the game starts, not after it has finished.
-    std::list< ResultSaver::FactoryHolder::Index > savers = ResultSaver::factory().list();
-    for ( const auto & idx : savers )
-    {
-        ResultSaver::Creator creator;
-        if ( ResultSaver::factory().getCreator( creator, idx ) )
-        {
-            ResultSaver::Ptr saver = creator();
-            std::cout << saver->getName() << ": Ready\n";
-            M_savers.push_back( saver );
-        }
-        else
-        {
-            std::cerr << idx << ": error loading" << std::endl;
-        }
-    }
+    createResultSavers();
 
     if ( ServerParam::instance().coachMode()
          && ! ServerParam::instance().coachWithRefereeMode() )
@@ -233,15 +276,10 @@ Stadium::init()
         M_referees.clear();
     }
 
+    if ( ! loadField() )
     {
-        LandmarkReader * reader = new LandmarkReader( M_field, ServerParam::instance().landmarkFile() );
-        if ( ! reader )
-        {
-            perror( "Can not create landmark reader" );
-            disable();
-            return false;
-        }
-        delete reader;
+        disable();
+        return false;
     }
 
     M_player_types.push_back( new HeteroPlayer( 0 ) );
@@ -252,59 +290,158 @@ Stadium::init()
         //std::cout << *(M_player_types[i]) << std::endl;
     }
 
-    if ( ! M_player_socket.bind( rcss::net::Addr( ServerParam::instance().playerPort() )  ) )
+    // parameters and player types are fixed from here on.
+    rcss::InitSenderCommon::clearCache();
+
+    // a re-simulation reads the messages from the command log
+    if ( ! rcss::CommandLog::isReplaying() )
     {
-        std::cerr << "Error initializing sockets: port=" << ServerParam::instance().playerPort()
-                  << ". " << strerror( errno ) << std::endl;
-        disable();
-        return false;
+        if ( ! M_player_socket.open()
+             || ! M_offline_coach_socket.open()
+             || ! M_online_coach_socket.open() )
+        {
+            std::cerr << "Error opening sockets: "
+                      << strerror( errno ) << std::endl;
+            disable();
+            return false;
+        }
+
+        if ( ! M_player_socket.bind( rcss::net::Addr( ServerParam::instance().playerPort() )  ) )
+        {
+            std::cerr << "Error initializing sockets: port=" << ServerParam::instance().playerPort()
+                      << ". " << strerror( errno ) << std::endl;
+            disable();
+            return false;
+        }
+
+        if ( ! M_offline_coach_socket.bind( rcss::net::Addr( ServerParam::instance().offlineCoachPort() ) ) )
+        {
+            std::cerr << "Error initializing sockets: port=" << ServerParam::instance().offlineCoachPort()
+                      << ". " << strerror( errno ) << std::endl;
+            disable();
+            return false;
+        }
+
+        if ( ! M_online_coach_socket.bind( rcss::net::Addr( ServerParam::instance().onlineCoachPort() ) ) )
+        {
+            std::cerr << "Error initializing sockets: port=" << ServerParam::instance().onlineCoachPort()
+                      << ". " << strerror( errno ) << std::endl;
+            disable();
+            return false;
+        }
+
+        if ( M_player_socket.setNonBlocking() == -1
+             || M_offline_coach_socket.setNonBlocking() == -1
+             || M_online_coach_socket.setNonBlocking() == -1 )
+        {
+            std::cerr << "Error setting sockets non-blocking: "
+                      << strerror( errno ) << std::endl;
+            disable();
+            return false;
+        }
     }
 
-    if ( ! M_offline_coach_socket.bind( rcss::net::Addr( ServerParam::instance().offlineCoachPort() ) ) )
+    M_weather.init();
+
+    createObjects();
+    M_coach = new Coach( *this );
+
+    changePlayMode( PM_BeforeKickOff );
+
+    M_kick_off_wait = std::max( 0, ServerParam::instance().kickOffWait() );
+    M_connect_wait = std::max( 0, ServerParam::instance().connectWait() );
+
+    if ( ! ServerParam::instance().monitorBroadcastHost().empty()
+         && ! rcss::CommandLog::isReplaying()
+         && ! openBroadcastMonitor() )
     {
-        std::cerr << "Error initializing sockets: port=" << ServerParam::instance().offlineCoachPort()
-                  << ". " << strerror( errno ) << std::endl;
         disable();
         return false;
     }
 
-    if ( ! M_online_coach_socket.bind( rcss::net::Addr( ServerParam::instance().onlineCoachPort() ) ) )
+    if ( ! Logger::instance().open( *this ) )
     {
-        std::cerr << "Error initializing sockets: port=" << ServerParam::instance().onlineCoachPort()
-                  << ". " << strerror( errno ) << std::endl;
         disable();
         return false;
     }
 
-    if ( M_player_socket.setNonBlocking() == -1
-         || M_offline_coach_socket.setNonBlocking() == -1
-         || M_online_coach_socket.setNonBlocking() == -1 )
+    return true;
+}
+
+bool
+Stadium::initLocal()
+{
+    M_local = true;
+    M_start_time = std::time( 0 );
+    M_game_over_wait = ServerParam::instance().gameOverWait();
+
+    M_player_types.push_back( new HeteroPlayer( 0 ) );
+    for ( int i = 1; i < PlayerParam::instance().playerTypes(); i++ )
     {
-        std::cerr << "Error setting sockets non-blocking: "
-                  << strerror( errno ) << std::endl;
-        disable();
-        return false;
+        M_player_types.push_back( new HeteroPlayer() );
     }
 
     M_weather.init();
 
     createObjects();
+    M_coach = new Coach( *this );
 
     changePlayMode( PM_BeforeKickOff );
 
-    M_kick_off_wait = std::max( 0, ServerParam::instance().kickOffWait() );
-    M_connect_wait = std::max( 0, ServerParam::instance().connectWait() );
+    return true;
+}
 
+void
+Stadium::setRefereeSeed( const int seed )
+{
+    for ( Referee * r : M_referees )
+    {
+        r->setRandomSeed( seed );
+    }
+}
 
-    if ( ! Logger::instance().open( *this ) )
+bool
+Stadium::loadField()
+{
+    if ( M_field_loaded )
     {
-        disable();
+        return true;
+    }
+
+    LandmarkReader * reader = new LandmarkReader( M_field, ServerParam::instance().landmarkFile() );
+    if ( ! reader )
+    {
+        perror( "Can not create landmark reader" );
         return false;
     }
+    delete reader;
 
+    M_field_loaded = true;
     return true;
 }
 
+void
+Stadium::createResultSavers()
+{
+    M_savers.clear();
+
+    std::list< ResultSaver::FactoryHolder::Index > savers = ResultSaver::factory().list();
+    for ( const auto & idx : savers )
+    {
+        ResultSaver::Creator creator;
+        if ( ResultSaver::factory().getCreator( creator, idx ) )
+        {
+            ResultSaver::Ptr saver = creator();
+            std::cout << saver->getName() << ": Ready\n";
+            M_savers.push_back( saver );
+        }
+        else
+        {
+            std::cerr << idx << ": error loading" << std::endl;
+        }
+    }
+}
+
 void
 Stadium::checkAutoMode()
 {
@@ -378,7 +515,16 @@ Stadium::checkAutoMode()
 
             if ( M_game_over_wait <= 0 )
             {
-                finalize( "Game Over. Exiting..." );
+                ++M_matches_played;
+                if ( ServerParam::instance().matchCount() <= 0
+                     || M_matches_played < ServerParam::instance().matchCount() )
+                {
+                    startNextMatch();
+                }
+                else
+                {
+                    finalize( "Game Over. Exiting..." );
+                }
                 return;
             }
         }
@@ -437,6 +583,23 @@ Stadium::startTeam( const std::string & start )
 
     if ( pid == 0 )
     {
+        // the team connects to the ports of this server, e.g. in a tournament
+        setenv( "RCSS_PORT", std::to_string( ServerParam::instance().playerPort() ).c_str(), 1 );
+        setenv( "RCSS_COACH_PORT", std::to_string( ServerParam::instance().offlineCoachPort() ).c_str(), 1 );
+        setenv( "RCSS_OLCOACH_PORT", std::to_string( ServerParam::instance().onlineCoachPort() ).c_str(), 1 );
+#ifdef __linux__
+        // the team is not confined to the CPU of the timer
+        if ( ServerParam::instance().timerCpu() >= 0 )
+        {
+            cpu_set_t cpus;
+            CPU_ZERO( &cpus );
+            for ( int i = 0; i < CPU_SETSIZE; ++i )
+            {
+                CPU_SET( i, &cpus );
+            }
+            sched_setaffinity( 0, sizeof( cpus ), &cpus );
+        }
+#endif
         execlp( "/bin/sh", "sh", "-c", start.c_str(), (char *)nullptr );
         std::cerr << PACKAGE << "-" << VERSION
                   << ": Error: Could not execute \"/bin/sh -c "
@@ -474,14 +637,38 @@ Stadium::killTeams()
     {
         kill( M_left_child, SIGINT );
         std::cout << "Killing " << M_left_child << std::endl;
-        sleep( 1 );
+        M_dying_children.push_back( M_left_child );
     }
 
     if ( M_right_child > 0 )
     {
         kill( M_right_child, SIGINT );
         std::cout << "Killing " << M_right_child << std::endl;
-        sleep( 1 );
+        M_dying_children.push_back( M_right_child );
+    }
+
+    //
+    // reap the shells so that they do not stay as zombies.  A team that
+    // takes longer than a second to shut down is not waited for, it is
+    // reaped when the next match ends.
+    //
+    const std::chrono::steady_clock::time_point deadline
+        = std::chrono::steady_clock::now() + std::chrono::seconds( 1 );
+    while ( ! M_dying_children.empty() )
+    {
+        M_dying_children.erase( std::remove_if( M_dying_children.begin(),
+                                                M_dying_children.end(),
+                                                []( const int pid )
+                                                  {
+                                                      return waitpid( pid, nullptr, WNOHANG ) != 0;
+                                                  } ),
+                                M_dying_children.end() );
+        if ( M_dying_children.empty()
+             || std::chrono::steady_clock::now() >= deadline )
+        {
+            break;
+        }
+        std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
     }
 }
 
@@ -549,8 +736,6 @@ Stadium::createObjects()
 
     M_shuffle_players = M_players;
 
-    M_coach = new Coach( *this );
-
     M_olcoaches[0] = new OnlineCoach( *this, *M_team_l );
     M_team_l->assignCoach( M_olcoaches[0] );
 
@@ -563,6 +748,8 @@ Player *
 Stadium::initPlayer( const char * teamname,
                      const double & version,
                      const bool goalie,
+                     const bool binary,
+                     const std::string & shm_name,
                      const rcss::net::Addr & addr )
 {
     Team * team = static_cast< Team * >( 0 );
@@ -623,6 +810,22 @@ Stadium::initPlayer( const char * teamname,
         return static_cast< Player * >( 0 );
     }
 
+    if ( binary
+         && ! player->useBinaryProtocol() )
+    {
+        sendToPlayer( "(error binary_protocol_unsupported)", addr );
+        player->disable();
+        return static_cast< Player * >( 0 );
+    }
+
+    if ( ! shm_name.empty()
+         && ! player->openSharedMemory( shm_name ) )
+    {
+        sendToPlayer( "(error shared_memory_failed)", addr );
+        player->disable();
+        return static_cast< Player * >( 0 );
+    }
+
     addListener( player );
     M_remote_players.push_back( player );
     M_movable_objects.push_back( player );
@@ -634,10 +837,35 @@ Stadium::initPlayer( const char * teamname,
     return player;
 }
 
+Player *
+Stadium::addLocalPlayer( const char * teamname,
+                         const Side side,
+                         const double & version,
+                         const bool goalie )
+{
+    Team * team = ( side == LEFT ? M_team_l : M_team_r );
+
+    if ( team->name().empty() )
+    {
+        team->setName( teamname );
+    }
+
+    Player * player = team->newPlayer( version, goalie );
+    if ( ! player )
+    {
+        return nullptr;
+    }
+
+    M_movable_objects.push_back( player );
+
+    return player;
+}
+
 
 Player *
 Stadium::reconnectPlayer( const char * teamname,
                           const int unum,
+                          const std::string & shm_name,
                           const rcss::net::Addr & addr )
 
 {
@@ -655,6 +883,9 @@ Stadium::reconnectPlayer( const char * teamname,
                 return static_cast< Player * >( 0 );
             }
 
+            // a segment of the previous connection is not used again
+            M_players[r]->closeSharedMemory();
+
             if ( M_players[r]->open() != 0 )
             {
                 sendToPlayer( "(error socket_open_failed)", addr );
@@ -670,6 +901,12 @@ Stadium::reconnectPlayer( const char * teamname,
                 sendToPlayer( "(error illegal_client_version)", addr );
                 return static_cast< Player * >( 0 );
             }
+            if ( ! shm_name.empty()
+                 && ! M_players[r]->openSharedMemory( shm_name ) )
+            {
+                sendToPlayer( "(error shared_memory_failed)", addr );
+                return static_cast< Player * >( 0 );
+            }
 
             addListener( M_players[r] );
             M_remote_players.push_back( M_players[r] );
@@ -790,25 +1027,35 @@ Stadium::initOnlineCoach( const char * teamname,
 void
 Stadium::step()
 {
+    // nothing built in the arena survives the previous step
+    M_cycle_arena.reset();
+
+    // the global view is serialized once for all coaches in this step
+    rcss::VisualSenderCoach::newCycle();
+
     //
     // apply command effects
     // reset command flags
     //
-    for ( PlayerCont::reference p : M_players )
     {
-        p->applyLegsEffect();
-        p->resetCommandFlags();
-        p->incArmAge();
-    }
+        rcss::Trace::Span span( "applyCommands" );
 
-    for ( int i = 0; i < 2; ++i )
-    {
-        M_olcoaches[i]->resetCommandFlags();
-        M_olcoaches[i]->check_message_queue( time() );
-        M_olcoaches[i]->update_messages_left( time() );
-    }
+        for ( PlayerCont::reference p : M_players )
+        {
+            p->applyLegsEffect();
+            p->resetCommandFlags();
+            p->incArmAge();
+        }
 
-    M_coach->resetCommandFlags();
+        for ( int i = 0; i < 2; ++i )
+        {
+            M_olcoaches[i]->resetCommandFlags();
+            M_olcoaches[i]->check_message_queue( time() );
+            M_olcoaches[i]->update_messages_left( time() );
+        }
+
+        M_coach->resetCommandFlags();
+    }
 
     //
     // update objects & referees analyze state
@@ -817,8 +1064,7 @@ Stadium::step()
     {
         turnMovableObjects();
         ++M_stoppage_time;
-        //for_each( M_referees.begin(), M_referees.end(), &Referee::doAnalyse );
-        for_each( M_referees.begin(), M_referees.end(), []( Referee * ref ) { ref->analyse(); } );
+        analyseReferees();
     }
     else if ( playmode() == PM_AfterGoal_Right
               || playmode() == PM_AfterGoal_Left
@@ -841,8 +1087,7 @@ Stadium::step()
         clearBallCatcher();
         incMovableObjects();
         ++M_stoppage_time;
-        //for_each( M_referees.begin(), M_referees.end(), &Referee::doAnalyse );
-        for_each( M_referees.begin(), M_referees.end(), []( Referee * ref ) { ref->analyse(); } );
+        analyseReferees();
         if ( pm != playmode() )
         {
             ++M_time;
@@ -854,9 +1099,7 @@ Stadium::step()
         incMovableObjects();
         ++M_time;
         M_stoppage_time = 0;
-        //for_each( M_referees.begin(), M_referees.end(), &Referee::doAnalyse );
-        //for_each( M_referees.begin(), M_referees.end(), std::mem_fun( &Referee::analyse ) );
-        for_each( M_referees.begin(), M_referees.end(), []( Referee * ref ) { ref->analyse(); } );
+        analyseReferees();
     }
     else if ( playmode() == PM_TimeOver )
     {
@@ -888,7 +1131,10 @@ Stadium::step()
     //
     // send to monitors and write game log
     //
-    sendDisp();
+    if ( ! M_local )
+    {
+        sendDisp();
+    }
 
     //
     // reset player state
@@ -897,6 +1143,18 @@ Stadium::step()
     {
         p->resetState();
     }
+
+    //
+    // save the state for a restart after a crash
+    //
+    if ( ! M_local
+         && ServerParam::instance().checkpointStep() > 0
+         && ! ServerParam::instance().checkpointFile().empty()
+         && stoppageTime() == 0
+         && time() % ServerParam::instance().checkpointStep() == 0 )
+    {
+        saveCheckpointFile( ServerParam::instance().checkpointFile() );
+    }
 }
 
 void
@@ -913,6 +1171,8 @@ Stadium::turnMovableObjects()
 void
 Stadium::incMovableObjects()
 {
+    rcss::Trace::Span span( "incMovableObjects" );
+
     std::shuffle( M_movable_objects.begin(), M_movable_objects.end(),
                   DefaultRNG::instance() );
     for ( MPObjectCont::reference o : M_movable_objects )
@@ -937,11 +1197,36 @@ Stadium::incMovableObjects()
 }
 
 
+void
+Stadium::analyseReferees()
+{
+    rcss::Trace::Span span( "analyse" );
+
+    for_each( M_referees.begin(), M_referees.end(), []( Referee * ref ) { ref->analyse(); } );
+}
+
+
 void
 Stadium::sendDisp()
 {
+    rcss::Trace::Span span( "sendDisp" );
+
     const std::chrono::system_clock::time_point start_time = std::chrono::system_clock::now();
 
+    // the show data is serialized once per format in this frame
+    rcss::DispSender::newFrame();
+
+    // repeat the init messages for spectators that joined the group late
+    if ( M_broadcast_monitor
+         && ServerParam::instance().monitorBroadcastInitStep() > 0 )
+    {
+        if ( ++M_broadcast_count >= ServerParam::instance().monitorBroadcastInitStep() )
+        {
+            M_broadcast_count = 0;
+            M_broadcast_monitor->sendInit();
+        }
+    }
+
     // send to displays
     for ( MonitorCont::reference m : M_monitors )
     {
@@ -960,14 +1245,412 @@ Stadium::sendDisp()
 void
 Stadium::recoveryPlayers()
 {
-    for ( PlayerCont::reference p : M_players )
+    for ( PlayerCont::reference p : M_players )
+    {
+        if ( ! p->isEnabled() ) continue;
+
+        p->recoverAll();
+    }
+}
+
+
+void
+Stadium::placeEpisodeStart( const EpisodeStart & start )
+{
+    M_ball->moveTo( start.ball_,
+                    PVector( 0.0, 0.0 ),
+                    PVector( 0.0, 0.0 ) );
+    M_kick_off_side = NEUTRAL;
+    M_ball_catcher = nullptr;
+
+    for ( const std::pair< Player *, PVector > & p : start.players_ )
+    {
+        p.first->place( p.second );
+        p.first->recoverAll();
+    }
+}
+
+void
+Stadium::resetEpisode( const EpisodeStart & start,
+                       const char * msg )
+{
+    static const char * playmode_strings[] = PLAYMODE_STRINGS;
+
+    placeEpisodeStart( start );
+
+    for ( Referee * r : M_referees )
+    {
+        r->newEpisode();
+    }
+
+    const bool playmode_changed = ( M_playmode != PM_PlayOn );
+    M_playmode = PM_PlayOn;
+    M_last_playon_start = time();
+
+    if ( playmode_changed )
+    {
+        sendRefereeAudio( playmode_strings[PM_PlayOn] );
+    }
+    sendRefereeAudio( msg );
+}
+
+bool
+Stadium::restartEpisode()
+{
+    for ( Referee * r : M_referees )
+    {
+        if ( r->restartEpisode() )
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+namespace {
+
+const char * CHECKPOINT_MAGIC = "rcssserver-checkpoint";
+const std::uint32_t CHECKPOINT_VERSION = 3;
+
+}
+
+/*!
+  \struct CheckpointState
+  \brief the values of a checkpoint that the stadium keeps itself.  They
+  are read and checked before any object is changed.
+*/
+struct CheckpointState {
+    int time_;
+    int stoppage_time_;
+    PlayMode playmode_;
+    Side kick_off_side_;
+    int last_playon_start_;
+    const Player * ball_catcher_;
+    DefaultRNG::Engine rng_;
+    int num_player_types_;
+    int num_referees_;
+    Stadium::MPObjectCont movable_objects_;
+    Stadium::PlayerCont shuffle_players_;
+};
+
+void
+Stadium::saveCheckpoint( std::string & data ) const
+{
+    rcss::CheckpointWriter writer( data );
+
+    const size_t start = data.size();
+    writer.putString( CHECKPOINT_MAGIC );
+    writer.put( CHECKPOINT_VERSION );
+
+    // the total size, filled in at the end
+    const size_t size_pos = data.size();
+    writer.put( std::uint64_t( 0 ) );
+
+    // the players and the state of the stadium come first, to be
+    // checked before anything is restored
+    writer.put( static_cast< int >( M_players.size() ) );
+    for ( const Player * p : M_players )
+    {
+        writer.putPlayer( p );
+    }
+
+    writer.put( M_time );
+    writer.put( M_stoppage_time );
+    writer.put( M_playmode );
+    writer.put( M_kick_off_side );
+    writer.put( M_last_playon_start );
+    writer.putPlayer( M_ball_catcher );
+
+    writer.put( DefaultRNG::instance() );
+
+    writer.put( static_cast< int >( M_player_types.size() ) );
+    writer.put( static_cast< int >( M_referees.size() ) );
+
+    // the orders that the shuffles of the next cycle start from
+    for ( const MPObject * o : M_movable_objects )
+    {
+        writer.putPlayer( o == M_ball ? nullptr : static_cast< const Player * >( o ) );
+    }
+    for ( const Player * p : M_shuffle_players )
+    {
+        writer.putPlayer( p );
+    }
+
+    // the states of the objects
+    M_weather.saveState( writer );
+
+    for ( const HeteroPlayer * t : M_player_types )
+    {
+        t->saveState( writer );
+    }
+
+    M_team_l->saveState( writer );
+    M_team_r->saveState( writer );
+
+    M_ball->saveState( writer );
+    for ( const Player * p : M_players )
+    {
+        p->saveState( writer );
+    }
+
+    for ( const Referee * r : M_referees )
+    {
+        r->saveState( writer );
+    }
+
+    const std::uint64_t size = data.size() - start;
+    std::memcpy( &data[size_pos], &size, sizeof( size ) );
+}
+
+bool
+Stadium::loadCheckpoint( const char * data,
+                         const size_t size )
+{
+    rcss::CheckpointReader reader( *this, data, size );
+    CheckpointState state;
+    if ( ! checkCheckpoint( reader, size, state ) )
+    {
+        return false;
+    }
+
+    // the object states are only checked while they are read, so the
+    // current state is kept to be put back
+    std::string backup;
+    saveCheckpoint( backup );
+
+    if ( ! readCheckpoint( reader, state ) )
+    {
+        std::cerr << "checkpoint: broken data" << std::endl;
+
+        rcss::CheckpointReader backup_reader( *this, backup.data(), backup.size() );
+        CheckpointState backup_state;
+        if ( checkCheckpoint( backup_reader, backup.size(), backup_state ) )
+        {
+            readCheckpoint( backup_reader, backup_state );
+        }
+        return false;
+    }
+
+    return true;
+}
+
+bool
+Stadium::restoreCheckpoint( const char * data,
+                            const size_t size )
+{
+    std::string backup;
+    saveCheckpoint( backup );
+
+    if ( ! loadCheckpoint( data, size ) )
+    {
+        return false;
+    }
+
+    // a restored state must save to the same bytes, or a part of it was lost
+    std::string restored;
+    saveCheckpoint( restored );
+    if ( restored.size() != size
+         || std::memcmp( restored.data(), data, size ) != 0 )
+    {
+        size_t pos = 0;
+        while ( pos < size && pos < restored.size() && restored[pos] == data[pos] )
+        {
+            ++pos;
+        }
+        std::cerr << "checkpoint: the restored state differs at byte " << pos << std::endl;
+
+        loadCheckpoint( backup.data(), backup.size() );
+        return false;
+    }
+
+    return true;
+}
+
+bool
+Stadium::checkCheckpoint( rcss::CheckpointReader & reader,
+                          const size_t size,
+                          CheckpointState & state ) const
+{
+    std::string magic;
+    reader.getString( magic );
+    const std::uint32_t version = reader.get< std::uint32_t >();
+    if ( ! reader.ok()
+         || magic != CHECKPOINT_MAGIC
+         || version != CHECKPOINT_VERSION )
+    {
+        std::cerr << "checkpoint: unknown format" << std::endl;
+        return false;
+    }
+
+    if ( reader.get< std::uint64_t >() != size )
+    {
+        std::cerr << "checkpoint: truncated or padded data" << std::endl;
+        return false;
+    }
+
+    // the states are restored by position, so the players must be in
+    // the same order, not only the same ones
+    const int num_players = reader.get< int >();
+    if ( num_players != static_cast< int >( M_players.size() ) )
+    {
+        reader.fail();
+    }
+    for ( int i = 0; i < num_players && reader.ok(); ++i )
+    {
+        if ( reader.getPlayer() != M_players[i] )
+        {
+            reader.fail();
+        }
+    }
+    if ( ! reader.ok() )
+    {
+        std::cerr << "checkpoint: the players in the stadium differ" << std::endl;
+        return false;
+    }
+
+    reader.get( state.time_ );
+    reader.get( state.stoppage_time_ );
+    reader.get( state.playmode_ );
+    reader.get( state.kick_off_side_ );
+    reader.get( state.last_playon_start_ );
+    state.ball_catcher_ = reader.getPlayer();
+
+    reader.get( state.rng_ );
+
+    reader.get( state.num_player_types_ );
+    reader.get( state.num_referees_ );
+
+    state.movable_objects_.clear();
+    for ( size_t i = 0; i < M_movable_objects.size(); ++i )
+    {
+        Player * p = reader.getPlayer();
+        state.movable_objects_.push_back( p ? static_cast< MPObject * >( p ) : M_ball );
+    }
+
+    state.shuffle_players_.clear();
+    for ( size_t i = 0; i < M_shuffle_players.size(); ++i )
+    {
+        state.shuffle_players_.push_back( reader.getPlayer() );
+    }
+
+    if ( ! reader.ok() )
+    {
+        std::cerr << "checkpoint: broken data" << std::endl;
+        return false;
+    }
+
+    if ( state.playmode_ <= PM_Null
+         || PM_MAX <= state.playmode_
+         || ( state.kick_off_side_ != LEFT
+              && state.kick_off_side_ != NEUTRAL
+              && state.kick_off_side_ != RIGHT ) )
+    {
+        std::cerr << "checkpoint: illegal play mode or kick off side" << std::endl;
+        return false;
+    }
+
+    if ( state.num_player_types_ != static_cast< int >( M_player_types.size() )
+         || state.num_referees_ != static_cast< int >( M_referees.size() ) )
+    {
+        std::cerr << "checkpoint: the player types or referees differ" << std::endl;
+        return false;
+    }
+
+    // each object must be in the orders once
+    if ( ! std::is_permutation( state.movable_objects_.begin(), state.movable_objects_.end(),
+                                M_movable_objects.begin() )
+         || ! std::is_permutation( state.shuffle_players_.begin(), state.shuffle_players_.end(),
+                                   M_shuffle_players.begin() ) )
+    {
+        std::cerr << "checkpoint: illegal object order" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+bool
+Stadium::readCheckpoint( rcss::CheckpointReader & reader,
+                         const CheckpointState & state )
+{
+    M_time = state.time_;
+    M_stoppage_time = state.stoppage_time_;
+    M_playmode = state.playmode_;
+    M_kick_off_side = state.kick_off_side_;
+    M_last_playon_start = state.last_playon_start_;
+    M_ball_catcher = state.ball_catcher_;
+
+    DefaultRNG::instance() = state.rng_;
+
+    M_movable_objects = state.movable_objects_;
+    M_shuffle_players = state.shuffle_players_;
+
+    M_weather.loadState( reader );
+
+    for ( HeteroPlayer * t : M_player_types )
+    {
+        t->loadState( reader );
+    }
+
+    M_team_l->loadState( reader );
+    M_team_r->loadState( reader );
+
+    M_ball->loadState( reader );
+    for ( Player * p : M_players )
+    {
+        p->loadState( reader );
+    }
+
+    for ( Referee * r : M_referees )
+    {
+        r->loadState( reader );
+    }
+
+    return reader.ok() && reader.atEnd();
+}
+
+bool
+Stadium::saveCheckpointFile( const std::string & path ) const
+{
+    std::string data;
+    saveCheckpoint( data );
+
+    // a crash while writing must not destroy the last checkpoint
+    const std::string tmp_path = path + ".tmp";
+    {
+        std::ofstream fout( tmp_path.c_str(), std::ios_base::binary );
+        if ( ! fout.write( data.data(), data.size() )
+             || ! fout.flush() )
+        {
+            std::cerr << "checkpoint: could not write " << tmp_path << std::endl;
+            return false;
+        }
+    }
+
+    if ( std::rename( tmp_path.c_str(), path.c_str() ) != 0 )
+    {
+        std::cerr << "checkpoint: could not rename " << tmp_path
+                  << " to " << path << ". " << strerror( errno ) << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+bool
+Stadium::loadCheckpointFile( const std::string & path )
+{
+    std::ifstream fin( path.c_str(), std::ios_base::binary );
+    if ( ! fin.is_open() )
     {
-        if ( ! p->isEnabled() ) continue;
-
-        p->recoverAll();
+        std::cerr << "checkpoint: could not open " << path << std::endl;
+        return false;
     }
-}
 
+    const std::string data( ( std::istreambuf_iterator< char >( fin ) ),
+                            std::istreambuf_iterator< char >() );
+    return restoreCheckpoint( data.data(), data.size() );
+}
 
 BallPosInfo
 Stadium::ballPosInfo()
@@ -1425,6 +2108,61 @@ Stadium::movePlayer( const Side side,
     return true;
 }
 
+bool
+Stadium::setScene( const Scene & scene )
+{
+    for ( const Scene::PlayerState & state : scene.players_ )
+    {
+        const Player * p = ( 1 <= state.unum_ && state.unum_ <= MAX_PLAYER
+                             ? getPlayer( state.side_, state.unum_ )
+                             : nullptr );
+        if ( ! p
+             || ! p->isEnabled() )
+        {
+            return false;
+        }
+    }
+
+    if ( scene.playmode_ != PM_Null )
+    {
+        changePlayMode( scene.playmode_ );
+    }
+
+    if ( scene.time_ >= 0 )
+    {
+        M_time = scene.time_;
+        M_stoppage_time = 0;
+    }
+
+    if ( scene.recover_ )
+    {
+        recoveryPlayers();
+    }
+
+    if ( scene.has_ball_ )
+    {
+        clearBallCatcher();
+        moveBall( scene.ball_pos_, scene.ball_vel_ );
+    }
+
+    for ( const Scene::PlayerState & state : scene.players_ )
+    {
+        Player * p = getPlayer( state.side_, state.unum_ );
+
+        p->place( state.pos_,
+                  ( state.has_angle_ ? state.angle_ : p->angleBodyCommitted() ),
+                  ( state.has_vel_ ? state.vel_ : p->vel() ),
+                  p->accel() );
+        if ( state.has_stamina_ )
+        {
+            p->setStamina( state.stamina_ );
+        }
+    }
+
+    collisions();
+    return true;
+}
+
 
 void
 Stadium::changePlayMode( const PlayMode pm )
@@ -1650,6 +2388,8 @@ Stadium::broadcastChangePlayerToGoalie( const Player * player )
 void
 Stadium::collisions()
 {
+    rcss::Trace::Span span( "collisions" );
+
     bool col = false;
     int max_loop = 10;
 
@@ -2035,9 +2775,17 @@ Stadium::removeDisconnectedClients()
     {
         if ( ! (*i)->connected() )
         {
+            if ( *i == M_broadcast_monitor )
+            {
+                M_broadcast_monitor = nullptr;
+                std::cout << "The broadcast monitor was closed\n";
+            }
+            else
+            {
+                std::cout << "A monitor disconnected\n";
+            }
             delete *i;
             i = M_monitors.erase( i );
-            std::cout << "A monitor disconnected\n";
         }
         else
         {
@@ -2088,9 +2836,13 @@ Stadium::sendPlayerAudio( const Player & player,
     std::shuffle( M_listeners.begin(), M_listeners.end(),
                   DefaultRNG::instance() );
 
+    // the listeners that cache the message until the next sense_body
+    // share this copy instead of duplicating it.
+    const rcss::AudioSender::Message message = M_say_messages.get( msg );
+
     for ( ListenerCont::reference l : M_listeners )
     {
-        l->sendPlayerAudio( player, msg );
+        l->sendPlayerAudio( player, message );
     }
 
     Logger::instance().writePlayerAudio( *this, player, msg );
@@ -2164,10 +2916,7 @@ Stadium::sendCoachStdAudio( const OnlineCoach & coach,
 
     if ( ServerParam::instance().sendComms() )
     {
-        std::ostringstream coach_mess;
-
-        coach_mess << msg.getTimeRecv() << " ";
-        msg.print( coach_mess );
+        const std::string coach_mess = std::to_string( msg.getTimeRecv() ) + ' ' + msg.text();
 
         char buf[max_message_length_for_display];
         char format[40];
@@ -2177,7 +2926,7 @@ Stadium::sendCoachStdAudio( const OnlineCoach & coach,
                   max_message_length_for_display,
                   format,
                   (coach.side() == RIGHT) ? OLCOACH_NAME_R : OLCOACH_NAME_L,
-                  coach_mess.str().c_str() );
+                  coach_mess.c_str() );
 
         for ( MonitorCont::reference m : monitors() )
         {
@@ -2191,6 +2940,9 @@ Stadium::sendCoachStdAudio( const OnlineCoach & coach,
 void
 Stadium::doRecvFromClients()
 {
+    rcss::Trace::Span span( "recvFromClients" );
+    rcss::CommandLog::recordCallback( rcss::CommandLog::RECV_FROM_CLIENTS );
+
     static int s_time = 0;
     static int s_stoppage_time = 0;
 
@@ -2205,12 +2957,7 @@ Stadium::doRecvFromClients()
         s_time = M_time;
         s_stoppage_time = M_stoppage_time;
 
-        std::shuffle( M_shuffle_players.begin(), M_shuffle_players.end(),
-                      DefaultRNG::instance() );
-        for ( PlayerCont::reference p : M_shuffle_players )
-        {
-            p->doLongKick();
-        }
+        applyDelayedEffects();
     }
 
     //
@@ -2226,9 +2973,23 @@ Stadium::doRecvFromClients()
     Logger::instance().writeProfile( *this, start_time, end_time, "RECV" );
 }
 
+void
+Stadium::applyDelayedEffects()
+{
+    std::shuffle( M_shuffle_players.begin(), M_shuffle_players.end(),
+                  DefaultRNG::instance() );
+    for ( PlayerCont::reference p : M_shuffle_players )
+    {
+        p->doLongKick();
+    }
+}
+
 void
 Stadium::doNewSimulatorStep()
 {
+    rcss::Trace::Span span( "newSimulatorStep" );
+    rcss::CommandLog::recordCallback( rcss::CommandLog::NEW_SIMULATOR_STEP );
+
     static std::chrono::system_clock::time_point prev_time = std::chrono::system_clock::now();
     const std::chrono::system_clock::time_point start_time = std::chrono::system_clock::now();
 
@@ -2239,6 +3000,11 @@ Stadium::doNewSimulatorStep()
     Logger::instance().writeTimes( *this, prev_time, start_time );
     prev_time = start_time;
 
+    // heap allocations done since the previous step
+    const unsigned long allocations = rcss::allocation_count();
+    Logger::instance().writeAllocations( *this, allocations - M_allocations );
+    M_allocations = allocations;
+
     //
     // step
     //
@@ -2250,14 +3016,38 @@ Stadium::doNewSimulatorStep()
     Logger::instance().writeProfile( *this, start_time, end_time, "SIM" );
 }
 
+void
+Stadium::sendHFOFeatures()
+{
+    const rcss::HFOFeatures features( *this );
+    std::vector< float > vec;
+
+    for ( Player * p : M_remote_players )
+    {
+        if ( p->isEnabled()
+             && p->connected()
+             && p->isBinaryProtocol() )
+        {
+            features.compute( *p, vec );
+            p->sendHFOFeatures( vec );
+        }
+    }
+}
+
 void
 Stadium::doSendSenseBody()
 {
+    rcss::Trace::Span span( "sendSenseBody" );
+    rcss::CommandLog::recordCallback( rcss::CommandLog::SEND_SENSE_BODY );
+
     const std::chrono::system_clock::time_point start_time = std::chrono::system_clock::now();
 
     std::shuffle( M_remote_players.begin(), M_remote_players.end(),
                   DefaultRNG::instance() );
 
+    // the shared part of the fullstate is serialized once in this cycle
+    rcss::FullStateSenderPlayer::newCycle();
+
     //
     // send sense_body & fullstate
     //
@@ -2281,6 +3071,12 @@ Stadium::doSendSenseBody()
         p->resetCollisionFlags();
     }
 
+    if ( ServerParam::instance().hfoMode()
+         && ServerParam::instance().hfoFeatures() )
+    {
+        sendHFOFeatures();
+    }
+
     //
     // send audio message
     //
@@ -2301,6 +3097,9 @@ Stadium::doSendSenseBody()
 void
 Stadium::doSendVisuals()
 {
+    rcss::Trace::Span span( "sendVisuals" );
+    rcss::CommandLog::recordCallback( rcss::CommandLog::SEND_VISUALS );
+
     const std::chrono::system_clock::time_point start_time = std::chrono::system_clock::now();
 
     std::shuffle( M_remote_players.begin(), M_remote_players.end(),
@@ -2322,6 +3121,9 @@ Stadium::doSendVisuals()
 void
 Stadium::doSendSynchVisuals()
 {
+    rcss::Trace::Span span( "sendSynchVisuals" );
+    rcss::CommandLog::recordCallback( rcss::CommandLog::SEND_SYNCH_VISUALS );
+
     const std::chrono::system_clock::time_point start_time = std::chrono::system_clock::now();
 
     std::shuffle( M_remote_players.begin(), M_remote_players.end(),
@@ -2343,6 +3145,9 @@ Stadium::doSendSynchVisuals()
 void
 Stadium::doSendCoachMessages()
 {
+    rcss::Trace::Span span( "sendCoachMessages" );
+    rcss::CommandLog::recordCallback( rcss::CommandLog::SEND_COACH_MESSAGES );
+
     const std::chrono::system_clock::time_point start_time = std::chrono::system_clock::now();
 
     if ( M_coach->assigned()
@@ -2393,6 +3198,9 @@ Stadium::doSendCoachMessages()
 bool
 Stadium::doSendThink()
 {
+    rcss::Trace::Span span( "sendThink" );
+    rcss::CommandLog::recordCallback( rcss::CommandLog::SEND_THINK );
+
     const char * think_command = "(think)";
     const double max_msec_waited = 25 * 50;
     const int max_cycles_missed = 20;
@@ -2401,7 +3209,13 @@ Stadium::doSendThink()
 
     bool shutdown = false;
 
-    if ( time() <= 0 )
+    const bool replaying = rcss::CommandLog::isReplaying();
+
+    if ( replaying )
+    {
+        // no need to slow down a re-simulation
+    }
+    else if ( time() <= 0 )
     {
         //still waiting for players to connect, so let's run a little more slowly
         std::chrono::microseconds sleep_count( 50 * 1000 );
@@ -2441,6 +3255,7 @@ Stadium::doSendThink()
         if ( wait_players[i] && M_players[i]->connected() )
         {
             M_players[i]->send( think_command );
+            M_players[i]->latency().thinkSent();
         }
     }
 
@@ -2449,6 +3264,7 @@ Stadium::doSendThink()
         if ( wait_coach[i] && M_olcoaches[i]->connected() )
         {
             M_olcoaches[i]->send( think_command );
+            M_olcoaches[i]->latency().thinkSent();
         }
     }
 
@@ -2456,6 +3272,7 @@ Stadium::doSendThink()
          && M_coach->connected() )
     {
         M_coach->send( think_command );
+        M_coach->latency().thinkSent();
     }
 
     //wait for confirmations from the clients
@@ -2470,6 +3287,13 @@ Stadium::doSendThink()
 
     const std::chrono::system_clock::time_point start_time = std::chrono::system_clock::now();
 
+    if ( replaying )
+    {
+        // the answers to the think are in the recvFromClients records
+        // that follow in the command log
+        return false;
+    }
+
     do
     {
         done = DS_TRUE;
@@ -2523,7 +3347,37 @@ Stadium::doSendThink()
             if ( time() > 0 )
             {
                 ++cycles_missed;
-                std::cerr << "Someone missed a cycle at " << time() << std::endl;
+                std::cerr << "Someone missed a cycle at " << time() << ":";
+                for ( int i = 0; i < MAX_PLAYER*2; ++i )
+                {
+                    if ( wait_players[i]
+                         && M_players[i]->connected()
+                         && ! M_players[i]->doneReceived()
+                         && M_players[i]->isEnabled() )
+                    {
+                        M_players[i]->latency().cycleMissed();
+                        std::cerr << ' ' << M_players[i]->name();
+                    }
+                }
+                for ( int i = 0; i < 2; ++i )
+                {
+                    if ( wait_coach[i]
+                         && M_olcoaches[i]->connected()
+                         && ! M_olcoaches[i]->doneReceived()
+                         && M_olcoaches[i]->assigned() )
+                    {
+                        M_olcoaches[i]->latency().cycleMissed();
+                        std::cerr << " (coach " << SideStr( M_olcoaches[i]->side() ) << ')';
+                    }
+                }
+                if ( wait_trainer
+                     && M_coach->connected()
+                     && ! M_coach->doneReceived() )
+                {
+                    M_coach->latency().cycleMissed();
+                    std::cerr << " (trainer)";
+                }
+                std::cerr << std::endl;
             }
             if ( cycles_missed > max_cycles_missed )
             {
@@ -2576,6 +3430,26 @@ recv_from_clients( std::vector< T > & clients )
 }
 
 
+int
+Stadium::recvFromPort( rcss::net::UDPSocket & socket,
+                       const rcss::CommandLog::Channel channel,
+                       char * message,
+                       rcss::net::Addr & cli_addr )
+{
+    if ( rcss::CommandLog::isReplaying() )
+    {
+        return rcss::CommandLog::nextMessage( channel, nullptr, cli_addr, message, MaxMesg );
+    }
+
+    const int len = socket.recv( message, MaxMesg, cli_addr );
+    if ( len > 0
+         && rcss::CommandLog::isRecording() )
+    {
+        rcss::CommandLog::recordMessage( channel, cli_addr, message, len );
+    }
+    return len;
+}
+
 void
 Stadium::udp_recv_message()
 {
@@ -2584,15 +3458,23 @@ Stadium::udp_recv_message()
 
     while ( 1 )
     {
-        char message[MaxMesg];
-        std::memset( &message, 0, sizeof( char ) * MaxMesg );
+        // one extra byte for the terminator added by the parsers
+        char message[MaxMesg + 1];
 
-        rcss::net::Addr cli_addr;
+        // overwritten in place by the receive, see rcss::net::Addr::setAddr()
+        rcss::net::Addr & cli_addr = M_recv_addr;
 
-        int len = M_player_socket.recv( message, MaxMesg, cli_addr );
+        int len = recvFromPort( M_player_socket, rcss::CommandLog::PLAYER_PORT, message, cli_addr );
 
         if ( len > 0 )
         {
+            if ( rcss::Capture::isOpen() )
+            {
+                rcss::Capture::record( rcss::Capture::INBOUND, cli_addr,
+                                       ServerParam::instance().playerPort(),
+                                       message, len );
+            }
+
             //              std::cerr << "Got: ";
             //              std::cerr.write( message, iMsgLength );
             //              std::cerr << std::endl;
@@ -2663,13 +3545,15 @@ Stadium::parsePlayerInit( const char * message,
     //
     if ( ! std::strncmp( message, "(init ", std::strlen( "(init " ) ) )
     {
-        // (init <TeamName> [(version <Ver>)][ (goalie)])
+        // (init <TeamName> [(version <Ver>)][ (goalie)][ (binary)][ (shm <Name>)])
 
         const char * msg = message;
 
         char teamname[16];
         double version = 3.0;
         bool goalie = false;
+        bool binary = false;
+        std::string shm_name;
 
         int n_read = 0;
         if ( std::sscanf( msg, " ( init %15[+-_a-zA-Z0-9] %n ",
@@ -2708,6 +3592,25 @@ Stadium::parsePlayerInit( const char * message,
                 goalie = true;
                 msg += std::strlen( "(goalie)" );
             }
+            else if ( ! std::strncmp( msg, "(binary)", std::strlen( "(binary)" ) ) )
+            {
+                binary = true;
+                msg += std::strlen( "(binary)" );
+            }
+            else if ( ! std::strncmp( msg, "(shm ", std::strlen( "(shm " ) ) )
+            {
+                char name[64];
+                n_read = 0;
+                if ( std::sscanf( msg, " ( shm %63[-_a-zA-Z0-9] ) %n ",
+                                  name, &n_read ) != 1
+                     || n_read == 0 )
+                {
+                    sendToPlayer( "(error illegal_command_form)", cli_addr );
+                    return;
+                }
+                shm_name = name;
+                msg += n_read;
+            }
             else
             {
                 sendToPlayer( "(error illegal_command_form)", cli_addr );
@@ -2723,7 +3626,7 @@ Stadium::parsePlayerInit( const char * message,
             while ( *msg != '\0' && std::isspace( *msg ) ) ++msg;
         }
 
-        Player * p = initPlayer( teamname, version, goalie, cli_addr );
+        Player * p = initPlayer( teamname, version, goalie, binary, shm_name, cli_addr );
         if ( p )
         {
             std::cout << "A new (v" << static_cast< int >( version ) << ") "
@@ -2747,17 +3650,38 @@ Stadium::parsePlayerInit( const char * message,
             return;
         }
 
+        // (reconnect <TeamName> <Unum>[ (shm <Name>)])
+
         char teamname[128];
         int unum;
+        std::string shm_name;
 
+        int n_read = 0;
         if ( std::sscanf( message,
-                          " ( reconnect %127s %d ) ",
-                          teamname, &unum ) < 2 )
+                          " ( reconnect %127s %d %n",
+                          teamname, &unum, &n_read ) < 2
+             || n_read == 0 )
         {
             sendToPlayer( "(error illegal_command_form)", cli_addr );
+            return;
+        }
+
+        const char * msg = message + n_read;
+        if ( ! std::strncmp( msg, "(shm ", std::strlen( "(shm " ) ) )
+        {
+            char name[64];
+            n_read = 0;
+            if ( std::sscanf( msg, " ( shm %63[-_a-zA-Z0-9] ) %n ",
+                              name, &n_read ) != 1
+                 || n_read == 0 )
+            {
+                sendToPlayer( "(error illegal_command_form)", cli_addr );
+                return;
+            }
+            shm_name = name;
         }
 
-        Player * p = reconnectPlayer( teamname, unum, cli_addr );
+        Player * p = reconnectPlayer( teamname, unum, shm_name, cli_addr );
         if ( p )
         {
             std::cout << "A player (" << teamname << ' ' << p->unum() << ") reconnected."
@@ -2780,8 +3704,11 @@ Stadium::parseMonitorInit( const char * message,
     if ( ! std::strncmp( message, "(dispinit)", 10 )
          || std::sscanf( message, " ( dispinit version %lf ) ", &ver ) == 1 )
     {
+        const int monitor_count = ( M_broadcast_monitor
+                                    ? M_monitors.size() - 1
+                                    : M_monitors.size() );
         if ( ServerParam::instance().maxMonitors() > 0
-             && static_cast< int >( M_monitors.size() ) >= ServerParam::instance().maxMonitors() )
+             && monitor_count >= ServerParam::instance().maxMonitors() )
         {
             sendToPlayer( "(error no_more_monitor)", addr );
             return true;
@@ -2824,6 +3751,42 @@ Stadium::parseMonitorInit( const char * message,
     return false;
 }
 
+bool
+Stadium::openBroadcastMonitor()
+{
+    rcss::net::Addr addr( ServerParam::instance().monitorBroadcastPort() );
+    if ( ! addr.setHost( ServerParam::instance().monitorBroadcastHost() ) )
+    {
+        std::cerr << "Unknown monitor broadcast host: "
+                  << ServerParam::instance().monitorBroadcastHost() << std::endl;
+        return false;
+    }
+
+    const int ver = ServerParam::instance().monitorBroadcastVersion();
+    Monitor * mon = new Monitor( *this, ver );
+
+    // the broadcast monitor is a normal monitor connected to the
+    // group address, so it receives every show frame, message board
+    // and team graphic exactly once regardless of the spectator count.
+    if ( ! mon->connect( addr )
+         || ! mon->setSenders() )
+    {
+        std::cerr << "Error opening the monitor broadcast to " << addr << std::endl;
+        delete mon;
+        return false;
+    }
+
+    mon->setEnforceDedicatedPort( true );
+    M_monitors.push_back( mon );
+    M_broadcast_monitor = mon;
+    M_broadcast_count = 0;
+
+    std::cout << "Broadcasting (v" << ver << ") monitor frames to " << addr << std::endl;
+
+    mon->sendInit();
+    return true;
+}
+
 void
 Stadium::udp_recv_from_coach()
 {
@@ -2837,15 +3800,23 @@ Stadium::udp_recv_from_coach()
 
     while ( 1 )
     {
-        char message[MaxMesg];
-        std::memset( &message, 0, sizeof( char ) * MaxMesg );
+        // one extra byte for the terminator added by the parsers
+        char message[MaxMesg + 1];
 
-        rcss::net::Addr cli_addr;
+        // overwritten in place by the receive, see rcss::net::Addr::setAddr()
+        rcss::net::Addr & cli_addr = M_recv_addr;
 
-        int len = M_offline_coach_socket.recv( message, MaxMesg,  cli_addr );
+        int len = recvFromPort( M_offline_coach_socket, rcss::CommandLog::OFFLINE_COACH_PORT, message, cli_addr );
 
         if ( len > 0 )
         {
+            if ( rcss::Capture::isOpen() )
+            {
+                rcss::Capture::record( rcss::Capture::INBOUND, cli_addr,
+                                       ServerParam::instance().offlineCoachPort(),
+                                       message, len );
+            }
+
             if ( ! allow_coach )
             {
                 sendToCoach( "(error connected_offline_coach_without_coach_mode)", cli_addr );
@@ -2948,15 +3919,23 @@ Stadium::udp_recv_from_online_coach()
 
     while ( 1 )
     {
-        char message[MaxMesg];
-        std::memset( &message, 0, sizeof ( char ) * MaxMesg );
+        // one extra byte for the terminator added by the parsers
+        char message[MaxMesg + 1];
 
-        rcss::net::Addr cli_addr;
+        // overwritten in place by the receive, see rcss::net::Addr::setAddr()
+        rcss::net::Addr & cli_addr = M_recv_addr;
 
-        int len = M_online_coach_socket.recv( message, MaxMesg, cli_addr );
+        int len = recvFromPort( M_online_coach_socket, rcss::CommandLog::ONLINE_COACH_PORT, message, cli_addr );
 
         if ( len > 0 )
         {
+            if ( rcss::Capture::isOpen() )
+            {
+                rcss::Capture::record( rcss::Capture::INBOUND, cli_addr,
+                                       ServerParam::instance().onlineCoachPort(),
+                                       message, len );
+            }
+
             bool found = false;
             for ( OnlineCoachCont::reference c : M_remote_online_coaches )
             {
@@ -3098,6 +4077,18 @@ void
 Stadium::sendToPlayer( const char * msg,
                        const rcss::net::Addr & cli_addr )
 {
+    if ( rcss::CommandLog::isReplaying() )
+    {
+        return;
+    }
+
+    if ( rcss::Capture::isOpen() )
+    {
+        rcss::Capture::record( rcss::Capture::OUTBOUND, cli_addr,
+                               ServerParam::instance().playerPort(),
+                               msg, std::strlen( msg ) + 1 );
+    }
+
     if ( M_player_socket.send( msg, std::strlen( msg ) + 1, cli_addr ) == -1 )
     {
         std::cerr << __FILE__ ": " << __LINE__
@@ -3110,6 +4101,18 @@ void
 Stadium::sendToCoach( const char * msg,
                       const rcss::net::Addr & cli_addr )
 {
+    if ( rcss::CommandLog::isReplaying() )
+    {
+        return;
+    }
+
+    if ( rcss::Capture::isOpen() )
+    {
+        rcss::Capture::record( rcss::Capture::OUTBOUND, cli_addr,
+                               ServerParam::instance().offlineCoachPort(),
+                               msg, std::strlen( msg ) + 1 );
+    }
+
     if ( M_offline_coach_socket.send( msg, std::strlen( msg ) + 1, cli_addr ) == -1 )
     {
         std::cerr << __FILE__ ": " << __LINE__
@@ -3122,6 +4125,18 @@ void
 Stadium::sendToOnlineCoach( const char * msg,
                             const rcss::net::Addr & cli_addr )
 {
+    if ( rcss::CommandLog::isReplaying() )
+    {
+        return;
+    }
+
+    if ( rcss::Capture::isOpen() )
+    {
+        rcss::Capture::record( rcss::Capture::OUTBOUND, cli_addr,
+                               ServerParam::instance().onlineCoachPort(),
+                               msg, std::strlen( msg ) + 1 );
+    }
+
     if ( M_online_coach_socket.send( msg, std::strlen( msg ) + 1, cli_addr ) == -1 )
     {
         std::cerr << __FILE__ ": " << __LINE__
@@ -3139,18 +4154,171 @@ Stadium::doQuit()
 void
 Stadium::finalize( const std::string & msg )
 {
-    static bool s_first = true;
-    if ( s_first )
+    if ( M_finalized )
+    {
+        return;
+    }
+    M_finalized = true;
+
+    // a local stadium has no teams, logs or result savers, and the
+    // trace, capture and command log belong to the whole process
+    if ( M_local )
+    {
+        disable();
+        return;
+    }
+
+    std::cout << '\n' << msg << '\n';
+    endMatch();
+    if ( rcss::Trace::enabled() )
+    {
+        rcss::Trace::write( ServerParam::instance().traceFile() );
+    }
+    rcss::Capture::close();
+    rcss::CommandLog::close();
+    disable();
+}
+
+void
+Stadium::endMatch()
+{
+    killTeams();
+    reportLatency();
+    Logger::instance().close( *this );
+    saveResults();
+}
+
+void
+Stadium::startNextMatch()
+{
+    std::cout << "\nMatch " << M_matches_played << " is over. Starting the next match...\n";
+    endMatch();
+
+    //
+    // drop the clients of the finished match.  Monitors and the trainer
+    // stay connected, and the sockets and player types are kept.
+    //
+    for ( Player * p : M_remote_players )
+    {
+        removeListener( p );
+    }
+    M_remote_players.clear();
+
+    for ( OnlineCoach * c : M_remote_online_coaches )
+    {
+        removeListener( c );
+    }
+    M_remote_online_coaches.clear();
+
+    M_movable_objects.clear();
+    M_ball_catcher = nullptr;
+
+    for ( Player *& p : M_players )
+    {
+        delete p;
+        p = nullptr;
+    }
+    M_shuffle_players.clear();
+
+    for ( OnlineCoach *& c : M_olcoaches )
+    {
+        delete c;
+        c = nullptr;
+    }
+
+    delete M_team_l; M_team_l = nullptr;
+    delete M_team_r; M_team_r = nullptr;
+    delete M_ball; M_ball = nullptr;
+
+    // the referees remember the players of the finished match
+    for ( Referee * r : M_referees )
+    {
+        delete r;
+    }
+    M_referees.clear();
+
+    if ( ! ServerParam::instance().coachMode()
+         || ServerParam::instance().coachWithRefereeMode() )
+    {
+        createReferees();
+    }
+
+    //
+    // the next match is seeded deterministically, so that a command log
+    // covering several matches can still be re-simulated
+    //
+    M_start_time = std::time( 0 );
+    const int seed = ServerParam::instance().randomSeed() + M_matches_played;
+    std::cout << "Simulator Random Seed: " << seed << std::endl;
+    seed_random( seed );
+
+    M_playmode = PM_BeforeKickOff;
+    M_time = 0;
+    M_stoppage_time = 0;
+    M_kick_off_side = LEFT;
+    M_last_playon_start = 0;
+    M_game_over_wait = ServerParam::instance().gameOverWait();
+    M_left_child = 0;
+    M_right_child = 0;
+
+    createResultSavers();
+
+    M_weather.init();
+
+    createObjects();
+
+    changePlayMode( PM_BeforeKickOff );
+
+    M_kick_off_wait = std::max( 0, ServerParam::instance().kickOffWait() );
+    M_connect_wait = std::max( 0, ServerParam::instance().connectWait() );
+
+    if ( ! Logger::instance().open( *this ) )
     {
-        s_first = false;
-        killTeams();
-        std::cout << '\n' << msg << '\n';
-        Logger::instance().close( *this );
-        saveResults();
         disable();
     }
 }
 
+void
+Stadium::printLatency( std::ostream & os ) const
+{
+    for ( const Player * p : M_players )
+    {
+        if ( p->latency().empty() ) continue;
+
+        os << "(player " << SideStr( p->side() ) << ' ' << p->unum() << ' ';
+        p->latency().print( os ) << ')';
+    }
+
+    for ( const OnlineCoach * c : M_olcoaches )
+    {
+        if ( c->latency().empty() ) continue;
+
+        os << "(coach " << SideStr( c->side() ) << ' ';
+        c->latency().print( os ) << ')';
+    }
+
+    if ( ! M_coach->latency().empty() )
+    {
+        os << "(trainer ";
+        M_coach->latency().print( os ) << ')';
+    }
+}
+
+void
+Stadium::reportLatency()
+{
+    std::ostringstream os;
+    printLatency( os );
+    if ( os.str().empty() )
+    {
+        return;
+    }
+
+    const std::string report = "(latency " + os.str() + ')';
+    std::cout << report << std::endl;
+    Logger::instance().writeTextLog( *this, report.c_str(), LOG_TEXT );
+}
+
 void
 Stadium::disable()
 {
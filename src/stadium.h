@@ -22,7 +22,11 @@
 #ifndef RCSSSERVER_STADIUM_H
 #define RCSSSERVER_STADIUM_H
 
+#include "audio.h"
 #include "timeable.h"
+#include "commandlog.h"
+#include "cyclearena.h"
+#include "poolallocator.h"
 
 
 #include "object.h"
@@ -49,6 +53,8 @@ class OnlineCoach;
 class Team;
 
 class Referee;
+struct EpisodeStart;
+struct CheckpointState;
 
 namespace rcss {
 class Listener;
@@ -57,6 +63,39 @@ class Msg;
 }
 }
 
+/*!
+  \struct Scene
+  \brief the state set at once by the trainer command (scene ...).
+  The optional values that are not given keep the current state.
+*/
+struct Scene {
+    struct PlayerState {
+        Side side_;
+        int unum_;
+        PVector pos_;
+        bool has_angle_;
+        double angle_; //!< body angle [rad]
+        bool has_vel_;
+        PVector vel_;
+        bool has_stamina_;
+        double stamina_;
+    };
+
+    PlayMode playmode_; //!< PM_Null keeps the play mode
+    int time_; //!< a negative value keeps the time
+    bool recover_;
+    bool has_ball_;
+    PVector ball_pos_;
+    PVector ball_vel_;
+    std::vector< PlayerState > players_;
+
+    Scene()
+        : playmode_( PM_Null ),
+          time_( -1 ),
+          recover_( false ),
+          has_ball_( false )
+      { }
+};
 
 /*
  *===================================================================
@@ -85,21 +124,32 @@ protected:
     void doQuit() override;
 
 protected:
+    // declared first, so that they outlive the clients that use them
+    mutable rcss::CycleArena M_cycle_arena; //!< the temporaries of the current step
+    mutable rcss::NodePool M_node_pool; //!< the nodes of the per cycle containers
+
     bool M_alive;
+    bool M_local; //!< simulated in-process without clients, see initLocal()
+    bool M_finalized; //!< finalize() was called
 
     rcss::net::UDPSocket M_player_socket;
     rcss::net::UDPSocket M_offline_coach_socket;
     rcss::net::UDPSocket M_online_coach_socket;
+    rcss::net::Addr M_recv_addr; //!< the source of the last datagram received
 
     Field M_field;
+    bool M_field_loaded; //!< the landmarks may be loaded before init, see loadField()
     Weather M_weather;
 
     PlayerCont  M_remote_players; //!< connected players
     OfflineCoachCont M_remote_offline_coaches; //!< connected trainers
     OnlineCoachCont M_remote_online_coaches; //!< connected coaches
     MonitorCont M_monitors; //!< connected monitors
+    Monitor * M_broadcast_monitor; //!< sends each frame once to the spectator group
+    int M_broadcast_count; //!< frames since the init messages were last broadcast
 
     ListenerCont M_listeners;
+    rcss::MessagePool M_say_messages; //!< the buffers of the players' say messages
 
     MPObjectCont M_movable_objects;
 
@@ -133,9 +183,13 @@ protected:
 
     int M_left_child;
     int M_right_child;
+    std::vector< int > M_dying_children; //!< killed shells that were not reaped yet
 
     std::time_t M_start_time;
 
+    int M_matches_played; //!< the matches finished in auto mode
+    unsigned long M_allocations; //!< the allocation count at the previous step
+
     std::list< ResultSaver::Ptr > M_savers;
 
 public:
@@ -147,8 +201,37 @@ public:
 
     bool init();
 
+    //! reads the landmarks once, before init() if the server is forked by a zygote
+    bool loadField();
+
+    /*!
+      \brief prepares an in-process stadium that has no sockets,
+      monitors, logs or result savers.  Its players are added by
+      addLocalPlayer() and it is advanced by applyDelayedEffects() and
+      stepLocal() instead of a timer.
+    */
+    bool initLocal();
+
+    //! seeds the referees that have their own engine, see Referee::setRandomSeed()
+    void setRefereeSeed( const int seed );
+
+    Player * addLocalPlayer( const char * teamname,
+                             const Side side,
+                             const double & version,
+                             const bool goalie );
+
+    void applyDelayedEffects();
+
+    void stepLocal()
+      {
+          step();
+      }
+
     void finalize( const std::string & msg );
 
+    //! prints the latencies of the clients, see rcss::ClientLatency
+    void printLatency( std::ostream & os ) const;
+
     virtual
     bool isAlive() override
       {
@@ -181,6 +264,17 @@ public:
           return M_weather;
       }
 
+    //! released at the start of every step, see rcss::CycleArena
+    rcss::CycleArena & cycleArena() const
+      {
+          return M_cycle_arena;
+      }
+
+    rcss::NodePool & nodePool() const
+      {
+          return M_node_pool;
+      }
+
     const
     Field & field() const
       {
@@ -280,12 +374,20 @@ public:
       }
 
 private:
+    void createReferees();
     void createObjects();
+    void createResultSavers();
 
     void udp_recv_message();
     void udp_recv_from_coach();
     void udp_recv_from_online_coach();
 
+    //! receives from a well known port, or from the re-simulated command log
+    int recvFromPort( rcss::net::UDPSocket & socket,
+                      const rcss::CommandLog::Channel channel,
+                      char * message,
+                      rcss::net::Addr & cli_addr );
+
     void parsePlayerInit( const char * message,
                           const rcss::net::Addr & cli_addr );
     bool parseMonitorInit( const char * message,
@@ -297,9 +399,12 @@ private:
     Player * initPlayer( const char * teamname,
                          const double & version,
                          const bool goalie,
+                         const bool binary,
+                         const std::string & shm_name,
                          const rcss::net::Addr & addr );
     Player * reconnectPlayer( const char * teamname,
                               const int unum,
+                              const std::string & shm_name,
                               const rcss::net::Addr & addr );
     Coach * initCoach( const double & version,
                        const rcss::net::Addr & );
@@ -310,10 +415,13 @@ private:
 
     void removeDisconnectedClients();
 
+    bool openBroadcastMonitor();
+
     void step();
 
     void turnMovableObjects();
     void incMovableObjects();
+    void analyseReferees();
 
     void sendDisp();
 
@@ -366,12 +474,69 @@ public:
                      const double * ang = nullptr,
                      const PVector * vel = nullptr );
 
+    /*!
+      \brief sets the play mode, the time, the stamina and the objects
+      of \p scene in this order.  Nothing is changed if one of its
+      players is not in the field.
+    */
+    bool setScene( const Scene & scene );
+
     void changePlayMode( const PlayMode pm );
 
     void placePlayersInField();
 
     void recoveryPlayers();
 
+    //! places the ball and the players of \p start, with recovered stamina
+    void placeEpisodeStart( const EpisodeStart & start );
+
+    /*!
+      \brief restarts a training episode from \p start in play_on.
+      Unlike placing the objects and calling changePlayMode() twice,
+      the referees only forget the last episode, and \p msg is the
+      only referee message sent.
+    */
+    void resetEpisode( const EpisodeStart & start,
+                       const char * msg );
+
+    /*!
+      \brief lets the HFO or keepaway referee abandon the current
+      episode and start the next one through resetEpisode().  It
+      returns false if no referee has started an episode yet.
+    */
+    bool restartEpisode();
+
+    /*!
+      \brief appends the simulation state to \p data: time, play mode,
+      scores, ball, players, player types, referees and the random
+      engine in use.  Connections, observers, online coach messages and
+      logs are not part of a checkpoint.
+    */
+    void saveCheckpoint( std::string & data ) const;
+
+    /*!
+      \brief restores a state appended by saveCheckpoint().  The format,
+      the size, the players (side and uniform number, in the same
+      order), the play mode, the counts and the object orders are read
+      and checked before anything is changed.  The object states are
+      checked while they are read, and if one is broken the previous
+      state is put back, so that a wrong blob keeps the current state.
+    */
+    bool loadCheckpoint( const char * data,
+                         const size_t size );
+
+    /*!
+      \brief restores a state like loadCheckpoint(), then saves it again
+      and compares the two blobs byte for byte.  On any difference the
+      previous state is put back.  Used by the trainer and the
+      checkpoint file.
+    */
+    bool restoreCheckpoint( const char * data,
+                            const size_t size );
+
+    bool saveCheckpointFile( const std::string & path ) const;
+    bool loadCheckpointFile( const std::string & path );
+
 private:
     //! diretcly send message to player client that has cli_addr
     void sendToPlayer( const char *msg,
@@ -382,6 +547,16 @@ private:
     //! diretcly send message to online coach client that has cli_addr
     void sendToOnlineCoach( const char *msg,
                             const rcss::net::Addr & cli_addr );
+    //! send the HFO feature vectors to the binary protocol players
+    void sendHFOFeatures();
+
+    //! reads the stadium part of a checkpoint into \p state and checks it
+    bool checkCheckpoint( rcss::CheckpointReader & reader,
+                          const size_t size,
+                          CheckpointState & state ) const;
+    //! applies \p state and reads the object states that follow it
+    bool readCheckpoint( rcss::CheckpointReader & reader,
+                         const CheckpointState & state );
 public:
     void sendRefereeAudio( const char * msg );
     void sendPlayerAudio( const Player & player,
@@ -445,6 +620,13 @@ private:
 
     void saveResults();
 
+    //! kills the started teams, reports and saves the results and closes the logs
+    void endMatch();
+    //! resets the field for the next match of a back to back run
+    void startNextMatch();
+
+    void reportLatency();
+
     void disable();
 
 };
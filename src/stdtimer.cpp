@@ -25,12 +25,50 @@
 
 #include "stdtimer.h"
 
+#include "clientlatency.h"  // needed for LatencyHistogram
 #include "timeable.h"
 #include "param.h"          // needed for TIMEDELTA
 #include "serverparam.h"    // needed for ServerParam
 
 #include <chrono>
 #include <thread>
+#include <iostream>
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#endif
+
+namespace {
+
+/*!
+  \brief sleeps until the absolute \p deadline, so that the time spent
+  in the callbacks does not shift the next tick.
+*/
+void
+sleep_until( const std::chrono::steady_clock::time_point & deadline )
+{
+#ifdef __linux__
+    // steady_clock is CLOCK_MONOTONIC in both libstdc++ and libc++
+    const std::chrono::nanoseconds since_epoch = deadline.time_since_epoch();
+    struct timespec ts;
+    ts.tv_sec = static_cast< time_t >( since_epoch.count() / 1000000000 );
+    ts.tv_nsec = static_cast< long >( since_epoch.count() % 1000000000 );
+    while ( clock_nanosleep( CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr ) == EINTR )
+    {
+        // a signal woke us up early
+    }
+#else
+    std::this_thread::sleep_until( deadline );
+#endif
+}
+
+}
 
 StandardTimer::StandardTimer( Timeable & timeable )
     : Timer( timeable )
@@ -39,9 +77,58 @@ StandardTimer::StandardTimer( Timeable & timeable )
 }
 
 
+/** Pins the timer thread to timer_cpu and raises it to the SCHED_FIFO
+    priority timer_realtime_priority.  A failure, usually a missing
+    privilege, is reported and the timer runs unpinned. */
+void
+StandardTimer::setupThread()
+{
+    const int cpu = ServerParam::instance().timerCpu();
+    const int priority = ServerParam::instance().timerRealtimePriority();
+
+#ifdef __linux__
+    if ( cpu >= 0 )
+    {
+        cpu_set_t cpus;
+        CPU_ZERO( &cpus );
+        CPU_SET( cpu, &cpus );
+        const int err = pthread_setaffinity_np( pthread_self(), sizeof( cpus ), &cpus );
+        if ( err != 0 )
+        {
+            std::cerr << "Warning: could not pin the timer to CPU " << cpu
+                      << ": " << std::strerror( err ) << std::endl;
+        }
+    }
+
+    if ( priority > 0 )
+    {
+        struct sched_param param;
+        std::memset( &param, 0, sizeof( param ) );
+        param.sched_priority = priority;
+        const int err = pthread_setschedparam( pthread_self(), SCHED_FIFO, &param );
+        if ( err != 0 )
+        {
+            std::cerr << "Warning: could not set the real-time priority " << priority
+                      << " of the timer: " << std::strerror( err ) << std::endl;
+        }
+    }
+#else
+    if ( cpu >= 0 || priority > 0 )
+    {
+        std::cerr << "Warning: timer_cpu and timer_realtime_priority"
+                  << " are not supported on this platform" << std::endl;
+    }
+#endif
+}
+
+
 /** This method controls the standard timer.
     In the mainloop, the sleep is called for each trial.
-    The sleep time is determined by subtracting the consumued time from the default delta.
+    The timer sleeps until an absolute deadline on the monotonic clock,
+    which advances by TIMEDELTA per tick, so that neither the consumed
+    time nor changes of the wall clock make it drift.  Ticks that were
+    overrun are skipped as a whole.  The lateness of the wake ups is
+    kept in a histogram that is printed when the timer stops.
     After finishing the sleep, checking which messages should be sent / received by the clients and handles them appropriately. */
 void
 StandardTimer::run()
@@ -70,20 +157,28 @@ StandardTimer::run()
     int c_synch_see = 1;
     bool sent_synch_see = false;
 
-    const std::chrono::milliseconds default_delta( TIMEDELTA );
-    std::chrono::nanoseconds elapsed( 0 );
-    std::chrono::system_clock::time_point start_time = std::chrono::system_clock::now();
+    setupThread();
+
+    const std::chrono::nanoseconds default_delta = std::chrono::milliseconds( TIMEDELTA );
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now();
+    rcss::LatencyHistogram jitter;
 
     while ( getTimeableRef().alive() )
     {
-        const std::chrono::nanoseconds elapsed = std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::system_clock::now() - start_time );
-        const std::chrono::nanoseconds sleep_count = default_delta - elapsed;
-        std::this_thread::sleep_for( sleep_count );
+        deadline += default_delta;
+        sleep_until( deadline );
 
-        start_time = std::chrono::system_clock::now();
-        lcmt += ( sleep_count.count() < 0
-                  ? elapsed.count() * 0.001 * 0.001
-                  : ( sleep_count.count() + elapsed.count() ) * 0.001 * 0.001 );
+        const std::chrono::nanoseconds late = std::chrono::steady_clock::now() - deadline;
+        jitter.add( std::max( late.count(), static_cast< std::chrono::nanoseconds::rep >( 0 ) ) * 0.001 );
+
+        int ticks = 1;
+        if ( late >= default_delta )
+        {
+            const int missed = static_cast< int >( late / default_delta );
+            deadline += missed * default_delta;
+            ticks += missed;
+        }
+        lcmt += TIMEDELTA * ticks;
 
         if ( lcmt >= ServerParam::instance().simStep() * c_simt )
         {
@@ -167,5 +262,8 @@ StandardTimer::run()
         }
     }
 
+    std::cout << "(timer_jitter ";
+    jitter.print( std::cout ) << ')' << std::endl;
+
     getTimeableRef().quit();
 }
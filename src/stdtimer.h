@@ -38,6 +38,9 @@ class StandardTimer
 private:
 
     StandardTimer( const StandardTimer& t ) = delete;
+
+    void setupThread();
+
 public:
 
     explicit
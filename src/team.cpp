@@ -25,6 +25,7 @@
 
 #include "team.h"
 
+#include "checkpoint.h"
 #include "stadium.h"
 #include "param.h"
 #include "player.h"
@@ -387,6 +388,60 @@ Team::changePlayerToGoalie( const Player * player )
     return true;
 }
 
+namespace {
+
+void
+save_count( rcss::CheckpointWriter & writer,
+            const std::map< int, int > & count )
+{
+    writer.put( static_cast< int >( count.size() ) );
+    for ( const std::map< int, int >::value_type & v : count )
+    {
+        writer.put( v.first );
+        writer.put( v.second );
+    }
+}
+
+void
+load_count( rcss::CheckpointReader & reader,
+            std::map< int, int > & count )
+{
+    count.clear();
+
+    const int size = reader.get< int >();
+    for ( int i = 0; i < size && reader.ok(); ++i )
+    {
+        const int type = reader.get< int >();
+        count[type] = reader.get< int >();
+    }
+}
+
+}
+
+void
+Team::saveState( rcss::CheckpointWriter & writer ) const
+{
+    writer.put( M_point );
+    writer.put( M_pen_taken );
+    writer.put( M_pen_point );
+    writer.put( M_pen_won );
+    writer.put( M_subs_count );
+    save_count( writer, M_ptype_count );
+    save_count( writer, M_ptype_used_count );
+}
+
+void
+Team::loadState( rcss::CheckpointReader & reader )
+{
+    reader.get( M_point );
+    reader.get( M_pen_taken );
+    reader.get( M_pen_point );
+    reader.get( M_pen_won );
+    reader.get( M_subs_count );
+    load_count( reader, M_ptype_count );
+    load_count( reader, M_ptype_used_count );
+}
+
 
 void
 Team::addTeamGraphic( const unsigned int x,
@@ -33,6 +33,11 @@ class Player;
 class OnlineCoach;
 class XPMHolder;
 
+namespace rcss {
+class CheckpointWriter;
+class CheckpointReader;
+}
+
 class Team {
 public:
     typedef std::pair< unsigned int, unsigned int > GraphKey;
@@ -214,6 +219,10 @@ public:
 
     bool changePlayerToGoalie( const Player * player );
 
+    //! writes the score and the substitutions for a checkpoint
+    void saveState( rcss::CheckpointWriter & writer ) const;
+    void loadState( rcss::CheckpointReader & reader );
+
     OnlineCoach * olcoach()
       {
           return M_olcoach;
@@ -0,0 +1,550 @@
+// -*-c++-*-
+
+/***************************************************************************
+                               tournament.cpp
+                  A round robin of parallel matches
+                             -------------------
+    begin                : 2026-10-18
+    copyright            : (C) 2026 by The RoboCup Soccer Server
+                           Maintenance Group.
+    email                : sserver-admin@lists.sourceforge.net
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU LGPL as published by the Free Software  *
+ *   Foundation; either version 3 of the License, or (at your option) any  *
+ *   later version.                                                        *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "tournament.h"
+
+#include "resultsaver.hpp"
+#include "serverparam.h"
+#include "utility.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace rcss {
+
+namespace {
+
+volatile std::sig_atomic_t g_quit = 0;
+
+void
+sig_quit_handle( int )
+{
+    g_quit = 1;
+}
+
+const int SIGNALS[] = { SIGINT, SIGTERM, SIGHUP };
+const size_t SIGNAL_COUNT = sizeof( SIGNALS ) / sizeof( SIGNALS[0] );
+
+//! the handlers of the server, restored in the matches
+struct sigaction g_server_actions[SIGNAL_COUNT];
+
+//! the result pipe of a match, -1 outside of a tournament
+int g_result_fd = -1;
+
+//! a single quoted parameter value
+std::string
+quote( const std::string & value )
+{
+    std::string str = "'";
+    for ( char c : value )
+    {
+        if ( c == '\'' )
+        {
+            str += '\\';
+        }
+        str += c;
+    }
+    str += '\'';
+    return str;
+}
+
+/*!
+  \class TournamentSaver
+  \brief passes the result of a tournament match to the runner as
+  <pre>
+  left name
+  right name
+  left_score right_score left_pen_taken right_pen_taken left_pen_scored right_pen_scored
+  </pre>
+*/
+class TournamentSaver
+    : public ResultSaver {
+public:
+    static const std::string NAME;
+
+private:
+    std::string M_team_name[ 2 ];
+    unsigned int M_score[ 2 ];
+    unsigned int M_pen_taken[ 2 ];
+    unsigned int M_pen_scored[ 2 ];
+
+    TournamentSaver()
+        : ResultSaver()
+      {
+          for ( int i = 0; i < TEAM_RIGHT + 1; ++i )
+          {
+              M_score[ i ] = 0;
+              M_pen_taken[ i ] = 0;
+              M_pen_scored[ i ] = 0;
+          }
+      }
+
+public:
+    static
+    Ptr create()
+      {
+          return Ptr( new TournamentSaver() );
+      }
+
+private:
+    bool doEnabled() const override
+      {
+          return g_result_fd >= 0;
+      }
+
+    void doSaveTeamName( team_id id,
+                         const std::string & name ) override
+      {
+          M_team_name[ id ] = name;
+      }
+
+    void doSaveScore( team_id id,
+                      unsigned int score ) override
+      {
+          M_score[ id ] = score;
+      }
+
+    void doSavePenTaken( team_id id,
+                         unsigned int taken ) override
+      {
+          M_pen_taken[ id ] = taken;
+      }
+
+    void doSavePenScored( team_id id,
+                          unsigned int scored ) override
+      {
+          M_pen_scored[ id ] = scored;
+      }
+
+    bool doSaveComplete() override
+      {
+          std::ostringstream os;
+          os << M_team_name[ TEAM_LEFT ] << '\n'
+             << M_team_name[ TEAM_RIGHT ] << '\n'
+             << M_score[ TEAM_LEFT ] << ' ' << M_score[ TEAM_RIGHT ] << ' '
+             << M_pen_taken[ TEAM_LEFT ] << ' ' << M_pen_taken[ TEAM_RIGHT ] << ' '
+             << M_pen_scored[ TEAM_LEFT ] << ' ' << M_pen_scored[ TEAM_RIGHT ] << '\n';
+          const std::string str = os.str();
+          return ::write( g_result_fd, str.data(), str.size() )
+              == static_cast< ssize_t >( str.size() );
+      }
+
+    const char * doGetName() const override
+      {
+          return NAME.c_str();
+      }
+};
+
+const std::string TournamentSaver::NAME = "TournamentSaver";
+
+}
+
+Tournament::Tournament( const size_t workers )
+    : M_workers( workers > 0
+                 ? workers
+                 : std::max( std::thread::hardware_concurrency(), 1u ) ),
+      M_failed( 0 )
+{
+
+}
+
+bool
+Tournament::open( const std::string & path )
+{
+    std::ifstream fin( tildeExpand( path ).c_str() );
+    if ( ! fin )
+    {
+        std::cerr << "Could not open the tournament file " << path << std::endl;
+        return false;
+    }
+
+    std::string line;
+    while ( std::getline( fin, line ) )
+    {
+        const std::string::size_type first = line.find_first_not_of( " \t\r" );
+        if ( first == std::string::npos
+             || line[first] == '#' )
+        {
+            continue;
+        }
+        M_teams.push_back( line.substr( first ) );
+    }
+
+    if ( M_teams.size() < 2 )
+    {
+        std::cerr << "A tournament needs two teams at least: " << path << std::endl;
+        return false;
+    }
+
+    // every pair once, the first listed team on the left
+    for ( size_t i = 0; i < M_teams.size(); ++i )
+    {
+        for ( size_t j = i + 1; j < M_teams.size(); ++j )
+        {
+            M_schedule.push_back( std::make_pair( i, j ) );
+        }
+    }
+
+    M_standings.resize( M_teams.size() );
+    return true;
+}
+
+Tournament::Result
+Tournament::run()
+{
+    // no SA_RESTART, so that a signal interrupts the wait for the matches
+    struct sigaction action;
+    std::memset( &action, 0, sizeof( action ) );
+    action.sa_handler = &sig_quit_handle;
+    for ( size_t i = 0; i < SIGNAL_COUNT; ++i )
+    {
+        if ( sigaction( SIGNALS[i], &action, &g_server_actions[i] ) != 0 )
+        {
+            std::cerr << "Tournament: could not set signal handler: "
+                      << std::strerror( errno ) << std::endl;
+            return FAILED;
+        }
+    }
+
+    std::cout << "Tournament: " << M_teams.size() << " teams, "
+              << M_schedule.size() << " matches, "
+              << M_workers << " workers" << std::endl;
+
+    const std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+    std::vector< bool > busy( M_workers, false );
+    size_t next = 0;
+
+    while ( ( next < M_schedule.size() && ! g_quit )
+            || ! M_running.empty() )
+    {
+        for ( size_t w = 0;
+              w < M_workers && next < M_schedule.size() && ! g_quit;
+              ++w )
+        {
+            if ( busy[w] ) continue;
+
+            Result result = FAILED;
+            if ( forkMatch( next, w, result ) )
+            {
+                return result;
+            }
+            busy[w] = true;
+            ++next;
+        }
+
+        int status = 0;
+        const pid_t pid = ::waitpid( -1, &status, 0 );
+        if ( pid < 0 )
+        {
+            if ( errno == EINTR )
+            {
+                // the matches were signaled as well
+                continue;
+            }
+            std::cerr << "Tournament: error waiting for the matches: "
+                      << std::strerror( errno ) << std::endl;
+            break;
+        }
+
+        for ( std::vector< Match >::iterator it = M_running.begin(); it != M_running.end(); ++it )
+        {
+            if ( it->pid_ == pid )
+            {
+                finishMatch( *it, status );
+                busy[it->worker_] = false;
+                M_running.erase( it );
+                break;
+            }
+        }
+    }
+
+    const double seconds = std::chrono::duration_cast< std::chrono::duration< double > >
+        ( std::chrono::steady_clock::now() - start_time ).count();
+    std::cout << "(tournament (matches " << next - M_failed << ") (failed " << M_failed
+              << ") (seconds " << seconds << "))" << std::endl;
+    printStandings( std::cout );
+    return FINISHED;
+}
+
+bool
+Tournament::forkMatch( const size_t index,
+                       const size_t worker,
+                       Result & result )
+{
+    Match match;
+    match.index_ = index;
+    match.left_ = M_schedule[index].first;
+    match.right_ = M_schedule[index].second;
+    match.worker_ = worker;
+
+    //
+    // the write end must not leak into the started teams, since players
+    // that outlive the match would keep the pipe open.  The read end is
+    // non-blocking, the result is read after the match has exited.
+    //
+    int fds[2];
+    if ( ::pipe( fds ) != 0 )
+    {
+        std::cerr << "Tournament: could not create a pipe: "
+                  << std::strerror( errno ) << std::endl;
+        result = FAILED;
+        return true;
+    }
+
+    if ( ::fcntl( fds[0], F_SETFD, FD_CLOEXEC ) != 0
+         || ::fcntl( fds[1], F_SETFD, FD_CLOEXEC ) != 0
+         || ::fcntl( fds[0], F_SETFL, O_NONBLOCK ) != 0 )
+    {
+        std::cerr << "Tournament: could not set up the pipe: "
+                  << std::strerror( errno ) << std::endl;
+        ::close( fds[0] );
+        ::close( fds[1] );
+        result = FAILED;
+        return true;
+    }
+
+    // the buffered output would be written by both processes otherwise
+    std::cout.flush();
+    std::cerr.flush();
+    std::fflush( nullptr );
+
+    match.pid_ = ::fork();
+    if ( match.pid_ < 0 )
+    {
+        std::cerr << "Tournament: could not fork: "
+                  << std::strerror( errno ) << std::endl;
+        ::close( fds[0] );
+        ::close( fds[1] );
+        result = FAILED;
+        return true;
+    }
+
+    if ( match.pid_ == 0 )
+    {
+        for ( const Match & m : M_running )
+        {
+            ::close( m.fd_ );
+        }
+        M_running.clear();
+        ::close( fds[0] );
+        g_result_fd = fds[1];
+
+        // only the matches report to the runner, so the saver is not
+        // listed by the other servers
+        static rcss::RegHolder s_saver
+            = ResultSaver::factory().autoReg( &TournamentSaver::create, TournamentSaver::NAME );
+
+        for ( size_t i = 0; i < SIGNAL_COUNT; ++i )
+        {
+            sigaction( SIGNALS[i], &g_server_actions[i], nullptr );
+        }
+
+        const std::string params = matchParams( match );
+        if ( ! ServerParam::instance().parseLine( params ) )
+        {
+            std::cerr << "Tournament: illegal match parameters: " << params << std::endl;
+            result = FAILED;
+            return true;
+        }
+
+        // the output of the match goes to its log directory
+        const std::string log_path = ServerParam::instance().gameLogDir() + "/server.log";
+        std::error_code err;
+        std::filesystem::create_directories( ServerParam::instance().gameLogDir(), err );
+        const int log_fd = ::open( log_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+        if ( log_fd >= 0 )
+        {
+            ::dup2( log_fd, STDOUT_FILENO );
+            ::dup2( log_fd, STDERR_FILENO );
+            ::close( log_fd );
+        }
+
+        result = START_MATCH;
+        return true;
+    }
+
+    ::close( fds[1] );
+    match.fd_ = fds[0];
+    M_running.push_back( match );
+
+    std::cout << "(tournament (start " << index + 1 << ") (worker " << worker
+              << ") (left " << match.left_ + 1 << ") (right " << match.right_ + 1 << "))"
+              << std::endl;
+    return false;
+}
+
+std::string
+Tournament::matchParams( const Match & match ) const
+{
+    const ServerParam & param = ServerParam::instance();
+    const int port_offset = static_cast< int >( match.worker_ ) * 3;
+    const std::string dir = "/match-" + std::to_string( match.index_ + 1 );
+
+    std::ostringstream os;
+    os << "server::auto_mode=true"
+       << " server::match_count=1"
+       << " server::zygote_pool_size=0"
+       << " server::tournament_file=''"
+       << " server::port=" << param.playerPort() + port_offset
+       << " server::coach_port=" << param.offlineCoachPort() + port_offset
+       << " server::olcoach_port=" << param.onlineCoachPort() + port_offset
+       << " server::timer_cpu=" << match.worker_ % std::max( std::thread::hardware_concurrency(), 1u )
+       << " server::game_log_dir=" << quote( param.gameLogDir() + dir )
+       << " server::text_log_dir=" << quote( param.textLogDir() + dir )
+       << " server::team_l_start=" << quote( M_teams[match.left_] )
+       << " server::team_r_start=" << quote( M_teams[match.right_] );
+    if ( param.randomSeed() >= 0 )
+    {
+        os << " server::random_seed=" << param.randomSeed() + static_cast< int >( match.index_ );
+    }
+    return os.str();
+}
+
+void
+Tournament::finishMatch( const Match & match,
+                         const int status )
+{
+    // the match has exited, so whatever it wrote is in the pipe already
+    std::string result;
+    char buf[1024];
+    ssize_t n = 0;
+    while ( ( n = ::read( match.fd_, buf, sizeof( buf ) ) ) > 0
+            || ( n < 0 && errno == EINTR ) )
+    {
+        if ( n > 0 )
+        {
+            result.append( buf, n );
+        }
+    }
+    ::close( match.fd_ );
+
+    std::istringstream is( result );
+    std::string name[2];
+    int score[2] = { 0, 0 };
+    int pen_taken[2] = { 0, 0 };
+    int pen_scored[2] = { 0, 0 };
+    if ( ! std::getline( is, name[0] )
+         || ! std::getline( is, name[1] )
+         || ! ( is >> score[0] >> score[1]
+                >> pen_taken[0] >> pen_taken[1]
+                >> pen_scored[0] >> pen_scored[1] ) )
+    {
+        ++M_failed;
+        std::cout << "(tournament (failed " << match.index_ + 1 << ") (status "
+                  << ( WIFEXITED( status ) ? WEXITSTATUS( status ) : -1 ) << "))"
+                  << std::endl;
+        return;
+    }
+
+    Standing & l = M_standings[match.left_];
+    Standing & r = M_standings[match.right_];
+    if ( l.name_.empty() ) l.name_ = name[0];
+    if ( r.name_.empty() ) r.name_ = name[1];
+
+    ++l.played_;
+    ++r.played_;
+    l.goals_for_ += score[0];
+    l.goals_against_ += score[1];
+    r.goals_for_ += score[1];
+    r.goals_against_ += score[0];
+    if ( score[0] > score[1] )
+    {
+        ++l.won_;
+        ++r.lost_;
+    }
+    else if ( score[0] < score[1] )
+    {
+        ++l.lost_;
+        ++r.won_;
+    }
+    else
+    {
+        ++l.drawn_;
+        ++r.drawn_;
+    }
+
+    std::cout << "(tournament (result " << match.index_ + 1 << ") "
+              << ( name[0].empty() ? "null" : name[0] ) << ' '
+              << ( name[1].empty() ? "null" : name[1] ) << ' '
+              << score[0] << ' ' << score[1];
+    if ( pen_taken[0] || pen_taken[1] )
+    {
+        std::cout << " (penalties " << pen_scored[0] << ' ' << pen_scored[1] << ')';
+    }
+    std::cout << ')' << std::endl;
+}
+
+void
+Tournament::printStandings( std::ostream & os ) const
+{
+    std::vector< size_t > order( M_standings.size() );
+    for ( size_t i = 0; i < order.size(); ++i )
+    {
+        order[i] = i;
+    }
+
+    std::stable_sort( order.begin(), order.end(),
+                      [&]( const size_t a, const size_t b )
+                      {
+                          const Standing & x = M_standings[a];
+                          const Standing & y = M_standings[b];
+                          if ( x.points() != y.points() )
+                          {
+                              return x.points() > y.points();
+                          }
+                          if ( x.goals_for_ - x.goals_against_ != y.goals_for_ - y.goals_against_ )
+                          {
+                              return x.goals_for_ - x.goals_against_ > y.goals_for_ - y.goals_against_;
+                          }
+                          return x.goals_for_ > y.goals_for_;
+                      } );
+
+    for ( size_t rank = 0; rank < order.size(); ++rank )
+    {
+        const Standing & s = M_standings[order[rank]];
+        os << "(standing " << rank + 1 << ' '
+           << ( s.name_.empty() ? "team" + std::to_string( order[rank] + 1 ) : s.name_ )
+           << " (played " << s.played_ << ") (won " << s.won_
+           << ") (drawn " << s.drawn_ << ") (lost " << s.lost_
+           << ") (goals " << s.goals_for_ << ' ' << s.goals_against_
+           << ") (points " << s.points() << "))\n";
+    }
+    os << std::flush;
+}
+
+}
@@ -0,0 +1,130 @@
+// -*-c++-*-
+
+/***************************************************************************
+                                tournament.h
+                  A round robin of parallel matches
+                             -------------------
+    begin                : 2026-10-18
+    copyright            : (C) 2026 by The RoboCup Soccer Server
+                           Maintenance Group.
+    email                : sserver-admin@lists.sourceforge.net
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU LGPL as published by the Free Software  *
+ *   Foundation; either version 3 of the License, or (at your option) any  *
+ *   later version.                                                        *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef RCSS_TOURNAMENT_H
+#define RCSS_TOURNAMENT_H
+
+#include <iosfwd>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <sys/types.h>
+
+namespace rcss {
+
+/*!
+  \class Tournament
+  \brief plays a round robin of the teams in a tournament file.
+
+  Each line of the file is a team start command, as team_l_start and
+  team_r_start.  The matches are forked as auto mode servers, at most
+  one per worker.  The worker w uses the ports port + 3w, coach_port +
+  3w and olcoach_port + 3w, pins its timer to CPU w, and writes its logs
+  to match-N subdirectories.  The started teams find their ports in the
+  RCSS_PORT, RCSS_COACH_PORT and RCSS_OLCOACH_PORT environment variables.
+
+  Each match reports its result through a TournamentSaver, which is
+  registered with the ResultSaver factory in the match children only,
+  and the standings are printed at the end.
+*/
+class Tournament {
+public:
+    enum Result {
+        FINISHED, //!< in the runner, after all matches
+        START_MATCH, //!< in a child whose match parameters have been applied
+        FAILED,
+    };
+
+private:
+    struct Match {
+        size_t index_;
+        size_t left_;
+        size_t right_;
+        size_t worker_;
+        pid_t pid_;
+        int fd_; //!< the read end of the result pipe
+    };
+
+    struct Standing {
+        std::string name_;
+        int played_;
+        int won_;
+        int drawn_;
+        int lost_;
+        int goals_for_;
+        int goals_against_;
+
+        Standing()
+            : played_( 0 ), won_( 0 ), drawn_( 0 ), lost_( 0 ),
+              goals_for_( 0 ), goals_against_( 0 )
+          { }
+
+        int points() const
+          {
+              return won_ * 3 + drawn_;
+          }
+    };
+
+    std::vector< std::string > M_teams;
+    std::vector< std::pair< size_t, size_t > > M_schedule;
+    size_t M_workers;
+
+    std::vector< Match > M_running;
+    std::vector< Standing > M_standings;
+    size_t M_failed;
+
+    // not used
+    Tournament( const Tournament & ) = delete;
+    Tournament & operator=( const Tournament & ) = delete;
+
+public:
+    //! \p workers 0 runs one match per CPU
+    explicit
+    Tournament( const size_t workers );
+
+    //! reads the team start commands
+    bool open( const std::string & path );
+
+    /*!
+      \brief plays all matches.  It returns START_MATCH in a child that
+      is to run its match, and FINISHED in the runner.
+    */
+    Result run();
+
+private:
+    //! forks the match.  It returns true in the child, with its \p result
+    bool forkMatch( const size_t index,
+                    const size_t worker,
+                    Result & result );
+
+    //! the parameters of a match, applied by the child
+    std::string matchParams( const Match & match ) const;
+
+    void finishMatch( const Match & match,
+                      const int status );
+
+    void printStandings( std::ostream & os ) const;
+};
+
+}
+
+#endif
@@ -0,0 +1,152 @@
+// -*-c++-*-
+
+/***************************************************************************
+                                 trace.cpp
+                  Timeline of the server cycles for trace viewers
+                             -------------------
+    begin                : 2026-10-18
+    copyright            : (C) 2026 by The RoboCup Soccer Server
+                           Maintenance Group.
+    email                : sserver-admin@lists.sourceforge.net
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU LGPL as published by the Free Software  *
+ *   Foundation; either version 3 of the License, or (at your option) any  *
+ *   later version.                                                        *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "trace.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace rcss {
+
+namespace {
+
+struct Event {
+    const char * name_;
+    std::int64_t begin_; //!< [ns] since the trace was enabled
+    std::int64_t end_; //!< [ns]
+};
+
+struct ThreadBuffer {
+    int tid_;
+    std::vector< Event > events_;
+};
+
+Trace::Clock::time_point g_origin;
+
+std::mutex g_buffers_mutex;
+std::vector< std::unique_ptr< ThreadBuffer > > g_buffers;
+
+thread_local ThreadBuffer * t_buffer = nullptr;
+
+ThreadBuffer *
+thread_buffer()
+{
+    if ( ! t_buffer )
+    {
+        // only the first span of a thread takes the lock
+        std::lock_guard< std::mutex > lock( g_buffers_mutex );
+        g_buffers.emplace_back( new ThreadBuffer );
+        t_buffer = g_buffers.back().get();
+        t_buffer->tid_ = static_cast< int >( g_buffers.size() );
+        t_buffer->events_.reserve( 1 << 16 );
+    }
+    return t_buffer;
+}
+
+std::int64_t
+since_origin( const Trace::Clock::time_point & t )
+{
+    return std::chrono::duration_cast< std::chrono::nanoseconds >( t - g_origin ).count();
+}
+
+}
+
+std::atomic< bool > Trace::S_enabled( false );
+
+void
+Trace::enable()
+{
+    g_origin = Clock::now();
+    S_enabled.store( true, std::memory_order_relaxed );
+}
+
+void
+Trace::record( const char * name,
+               const Clock::time_point & begin,
+               const Clock::time_point & end )
+{
+    thread_buffer()->events_.push_back( Event{ name,
+                                               since_origin( begin ),
+                                               since_origin( end ) } );
+}
+
+bool
+Trace::write( const std::string & path )
+{
+    std::ofstream fout( path.c_str() );
+    if ( ! fout )
+    {
+        std::cerr << "Error: could not open the trace file \""
+                  << path << "\"" << std::endl;
+        return false;
+    }
+
+    std::lock_guard< std::mutex > lock( g_buffers_mutex );
+
+    // complete ("X") events, timestamps in microseconds with nanosecond digits
+    char buf[256];
+    const char * sep = "\n";
+    fout << "{\"traceEvents\":[";
+    for ( const std::unique_ptr< ThreadBuffer > & b : g_buffers )
+    {
+        std::snprintf( buf, sizeof( buf ),
+                       "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,"
+                       "\"args\":{\"name\":\"%s\"}}",
+                       sep, b->tid_, ( b->tid_ == 1 ? "main" : "worker" ) );
+        fout << buf;
+        sep = ",\n";
+
+        for ( const Event & e : b->events_ )
+        {
+            std::snprintf( buf, sizeof( buf ),
+                           ",\n{\"name\":\"%s\",\"cat\":\"rcssserver\",\"ph\":\"X\","
+                           "\"pid\":1,\"tid\":%d,\"ts\":%lld.%03lld,\"dur\":%lld.%03lld}",
+                           e.name_, b->tid_,
+                           static_cast< long long >( e.begin_ / 1000 ),
+                           static_cast< long long >( e.begin_ % 1000 ),
+                           static_cast< long long >( ( e.end_ - e.begin_ ) / 1000 ),
+                           static_cast< long long >( ( e.end_ - e.begin_ ) % 1000 ) );
+            fout << buf;
+        }
+    }
+    fout << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    fout.flush();
+    if ( ! fout )
+    {
+        std::cerr << "Error: could not write the trace file \""
+                  << path << "\"" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+}
@@ -0,0 +1,101 @@
+// -*-c++-*-
+
+/***************************************************************************
+                                  trace.h
+                  Timeline of the server cycles for trace viewers
+                             -------------------
+    begin                : 2026-10-18
+    copyright            : (C) 2026 by The RoboCup Soccer Server
+                           Maintenance Group.
+    email                : sserver-admin@lists.sourceforge.net
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU LGPL as published by the Free Software  *
+ *   Foundation; either version 3 of the License, or (at your option) any  *
+ *   later version.                                                        *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef RCSS_TRACE_H
+#define RCSS_TRACE_H
+
+#include <atomic>
+#include <chrono>
+#include <string>
+
+namespace rcss {
+
+/*!
+  \class Trace
+  \brief records the spans of the server cycles and writes them in the
+  trace event format of chrome://tracing and Perfetto.
+
+  Each thread appends to its own buffer, so recording a span takes no
+  lock.  The buffers are only read by write(), which must be called
+  after the traced threads are done, e.g. at shutdown.
+*/
+class Trace {
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    /*!
+      \class Span
+      \brief records the time from its construction to its destruction.
+      The name must be a string literal, since only the pointer is kept.
+    */
+    class Span {
+    private:
+        const char * M_name;
+        Clock::time_point M_begin;
+
+        // not used
+        Span( const Span & ) = delete;
+        Span & operator=( const Span & ) = delete;
+
+    public:
+        explicit
+        Span( const char * name )
+            : M_name( Trace::enabled() ? name : nullptr )
+          {
+              if ( M_name )
+              {
+                  M_begin = Clock::now();
+              }
+          }
+
+        ~Span()
+          {
+              if ( M_name )
+              {
+                  Trace::record( M_name, M_begin, Clock::now() );
+              }
+          }
+    };
+
+private:
+    static std::atomic< bool > S_enabled;
+
+    Trace() = delete;
+
+public:
+    static void enable();
+
+    static bool enabled()
+      {
+          return S_enabled.load( std::memory_order_relaxed );
+      }
+
+    static void record( const char * name,
+                        const Clock::time_point & begin,
+                        const Clock::time_point & end );
+
+    //! writes the recorded spans of all threads as trace event JSON
+    static bool write( const std::string & path );
+};
+
+}
+
+#endif
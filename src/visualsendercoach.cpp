@@ -30,6 +30,11 @@
 #include "coach.h"
 #include "serializer.h"
 
+#include <map>
+#include <ostream>
+#include <tuple>
+#include <typeindex>
+
 namespace rcss {
 
 /*!
@@ -63,6 +68,66 @@ VisualSenderCoach::~VisualSenderCoach()
     //std::cerr << "delete VisualSenderCoach" << std::endl;
 }
 
+namespace {
+
+/*!
+  The cached frames depend on the sender class, the serializer class
+  and the receiver's side (opponent names are hidden from online coaches).
+*/
+struct CoachFrame {
+    unsigned long cycle_;
+    std::string data_;
+
+    CoachFrame()
+        : cycle_( 0 )
+      { }
+};
+
+typedef std::tuple< std::type_index, // sender
+                    std::type_index, // serializer
+                    int,             // side
+                    int              // frame
+                    > CoachFrameKey;
+
+typedef std::map< CoachFrameKey, CoachFrame > CoachFrameCache;
+
+unsigned long g_cycle = 1;
+
+CoachFrameCache &
+coach_frame_cache()
+{
+    static CoachFrameCache s_cache;
+    return s_cache;
+}
+
+}
+
+void
+VisualSenderCoach::newCycle()
+{
+    ++g_cycle;
+}
+
+const std::string &
+VisualSenderCoach::cachedFrame( const Frame frame,
+                                const std::function< void( std::ostream & ) > & build ) const
+{
+    CoachFrame & entry = coach_frame_cache()[ CoachFrameKey( std::type_index( typeid( *this ) ),
+                                                             std::type_index( typeid( serializer() ) ),
+                                                             self().side(),
+                                                             frame ) ];
+    if ( entry.cycle_ != g_cycle )
+    {
+        rcss::ArenaStreamBuf buf( stadium().cycleArena() );
+        std::ostream os( &buf );
+        build( os );
+        entry.data_.assign( buf.data(), buf.size() );
+        entry.cycle_ = g_cycle;
+    }
+
+    return entry.data_;
+}
+
 /*!
 //===================================================================
 //
@@ -87,38 +152,46 @@ VisualSenderCoachV1::~VisualSenderCoachV1()
 void
 VisualSenderCoachV1::sendVisual()
 {
-    serializer().serializeVisualBegin( transport(), stadium().time() );
+    transport() << cachedFrame( VISUAL,
+                                [this]( std::ostream & os )
+                                {
+                                    serializer().serializeVisualBegin( os, stadium().time() );
 
-    sendGoals();
-    sendBall();
+                                    sendGoals( os );
+                                    sendBall( os );
 
-    for ( Stadium::PlayerCont::const_reference p : stadium().players() )
-    {
-        if ( ! p->isEnabled() ) continue;
+                                    for ( Stadium::PlayerCont::const_reference p : stadium().players() )
+                                    {
+                                        if ( ! p->isEnabled() ) continue;
 
-        serializePlayer( *p );
-    }
+                                        serializePlayer( os, *p );
+                                    }
 
-    serializer().serializeVisualEnd( transport() );
+                                    serializer().serializeVisualEnd( os );
+                                } );
     transport() << std::ends << std::flush;
 }
 
 void
 VisualSenderCoachV1::sendLook()
 {
-    serializer().serializeLookBegin( transport(), stadium().time() );
+    transport() << cachedFrame( LOOK,
+                                [this]( std::ostream & os )
+                                {
+                                    serializer().serializeLookBegin( os, stadium().time() );
 
-    sendGoals();
-    sendBall();
+                                    sendGoals( os );
+                                    sendBall( os );
 
-    for ( Stadium::PlayerCont::const_reference p : stadium().players() )
-    {
-        if ( ! p->isEnabled() ) continue;
+                                    for ( Stadium::PlayerCont::const_reference p : stadium().players() )
+                                    {
+                                        if ( ! p->isEnabled() ) continue;
 
-        serializePlayerLook( *p );
-    }
+                                        serializePlayerLook( os, *p );
+                                    }
 
-    serializer().serializeLookEnd( transport() );
+                                    serializer().serializeLookEnd( os );
+                                } );
     transport() << std::ends << std::flush;
 }
 
@@ -130,36 +203,38 @@ VisualSenderCoachV1::sendOKEye()
 }
 
 void
-VisualSenderCoachV1::sendGoals()
+VisualSenderCoachV1::sendGoals( std::ostream & os )
 {
     for ( const PObject * o : stadium().field().goals() )
     {
-        sendGoal( *o );
+        sendGoal( os, *o );
     }
 }
 
 
 void
-VisualSenderCoachV1::sendGoal( const PObject & goal )
+VisualSenderCoachV1::sendGoal( std::ostream & os,
+                               const PObject & goal )
 {
-    serializer().serializeVisualObject( transport(),
+    serializer().serializeVisualObject( os,
                                         calcName( goal ),
                                         goal.pos() );
 }
 
 void
-VisualSenderCoachV1::sendBall()
+VisualSenderCoachV1::sendBall( std::ostream & os )
 {
-    serializer().serializeVisualObject( transport(),
+    serializer().serializeVisualObject( os,
                                         calcName( stadium().ball() ),
                                         stadium().ball().pos(),
                                         stadium().ball().vel() );
 }
 
 void
-VisualSenderCoachV1::serializePlayer( const Player & player )
+VisualSenderCoachV1::serializePlayer( std::ostream & os,
+                                      const Player & player )
 {
-    serializer().serializeVisualObject( transport(),
+    serializer().serializeVisualObject( os,
                                         calcPlayerName( player ),
                                         player.pos(),
                                         player.vel(),
@@ -168,9 +243,10 @@ VisualSenderCoachV1::serializePlayer( const Player & player )
 }
 
 void
-VisualSenderCoachV1::serializePlayerLook( const Player & player )
+VisualSenderCoachV1::serializePlayerLook( std::ostream & os,
+                                          const Player & player )
 {
-    serializePlayer( player );
+    serializePlayer( os, player );
 }
 
 const std::string &
@@ -252,11 +328,12 @@ VisualSenderCoachV8::calcPointDir( const Player & player )
 }
 
 void
-VisualSenderCoachV8::serializePlayer( const Player & player )
+VisualSenderCoachV8::serializePlayer( std::ostream & os,
+                                      const Player & player )
 {
     if ( player.arm().isPointing() )
     {
-        serializer().serializeVisualObject( transport(),
+        serializer().serializeVisualObject( os,
                                             calcPlayerName( player ),
                                             player.pos(),
                                             player.vel(),
@@ -267,7 +344,7 @@ VisualSenderCoachV8::serializePlayer( const Player & player )
     }
     else
     {
-        serializer().serializeVisualObject( transport(),
+        serializer().serializeVisualObject( os,
                                             calcPlayerName( player ),
                                             player.pos(),
                                             player.vel(),
@@ -278,9 +355,10 @@ VisualSenderCoachV8::serializePlayer( const Player & player )
 }
 
 void
-VisualSenderCoachV8::serializePlayerLook( const Player & player )
+VisualSenderCoachV8::serializePlayerLook( std::ostream & os,
+                                          const Player & player )
 {
-    VisualSenderCoachV7::serializePlayer( player );
+    VisualSenderCoachV7::serializePlayer( os, player );
 }
 
 
@@ -306,11 +384,12 @@ VisualSenderCoachV13::~VisualSenderCoachV13()
 }
 
 void
-VisualSenderCoachV13::serializePlayer( const Player & player )
+VisualSenderCoachV13::serializePlayer( std::ostream & os,
+                                       const Player & player )
 {
     if ( player.arm().isPointing() )
     {
-        serializer().serializeVisualPlayer( transport(),
+        serializer().serializeVisualPlayer( os,
                                             player,
                                             calcPlayerName( player ),
                                             player.pos(),
@@ -321,7 +400,7 @@ VisualSenderCoachV13::serializePlayer( const Player & player )
     }
     else
     {
-        serializer().serializeVisualPlayer( transport(),
+        serializer().serializeVisualPlayer( os,
                                             player,
                                             calcPlayerName( player ),
                                             player.pos(),
@@ -332,9 +411,10 @@ VisualSenderCoachV13::serializePlayer( const Player & player )
 }
 
 void
-VisualSenderCoachV13::serializePlayerLook( const Player & player )
+VisualSenderCoachV13::serializePlayerLook( std::ostream & os,
+                                           const Player & player )
 {
-    VisualSenderCoachV8::serializePlayer( player );
+    VisualSenderCoachV8::serializePlayer( os, player );
 }
 
 /*!
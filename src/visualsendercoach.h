@@ -30,7 +30,9 @@
 
 #include <rcss/factory.hpp>
 
+#include <functional>
 #include <memory>
+#include <string>
 
 class Stadium;
 class Player;
@@ -87,8 +89,26 @@ public:
     virtual
     ~VisualSenderCoach();
 
+    /*!
+      \brief invalidate the cached coach views. The global view does not
+      depend on the receiver except for its side, so it is serialized
+      once per side and protocol and shared between the trainer and the
+      online coaches until the world state changes again.
+    */
+    static
+    void newCycle();
+
 protected:
 
+    enum Frame {
+        VISUAL,
+        LOOK,
+    };
+
+    //! get the \p frame for the current world state, calling \p build only for the first coach
+    const std::string & cachedFrame( const Frame frame,
+                                     const std::function< void( std::ostream & ) > & build ) const;
+
     const
     SerializerCoach & serializer() const
       {
@@ -197,21 +217,24 @@ public:
 
 private:
 
-    void sendGoals();
+    void sendGoals( std::ostream & os );
 
-    void sendBall();
+    void sendBall( std::ostream & os );
 
-    void sendGoal( const PObject & goal );
+    void sendGoal( std::ostream & os,
+                   const PObject & goal );
 
 
 
 protected:
 
     virtual
-    void serializePlayer( const Player & player );
+    void serializePlayer( std::ostream & os,
+                          const Player & player );
 
     virtual
-    void serializePlayerLook( const Player & player );
+    void serializePlayerLook( std::ostream & os,
+                              const Player & player );
 
     virtual
     int rad2Deg( const double & rad ) const
@@ -291,10 +314,12 @@ protected:
 
 
     virtual
-    void serializePlayer( const Player & player ) override;
+    void serializePlayer( std::ostream & os,
+                          const Player & player ) override;
 
     virtual
-    void serializePlayerLook( const Player & player ) override;
+    void serializePlayerLook( std::ostream & os,
+                              const Player & player ) override;
 
 };
 
@@ -322,10 +347,12 @@ public:
 protected:
 
     virtual
-    void serializePlayer( const Player & player ) override;
+    void serializePlayer( std::ostream & os,
+                          const Player & player ) override;
 
     virtual
-    void serializePlayerLook( const Player & player ) override;
+    void serializePlayerLook( std::ostream & os,
+                              const Player & player ) override;
 };
 
 }
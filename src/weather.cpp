@@ -25,6 +25,7 @@
 
 #include "weather.h"
 
+#include "checkpoint.h"
 #include "random.h"
 #include "serverparam.h"
 
@@ -83,3 +84,17 @@ Weather::halfTime()
 {
     M_wind_vector *= -1.0;
 }
+
+void
+Weather::saveState( rcss::CheckpointWriter & writer ) const
+{
+    writer.put( M_wind_vector );
+    writer.put( M_wind_rand );
+}
+
+void
+Weather::loadState( rcss::CheckpointReader & reader )
+{
+    reader.get( M_wind_vector );
+    reader.get( M_wind_rand );
+}
@@ -40,6 +40,9 @@ public:
 
     const PVector & windVector() const { return M_wind_vector; }
     const double & windRand() const { return M_wind_rand; }
+
+    void saveState( rcss::CheckpointWriter & writer ) const;
+    void loadState( rcss::CheckpointReader & reader );
 };
 
 #endif
@@ -0,0 +1,272 @@
+// -*-c++-*-
+
+/***************************************************************************
+                                 zygote.cpp
+                  A pool of pre-forked servers
+                             -------------------
+    begin                : 2026-10-18
+    copyright            : (C) 2026 by The RoboCup Soccer Server
+                           Maintenance Group.
+    email                : sserver-admin@lists.sourceforge.net
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU LGPL as published by the Free Software  *
+ *   Foundation; either version 3 of the License, or (at your option) any  *
+ *   later version.                                                        *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "zygote.h"
+
+#include "serverparam.h"
+
+#include <algorithm>
+#include <iostream>
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace rcss {
+
+namespace {
+
+volatile std::sig_atomic_t g_quit = 0;
+
+void
+sig_quit_handle( int )
+{
+    g_quit = 1;
+}
+
+const int SIGNALS[] = { SIGINT, SIGTERM, SIGHUP };
+const size_t SIGNAL_COUNT = sizeof( SIGNALS ) / sizeof( SIGNALS[0] );
+
+//! the handlers of the server, restored in the children that start a match
+struct sigaction g_server_actions[SIGNAL_COUNT];
+
+}
+
+Zygote::Zygote( const size_t pool_size )
+    : M_pool_size( std::max( pool_size, static_cast< size_t >( 1 ) ) )
+{
+
+}
+
+Zygote::~Zygote()
+{
+    for ( const Child & c : M_idle )
+    {
+        ::close( c.fd_ );
+    }
+}
+
+Zygote::Result
+Zygote::run( std::istream & requests )
+{
+    // no SA_RESTART, so that a signal interrupts the read of the requests
+    struct sigaction action;
+    std::memset( &action, 0, sizeof( action ) );
+    action.sa_handler = &sig_quit_handle;
+    for ( size_t i = 0; i < SIGNAL_COUNT; ++i )
+    {
+        if ( sigaction( SIGNALS[i], &action, &g_server_actions[i] ) != 0 )
+        {
+            std::cerr << "Zygote: could not set signal handler: "
+                      << std::strerror( errno ) << std::endl;
+            return FAILED;
+        }
+    }
+
+    Result result = FINISHED;
+    while ( M_idle.size() < M_pool_size )
+    {
+        if ( forkChild( result ) )
+        {
+            return result;
+        }
+    }
+
+    std::cout << "Zygote: " << M_idle.size() << " servers ready" << std::endl;
+
+    std::string line;
+    while ( ! g_quit
+            && std::getline( requests, line ) )
+    {
+        reapChildren( false );
+
+        const std::string::size_type first = line.find_first_not_of( " \t\r" );
+        if ( first == std::string::npos
+             || line[first] == '#' )
+        {
+            continue;
+        }
+
+        if ( M_idle.empty() )
+        {
+            std::cerr << "Zygote: no server ready for " << line << std::endl;
+            continue;
+        }
+
+        const Child child = M_idle.front();
+        M_idle.erase( M_idle.begin() );
+
+        line += '\n';
+        if ( ::write( child.fd_, line.data(), line.size() )
+             != static_cast< ssize_t >( line.size() ) )
+        {
+            std::cerr << "Zygote: could not pass the request to " << child.pid_ << ": "
+                      << std::strerror( errno ) << std::endl;
+        }
+        ::close( child.fd_ );
+
+        line.erase( line.size() - 1 );
+        std::cout << "(zygote (match " << child.pid_ << ") " << line << ')' << std::endl;
+
+        // keep the pool full
+        while ( M_idle.size() < M_pool_size )
+        {
+            if ( forkChild( result ) )
+            {
+                return result;
+            }
+        }
+    }
+
+    // the idle children exit when their pipe is closed
+    for ( const Child & c : M_idle )
+    {
+        ::close( c.fd_ );
+    }
+    M_idle.clear();
+
+    reapChildren( true );
+    return FINISHED;
+}
+
+bool
+Zygote::forkChild( Result & result )
+{
+    int fds[2];
+    if ( ::pipe( fds ) != 0 )
+    {
+        std::cerr << "Zygote: could not create a pipe: "
+                  << std::strerror( errno ) << std::endl;
+        result = FAILED;
+        return true;
+    }
+
+    // the buffered output would be written by both processes otherwise
+    std::cout.flush();
+    std::cerr.flush();
+    std::fflush( nullptr );
+
+    const pid_t pid = ::fork();
+    if ( pid < 0 )
+    {
+        std::cerr << "Zygote: could not fork: "
+                  << std::strerror( errno ) << std::endl;
+        ::close( fds[0] );
+        ::close( fds[1] );
+        result = FAILED;
+        return true;
+    }
+
+    if ( pid == 0 )
+    {
+        // a sibling must see the end of its pipe when the zygote closes it
+        for ( const Child & c : M_idle )
+        {
+            ::close( c.fd_ );
+        }
+        M_idle.clear();
+        ::close( fds[1] );
+
+        result = waitRequest( fds[0] );
+        ::close( fds[0] );
+        return true;
+    }
+
+    ::close( fds[0] );
+    M_idle.push_back( Child{ pid, fds[1] } );
+    return false;
+}
+
+Zygote::Result
+Zygote::waitRequest( const int fd )
+{
+    std::string request;
+    char buf[1024];
+    while ( request.empty()
+            || *request.rbegin() != '\n' )
+    {
+        const ssize_t n = ::read( fd, buf, sizeof( buf ) );
+        if ( n <= 0 )
+        {
+            // the zygote has ended or this child was signaled while idle
+            return FINISHED;
+        }
+        request.append( buf, n );
+    }
+    request.erase( request.size() - 1 );
+
+    for ( size_t i = 0; i < SIGNAL_COUNT; ++i )
+    {
+        sigaction( SIGNALS[i], &g_server_actions[i], nullptr );
+    }
+
+    if ( ! ServerParam::instance().parseLine( request ) )
+    {
+        std::cerr << "Zygote: illegal match parameters: " << request << std::endl;
+        return FAILED;
+    }
+
+    return START_MATCH;
+}
+
+void
+Zygote::reapChildren( const bool block )
+{
+    for ( ; ; )
+    {
+        int status = 0;
+        const pid_t pid = ::waitpid( -1, &status, block ? 0 : WNOHANG );
+        if ( pid < 0
+             && errno == EINTR )
+        {
+            continue;
+        }
+
+        if ( pid <= 0 )
+        {
+            // no child left, or none has exited yet
+            break;
+        }
+
+        for ( std::vector< Child >::iterator it = M_idle.begin(); it != M_idle.end(); ++it )
+        {
+            if ( it->pid_ == pid )
+            {
+                ::close( it->fd_ );
+                M_idle.erase( it );
+                break;
+            }
+        }
+
+        std::cout << "(zygote (exit " << pid << ' '
+                  << ( WIFEXITED( status ) ? WEXITSTATUS( status ) : -1 ) << "))"
+                  << std::endl;
+    }
+}
+
+}
@@ -0,0 +1,95 @@
+// -*-c++-*-
+
+/***************************************************************************
+                                  zygote.h
+                  A pool of pre-forked servers
+                             -------------------
+    begin                : 2026-10-18
+    copyright            : (C) 2026 by The RoboCup Soccer Server
+                           Maintenance Group.
+    email                : sserver-admin@lists.sourceforge.net
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU LGPL as published by the Free Software  *
+ *   Foundation; either version 3 of the License, or (at your option) any  *
+ *   later version.                                                        *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef RCSS_ZYGOTE_H
+#define RCSS_ZYGOTE_H
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include <sys/types.h>
+
+namespace rcss {
+
+/*!
+  \class Zygote
+  \brief keeps a pool of forked servers that are ready to start a match.
+
+  The zygote is forked after the configuration has been parsed and the
+  field has been loaded, so that its children share these tables copy
+  on write.  Every line read from the requests stream starts a match in
+  an idle child and forks a new one in its place.  A line holds the
+  parameters of the match, e.g.
+  <pre>
+  server::port=6100 server::random_seed=7 server::game_log_fixed_name='m7'
+  </pre>
+  which the child applies before the stadium is initialized.  The
+  timing parameters are fixed by the zygote, since slow_down_factor
+  has been applied to them already.
+*/
+class Zygote {
+public:
+    enum Result {
+        FINISHED, //!< in the zygote or an idle child, when the requests ended
+        START_MATCH, //!< in a child whose match parameters have been applied
+        FAILED,
+    };
+
+private:
+    struct Child {
+        pid_t pid_;
+        int fd_; //!< the write end of the request pipe of the child
+    };
+
+    const size_t M_pool_size;
+    std::vector< Child > M_idle;
+
+    // not used
+    Zygote( const Zygote & ) = delete;
+    Zygote & operator=( const Zygote & ) = delete;
+
+public:
+    explicit
+    Zygote( const size_t pool_size );
+
+    ~Zygote();
+
+    /*!
+      \brief serves the requests until the stream ends or the zygote is
+      signaled.  It returns START_MATCH in a child that has received a
+      request, and FINISHED in the zygote after all its children exited.
+    */
+    Result run( std::istream & requests );
+
+private:
+    //! forks an idle child.  It returns true in the child, with its \p result
+    bool forkChild( Result & result );
+
+    //! waits in a child for its request
+    Result waitRequest( const int fd );
+
+    void reapChildren( const bool block );
+};
+
+}
+
+#endif